@@ -0,0 +1,57 @@
+/*
+ * Aead.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/Aead.h"
+#include <mbedtls/mbedtls/gcm.h>
+#include <vector>
+
+#ifndef _fj_AEAD_H
+#define _fj_AEAD_H
+
+namespace fibjs
+{
+
+class Aead : public Aead_base
+{
+public:
+    Aead(const char *name, std::string &key);
+    ~Aead();
+
+public:
+    // Aead_base
+    virtual result_t get_name(std::string &retVal);
+    virtual result_t get_keySize(int32_t &retVal);
+    virtual result_t get_ivSize(int32_t &retVal);
+    virtual result_t get_tagSize(int32_t &retVal);
+    virtual result_t encrypt(Buffer_base *iv, Buffer_base *data, obj_ptr<Buffer_base> &retVal, AsyncEvent *ac);
+    virtual result_t encrypt(Buffer_base *iv, Buffer_base *data, Buffer_base *aad, obj_ptr<Buffer_base> &retVal, AsyncEvent *ac);
+    virtual result_t decrypt(Buffer_base *iv, Buffer_base *data, obj_ptr<Buffer_base> &retVal, AsyncEvent *ac);
+    virtual result_t decrypt(Buffer_base *iv, Buffer_base *data, Buffer_base *aad, obj_ptr<Buffer_base> &retVal, AsyncEvent *ac);
+    virtual result_t encryptTo(Buffer_base *iv, Stream_base *src, Stream_base *stm, AsyncEvent *ac);
+    virtual result_t decryptTo(Buffer_base *iv, Stream_base *src, Stream_base *stm, AsyncEvent *ac);
+
+public:
+    // contexts keep the expanded key, so each one is set up only once and
+    // then handed to one operation at a time
+    mbedtls_gcm_context *get();
+    void put(mbedtls_gcm_context *ctx);
+
+private:
+    result_t process(int32_t mode, Buffer_base *iv, Buffer_base *data,
+                     Buffer_base *aad, obj_ptr<Buffer_base> &retVal,
+                     AsyncEvent *ac);
+
+private:
+    std::string m_name;
+    std::string m_key;
+    exlib::spinlock m_lock;
+    std::vector<mbedtls_gcm_context *> m_ctxs;
+};
+
+}
+
+#endif // _fj_AEAD_H
@@ -84,6 +84,26 @@ public:
 
     virtual result_t toJSON(const char *key, v8::Local<v8::Value> &retVal);
 
+public:
+    const std::string &data() const
+    {
+        return m_data;
+    }
+
+    void detach(std::string &retVal)
+    {
+        extMemory(-(int32_t)m_data.length());
+        retVal.clear();
+        retVal.swap(m_data);
+    }
+
+    void attach(std::string &data)
+    {
+        extMemory((int32_t)data.length() - (int32_t)m_data.length());
+        m_data.swap(data);
+        data.clear();
+    }
+
 private:
     result_t readNumber(int32_t offset, char *buf, int32_t size, bool noAssert, bool le);
     result_t writeNumber(int32_t offset, const char *buf, int32_t size, bool noAssert, bool le);
@@ -0,0 +1,69 @@
+/*
+ * Channel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#ifndef CHANNEL_H_
+#define CHANNEL_H_
+
+#include "ifs/Channel.h"
+#include <deque>
+#include <string>
+
+namespace fibjs
+{
+
+class Channel: public Channel_base
+{
+public:
+    Channel(int32_t size) :
+        m_size(size), m_closed(false), m_semPut(size), m_semTake(0)
+    {
+    }
+
+    FIBER_FREE();
+
+public:
+    // Channel_base
+    virtual result_t put(v8::Local<v8::Value> v);
+    virtual result_t take(v8::Local<v8::Value> &retVal);
+    virtual result_t tryPut(v8::Local<v8::Value> v, bool &retVal);
+    virtual result_t close();
+    virtual result_t get_length(int32_t &retVal);
+    virtual result_t get_closed(bool &retVal);
+
+private:
+    class message
+    {
+    public:
+        message() : m_buffer(false)
+        {
+        }
+
+    public:
+        bool m_buffer;
+        std::string m_data;
+    };
+
+    result_t pack(v8::Local<v8::Value> v, message &m);
+    void unpack(message &m, v8::Local<v8::Value> &retVal);
+
+    bool push(message &m);
+    bool pop(message &m);
+
+    static void wait(exlib::Semaphore &sem);
+
+private:
+    exlib::spinlock m_lock;
+    std::deque<message> m_list;
+    int32_t m_size;
+    bool m_closed;
+    exlib::Semaphore m_semPut;
+    exlib::Semaphore m_semTake;
+};
+
+} /* namespace fibjs */
+
+#endif /* CHANNEL_H_ */
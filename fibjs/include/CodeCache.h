@@ -0,0 +1,41 @@
+/*
+ * CodeCache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "Stats.h"
+#include <string>
+
+#ifndef CODECACHE_H_
+#define CODECACHE_H_
+
+namespace fibjs
+{
+
+class CodeCache
+{
+public:
+    static bool enabled()
+    {
+        return !s_dir.empty();
+    }
+
+    // loads the cached code of script fname compiled from src. the entry is
+    // only accepted when the file mtime, src and V8 version are unchanged.
+    static bool load(const char *fname, const std::string &src, std::string &data);
+    static void save(const char *fname, const std::string &src,
+                     const uint8_t *data, int32_t length);
+
+    // called when V8 rejects the data returned by load.
+    static void reject(const char *fname);
+
+    static Stats *stats();
+
+public:
+    static std::string s_dir;
+};
+
+} /* namespace fibjs */
+#endif /* CODECACHE_H_ */
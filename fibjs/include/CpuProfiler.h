@@ -0,0 +1,101 @@
+/*
+ * CpuProfiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/Stream.h"
+#include "Fiber.h"
+#include <v8/include/v8-profiler.h>
+#include <vector>
+#include <map>
+
+#ifndef _fj_CPUPROFILER_H
+#define _fj_CPUPROFILER_H
+
+namespace fibjs
+{
+
+class CpuProfiler
+{
+public:
+	CpuProfiler(int32_t interval);
+
+public:
+	static result_t start(int32_t interval);
+	static result_t stop(const char* fname, Stream_base* stm, const char* format);
+
+	static void enter(JSFiber* fb)
+	{
+		CpuProfiler* p = Isolate::now()->m_profiler;
+		if (p)
+			p->_enter(fb);
+	}
+
+	static void leave(JSFiber* fb, bool bEnd = false)
+	{
+		CpuProfiler* p = Isolate::now()->m_profiler;
+		if (p)
+			p->_leave(fb, bEnd);
+	}
+
+private:
+	void _enter(JSFiber* fb);
+	void _leave(JSFiber* fb, bool bEnd);
+
+	void push(int32_t fid);
+	void compact();
+	int32_t fiber(int64_t t);
+	int32_t node(int32_t fid, const v8::CpuProfileNode* frame);
+	void load(const v8::CpuProfile* profile);
+
+	void cpuprofile(std::string& retVal);
+	void collapsed(std::string& retVal);
+
+private:
+	class _switch
+	{
+	public:
+		_switch(int64_t time, int32_t fid) :
+			m_time(time), m_fid(fid)
+		{
+		}
+
+	public:
+		int64_t m_time;
+		int32_t m_fid;
+	};
+
+	class _node
+	{
+	public:
+		_node(int32_t fid, const v8::CpuProfileNode* frame) :
+			m_fid(fid), m_frame(frame), m_hit(0)
+		{
+		}
+
+	public:
+		int32_t m_fid;
+		const v8::CpuProfileNode* m_frame;
+		int32_t m_hit;
+		std::vector<int32_t> m_childs;
+	};
+
+private:
+	int64_t m_start;
+	int64_t m_interval;
+	std::vector<_switch> m_switches;
+	std::map<JSFiber*, int32_t> m_ids;
+	std::vector<std::string> m_labels;
+
+	int64_t m_startTime, m_endTime;
+	std::map<const v8::CpuProfileNode*, const v8::CpuProfileNode*> m_parents;
+	std::map<std::pair<int32_t, const v8::CpuProfileNode*>, int32_t> m_index;
+	std::vector<_node> m_nodes;
+	std::vector<int32_t> m_samples;
+	std::vector<int64_t> m_times;
+};
+
+} /* namespace fibjs */
+#endif /* _fj_CPUPROFILER_H */
@@ -0,0 +1,141 @@
+/*
+ * DbPool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/DbPool.h"
+#include "Stats.h"
+#include <list>
+#include <map>
+
+#ifndef DBPOOL_H_
+#define DBPOOL_H_
+
+namespace fibjs
+{
+
+class DbPool: public DbPool_base,
+    public exlib::Task_base
+{
+    FIBER_FREE();
+
+public:
+    DbPool(const char *connString);
+    ~DbPool();
+
+public:
+    // object_base
+    virtual bool isJSObject()
+    {
+        return true;
+    }
+
+public:
+    // DbPool_base
+    virtual result_t acquire(obj_ptr<object_base> &retVal);
+    virtual result_t release(object_base *conn, bool healthy);
+    virtual result_t execute(v8::Local<v8::Function> func, v8::Local<v8::Value> &retVal);
+    virtual result_t close();
+    virtual result_t get_size(int32_t &retVal);
+    virtual result_t get_idle(int32_t &retVal);
+    virtual result_t get_stats(obj_ptr<Stats_base> &retVal);
+
+public:
+    // exlib::Task_base
+    virtual void suspend()
+    {
+    }
+
+    virtual void resume()
+    {
+        syncCall(_check, this);
+    }
+
+public:
+    result_t setOptions(v8::Local<v8::Object> opts);
+    void start();
+
+private:
+    class _item
+    {
+    public:
+        _item(object_base *conn) : m_conn(conn)
+        {
+            m_time.now();
+        }
+
+    public:
+        obj_ptr<object_base> m_conn;
+        date_t m_time;
+    };
+
+    class _waiter: public obj_base,
+        public exlib::Task_base
+    {
+    public:
+        _waiter() : m_done(false), m_timeout(false)
+        {
+        }
+
+    public:
+        // exlib::Task_base
+        virtual void suspend()
+        {
+        }
+
+        virtual void resume()
+        {
+            syncCall(_timeout, this);
+        }
+
+    private:
+        static void _timeout(_waiter *pThis)
+        {
+            if (!pThis->m_done)
+            {
+                pThis->m_done = true;
+                pThis->m_timeout = true;
+                pThis->m_event.set();
+            }
+
+            pThis->Unref();
+        }
+
+    public:
+        exlib::Event m_event;
+        obj_ptr<object_base> m_conn;
+        bool m_done;
+        bool m_timeout;
+    };
+
+    result_t connect(obj_ptr<object_base> &retVal);
+    void drop(object_base *conn);
+    bool wakeup(object_base *conn);
+    void check();
+
+    static void _check(DbPool *pThis)
+    {
+        pThis->check();
+    }
+
+private:
+    std::string m_connString;
+    int32_t m_min, m_max;
+    int32_t m_idleTimeout, m_maxWait;
+    int32_t m_checkInterval;
+
+    int32_t m_count;
+    bool m_closed;
+    bool m_checking;
+
+    std::list<_item> m_idles;
+    std::list<obj_ptr<_waiter> > m_waiters;
+    std::map<object_base *, _item> m_leases;
+
+    obj_ptr<Stats> m_stats;
+};
+
+} /* namespace fibjs */
+#endif /* DBPOOL_H_ */
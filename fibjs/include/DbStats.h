@@ -0,0 +1,39 @@
+/*
+ * DbStats.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "Stats.h"
+
+#ifndef DBSTATS_H_
+#define DBSTATS_H_
+
+namespace fibjs
+{
+
+enum
+{
+    DB_SQL = 0,
+    DB_REDIS,
+    DB_ERROR
+};
+
+Stats *db_stats();
+
+inline void db_record(int32_t type, result_t hr, date_t &d1)
+{
+    Stats *stats = db_stats();
+    date_t d2;
+
+    d2.now();
+
+    stats->inc(type);
+    if (hr < 0)
+        stats->inc(DB_ERROR);
+    stats->record(type, (int64_t)(d2.diff(d1) * 1000));
+}
+
+} /* namespace fibjs */
+#endif /* DBSTATS_H_ */
@@ -21,6 +21,13 @@ public:
     Digest(mbedtls_md_type_t algo, const char *key, int32_t sz);
     ~Digest();
 
+public:
+    // Stream_base
+    virtual result_t read(int32_t bytes, obj_ptr<Buffer_base> &retVal, AsyncEvent *ac);
+    virtual result_t write(Buffer_base *data, AsyncEvent *ac);
+    virtual result_t close(AsyncEvent *ac);
+    virtual result_t copyTo(Stream_base *stm, int64_t bytes, int64_t &retVal, AsyncEvent *ac);
+
 public:
     // Digest_base
     virtual result_t update(Buffer_base *data);
@@ -0,0 +1,36 @@
+/*
+ * DnsCache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "Stats.h"
+#include <string>
+
+#ifndef DNSCACHE_H_
+#define DNSCACHE_H_
+
+namespace fibjs
+{
+
+class DnsCache
+{
+public:
+    // returns the cached answer of name, positive or negative. on a miss
+    // CALL_E_NOSYNC is returned when ac is NULL, otherwise the name is
+    // resolved. a lookup already running for the same name is shared,
+    // CALL_E_PENDDING is returned and ac is resumed with its answer.
+    static result_t resolve(const char *name, int32_t family,
+                            std::string &retVal, AsyncEvent *ac);
+
+    static void clear();
+    static Stats *stats();
+
+public:
+    static int32_t s_ttl;
+    static int32_t s_negativeTtl;
+};
+
+} /* namespace fibjs */
+#endif /* DNSCACHE_H_ */
@@ -46,6 +46,7 @@ public:
 
 public:
     result_t open(const char *fname, const char *flags);
+    result_t tmpFile();
     result_t close();
     result_t Write(const char *p, int32_t sz);
 
@@ -0,0 +1,64 @@
+/*
+ * HeapNodeIndex.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+#ifndef _fj_HEAPNODEINDEX_H
+#define _fj_HEAPNODEINDEX_H
+
+namespace fibjs
+{
+
+class HeapNodeIndex
+{
+public:
+    void reserve(int32_t n)
+    {
+        m_index.reserve(n);
+    }
+
+    void add(int32_t id, int32_t pos)
+    {
+        m_index.push_back(std::pair<int32_t, int32_t>(id, pos));
+    }
+
+    void sort()
+    {
+        std::sort(m_index.begin(), m_index.end());
+    }
+
+    int32_t find(int32_t id) const
+    {
+        std::vector<std::pair<int32_t, int32_t> >::const_iterator it;
+
+        it = std::lower_bound(m_index.begin(), m_index.end(), id, less_id);
+        if (it == m_index.end() || it->first != id)
+            return -1;
+
+        return it->second;
+    }
+
+    bool empty() const
+    {
+        return m_index.empty();
+    }
+
+private:
+    static bool less_id(const std::pair<int32_t, int32_t> &a, int32_t id)
+    {
+        return a.first < id;
+    }
+
+private:
+    std::vector<std::pair<int32_t, int32_t> > m_index;
+};
+
+}
+
+#endif // _fj_HEAPNODEINDEX_H
@@ -8,8 +8,8 @@
 #include "ifs/HeapSnapshot.h"
 #include "ifs/HeapGraphEdge.h"
 #include "List.h"
+#include "HeapNodeIndex.h"
 #include <v8/include/v8-profiler.h>
-#include <map>
 
 #ifndef _fj_HEAPPROXY_H
 #define _fj_HEAPPROXY_H
@@ -53,7 +53,7 @@ private:
 private:
     const v8::HeapSnapshot* m_snapshot;
     date_t m_d;
-    std::map<int32_t, int32_t> _nodes;
+    HeapNodeIndex _nodes;
     obj_ptr<List> m_nodes;
 };
 
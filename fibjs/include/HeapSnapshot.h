@@ -8,7 +8,7 @@
 #include "ifs/HeapSnapshot.h"
 #include <v8/include/v8-profiler.h>
 #include "List.h"
-#include <map>
+#include "HeapNodeIndex.h"
 
 #ifndef _fj_HEAPSNAPSHOT_H
 #define _fj_HEAPSNAPSHOT_H
@@ -35,7 +35,7 @@ public:
 private:
     date_t m_time;
     obj_ptr<List> m_nodes;
-    std::map<int32_t, int32_t> _nodes;
+    HeapNodeIndex _nodes;
 };
 
 }
@@ -0,0 +1,40 @@
+/*
+ * HttpAgent.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/Stream.h"
+#include "Stats.h"
+#include <string>
+
+#ifndef HTTPAGENT_H_
+#define HTTPAGENT_H_
+
+namespace fibjs
+{
+
+class HttpAgent
+{
+public:
+    // conn is set to a pooled connection, or left empty when the caller
+    // owns a new slot and must connect. returns CALL_E_PENDDING when all
+    // slots of the host are busy, ac is resumed once one is released.
+    static result_t acquire(const std::string &key, obj_ptr<Stream_base> &conn,
+                            int32_t &uses, AsyncEvent *ac);
+
+    // gives the slot back, returns true if conn was kept for reuse.
+    // conn may be NULL when the connection is lost or handed to the user.
+    static bool release(const std::string &key, Stream_base *conn, int32_t uses);
+
+    static Stats *stats();
+
+public:
+    static int32_t s_maxSockets;
+    static int32_t s_keepAliveTimeout;
+    static int32_t s_maxRequests;
+};
+
+} /* namespace fibjs */
+#endif /* HTTPAGENT_H_ */
@@ -0,0 +1,102 @@
+/*
+ * HttpCacheHandler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/HttpCacheHandler.h"
+#include "ifs/HttpRequest.h"
+#include "ifs/Buffer.h"
+#include "Stats.h"
+#include <map>
+#include <list>
+#include <vector>
+
+#ifndef HTTPCACHEHANDLER_H_
+#define HTTPCACHEHANDLER_H_
+
+namespace fibjs
+{
+
+class HttpCacheHandler: public HttpCacheHandler_base
+{
+    FIBER_FREE();
+
+public:
+    class Entry
+    {
+    public:
+        Entry() :
+            m_status(200), m_ttl(0), m_size(0), m_prev(NULL), m_next(NULL)
+        {
+        }
+
+    public:
+        std::string m_key;
+        int32_t m_status;
+        std::vector<std::string> m_names;
+        std::vector<std::string> m_values;
+        obj_ptr<Buffer_base> m_body;
+        obj_ptr<Buffer_base> m_gzip;
+        std::string m_etag;
+        date_t m_time;
+        int32_t m_ttl;
+        size_t m_size;
+        Entry *m_prev;
+        Entry *m_next;
+    };
+
+public:
+    HttpCacheHandler();
+    ~HttpCacheHandler();
+
+public:
+    // object_base
+    virtual result_t dispose()
+    {
+        return 0;
+    }
+
+public:
+    // Handler_base
+    virtual result_t invoke(object_base *v, obj_ptr<Handler_base> &retVal,
+                            AsyncEvent *ac);
+
+public:
+    // HttpCacheHandler_base
+    virtual result_t get_handler(obj_ptr<Handler_base> &retVal);
+    virtual result_t clear();
+    virtual result_t get_stats(obj_ptr<Stats_base> &retVal);
+
+public:
+    result_t init(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts);
+
+private:
+    class asyncInvoke;
+
+    void key(HttpRequest_base *req, std::string &retVal);
+    bool keyed(const std::string &vary);
+    void store(Entry *e);
+    void finish(const std::string &key);
+    void link(Entry *e);
+    void unlink(Entry *e);
+    void remove(Entry *e);
+
+private:
+    naked_ptr<Handler_base> m_hdlr;
+    obj_ptr<Stats> m_stats;
+    int32_t m_ttl;
+    size_t m_maxSize;
+    std::vector<std::string> m_vary;
+
+    exlib::spinlock m_lock;
+    std::map<std::string, Entry *> m_entries;
+    std::map<std::string, std::list<asyncInvoke *> > m_flights;
+    Entry *m_head;
+    Entry *m_tail;
+    size_t m_size;
+};
+
+} /* namespace fibjs */
+#endif /* HTTPCACHEHANDLER_H_ */
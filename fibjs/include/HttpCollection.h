@@ -56,6 +56,21 @@ public:
     size_t size();
     size_t getData(char *buf, size_t sz);
 
+    int32_t count()
+    {
+        return m_count;
+    }
+
+    const std::string &name(int32_t i)
+    {
+        return m_names[i];
+    }
+
+    const std::string &value(int32_t i)
+    {
+        return m_values[i];
+    }
+
 private:
     QuickArray<std::string> m_names;
     QuickArray<std::string> m_values;
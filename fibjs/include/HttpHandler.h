@@ -43,6 +43,14 @@ public:
     virtual result_t set_maxHeadersCount(int32_t newVal);
     virtual result_t get_maxUploadSize(int32_t &retVal);
     virtual result_t set_maxUploadSize(int32_t newVal);
+    virtual result_t get_maxPartSize(int32_t &retVal);
+    virtual result_t set_maxPartSize(int32_t newVal);
+    virtual result_t get_streamUpload(bool &retVal);
+    virtual result_t set_streamUpload(bool newVal);
+    virtual result_t get_timeout(int32_t &retVal);
+    virtual result_t set_timeout(int32_t newVal);
+    virtual result_t get_idleTimeout(int32_t &retVal);
+    virtual result_t set_idleTimeout(int32_t newVal);
     virtual result_t get_handler(obj_ptr<Handler_base> &retVal);
     virtual result_t set_handler(Handler_base *newVal);
     virtual result_t get_stats(obj_ptr<Stats_base> &retVal);
@@ -56,6 +64,10 @@ private:
     bool m_forceGZIP;
     int32_t m_maxHeadersCount;
     int32_t m_maxUploadSize;
+    int32_t m_maxPartSize;
+    bool m_streamUpload;
+    int32_t m_timeout;
+    int32_t m_idleTimeout;
 };
 
 } /* namespace fibjs */
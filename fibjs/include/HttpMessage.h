@@ -7,6 +7,7 @@
 
 #include "Message.h"
 #include "HttpCollection.h"
+#include "HttpUploadCollection.h"
 #include "ifs/BufferedStream.h"
 
 #ifndef HTTPMESSAGE_H_
@@ -21,7 +22,8 @@ class HttpMessage: public Message::_msg
 {
 public:
     HttpMessage(bool bResponse = false) :
-        m_bResponse(bResponse), m_maxHeadersCount(128), m_maxUploadSize(67108864)
+        m_bResponse(bResponse), m_maxHeadersCount(128), m_maxUploadSize(67108864),
+        m_maxPartSize(67108864), m_streamUpload(false)
     {
         m_headers = new HttpCollection();
         clear();
@@ -39,6 +41,10 @@ public:
     result_t set_maxHeadersCount(int32_t newVal);
     result_t get_maxUploadSize(int32_t &retVal);
     result_t set_maxUploadSize(int32_t newVal);
+    result_t get_maxPartSize(int32_t &retVal);
+    result_t set_maxPartSize(int32_t newVal);
+    result_t get_streamUpload(bool &retVal);
+    result_t set_streamUpload(bool newVal);
     result_t hasHeader(const char *name, bool &retVal);
     result_t firstHeader(const char *name, Variant &retVal);
     result_t allHeader(const char *name, obj_ptr<List_base> &retVal);
@@ -73,9 +79,12 @@ public:
     bool m_upgrade;
     int32_t m_maxHeadersCount;
     int32_t m_maxUploadSize;
+    int32_t m_maxPartSize;
+    bool m_streamUpload;
     std::string m_origin;
     std::string m_encoding;
     obj_ptr<HttpCollection> m_headers;
+    obj_ptr<HttpUploadCollection> m_upload;
 };
 
 } /* namespace fibjs */
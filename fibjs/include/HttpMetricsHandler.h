@@ -0,0 +1,36 @@
+/*
+ * HttpMetricsHandler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/Handler.h"
+
+#ifndef HTTPMETRICSHANDLER_H_
+#define HTTPMETRICSHANDLER_H_
+
+namespace fibjs
+{
+
+class HttpMetricsHandler: public Handler_base
+{
+    FIBER_FREE();
+
+public:
+    HttpMetricsHandler() :
+        m_size(4096)
+    {
+    }
+
+public:
+    // Handler_base
+    virtual result_t invoke(object_base *v, obj_ptr<Handler_base> &retVal,
+                            AsyncEvent *ac);
+
+private:
+    size_t m_size;
+};
+
+} /* namespace fibjs */
+#endif /* HTTPMETRICSHANDLER_H_ */
@@ -58,6 +58,10 @@ public:
     virtual result_t set_maxHeadersCount(int32_t newVal);
     virtual result_t get_maxUploadSize(int32_t &retVal);
     virtual result_t set_maxUploadSize(int32_t newVal);
+    virtual result_t get_maxPartSize(int32_t &retVal);
+    virtual result_t set_maxPartSize(int32_t newVal);
+    virtual result_t get_streamUpload(bool &retVal);
+    virtual result_t set_streamUpload(bool newVal);
     virtual result_t hasHeader(const char *name, bool &retVal);
     virtual result_t firstHeader(const char *name, Variant &retVal);
     virtual result_t allHeader(const char *name, obj_ptr<List_base> &retVal);
@@ -6,7 +6,9 @@
  */
 
 #include "ifs/HttpCollection.h"
+#include "ifs/Stream.h"
 #include "QuickArray.h"
+#include "File.h"
 
 #ifndef HTTPUPLOADCOLLECTION_H_
 #define HTTPUPLOADCOLLECTION_H_
@@ -16,6 +18,49 @@ namespace fibjs
 
 class HttpUploadCollection: public HttpCollection_base
 {
+public:
+    class UploadStream: public Stream_base
+    {
+    public:
+        UploadStream(HttpUploadCollection *col, int32_t maxPartSize) :
+            m_col(col), m_maxPartSize(maxPartSize), m_state(0), m_size(0)
+        {
+        }
+
+    public:
+        // Stream_base
+        virtual result_t read(int32_t bytes, obj_ptr<Buffer_base> &retVal, AsyncEvent *ac);
+        virtual result_t write(Buffer_base *data, AsyncEvent *ac);
+        virtual result_t close(AsyncEvent *ac);
+        virtual result_t copyTo(Stream_base *stm, int64_t bytes, int64_t &retVal, AsyncEvent *ac);
+
+    public:
+        bool init(const char *boundary);
+        result_t feed(const char *data, int32_t sz);
+        result_t end();
+
+    private:
+        result_t parse();
+        bool header(const char *p, const char *p1);
+        result_t append(const char *p, int32_t sz);
+        result_t endPart();
+
+    private:
+        obj_ptr<HttpUploadCollection> m_col;
+        int32_t m_maxPartSize;
+        std::string m_boundary;
+        std::string m_buf;
+        int32_t m_state;
+
+        std::string m_name;
+        std::string m_fileName;
+        std::string m_contentType;
+        std::string m_contentTransferEncoding;
+        std::string m_value;
+        obj_ptr<File> m_file;
+        int64_t m_size;
+    };
+
 public:
     HttpUploadCollection() :
         m_count(0)
@@ -34,6 +34,7 @@ public:
     virtual result_t get_socket(obj_ptr<Socket_base> &retVal);
     virtual result_t get_handler(obj_ptr<Handler_base> &retVal);
     virtual result_t set_handler(Handler_base *newVal);
+    virtual result_t limit(v8::Local<v8::Object> opts, obj_ptr<LimitHandler_base> &retVal);
     virtual result_t get_stats(obj_ptr<Stats_base> &retVal);
 
 public:
@@ -46,6 +47,10 @@ public:
     virtual result_t set_maxHeadersCount(int32_t newVal);
     virtual result_t get_maxUploadSize(int32_t &retVal);
     virtual result_t set_maxUploadSize(int32_t newVal);
+    virtual result_t get_maxPartSize(int32_t &retVal);
+    virtual result_t set_maxPartSize(int32_t newVal);
+    virtual result_t get_streamUpload(bool &retVal);
+    virtual result_t set_streamUpload(bool newVal);
     virtual result_t get_httpStats(obj_ptr<Stats_base> &retVal);
 
 public:
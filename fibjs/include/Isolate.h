@@ -16,6 +16,7 @@ namespace fibjs
 
 class SandBox;
 class JSFiber;
+class CpuProfiler;
 class Isolate : public exlib::linkitem
 {
 public:
@@ -48,6 +49,7 @@ public:
 	obj_ptr<SandBox> m_topSandbox;
 	exlib::List<exlib::linkitem> m_fibers;
 	bool m_test_setup_bbd, m_test_setup_tdd;
+	CpuProfiler *m_profiler;
 };
 
 } /* namespace fibjs */
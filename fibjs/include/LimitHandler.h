@@ -0,0 +1,104 @@
+/*
+ * LimitHandler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/LimitHandler.h"
+#include "ifs/TcpServer.h"
+#include "Stats.h"
+#include "TimerWheel.h"
+#include <map>
+#include <list>
+
+#ifndef LIMITHANDLER_H_
+#define LIMITHANDLER_H_
+
+namespace fibjs
+{
+
+class LimitHandler: public LimitHandler_base
+{
+    FIBER_FREE();
+
+public:
+    LimitHandler();
+
+public:
+    // object_base
+    virtual result_t dispose()
+    {
+        return 0;
+    }
+
+public:
+    // Handler_base
+    virtual result_t invoke(object_base *v, obj_ptr<Handler_base> &retVal,
+                            AsyncEvent *ac);
+
+public:
+    // LimitHandler_base
+    virtual result_t get_handler(obj_ptr<Handler_base> &retVal);
+    virtual result_t get_stats(obj_ptr<Stats_base> &retVal);
+
+public:
+    result_t init(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts);
+
+    static result_t limit(TcpServer_base *svr, v8::Local<v8::Object> opts,
+                          obj_ptr<LimitHandler_base> &retVal);
+
+private:
+    class asyncInvoke;
+
+    class Bucket
+    {
+    public:
+        double m_tokens;
+        date_t m_time;
+        std::list<std::string>::iterator m_lru;
+    };
+
+    class Waiter: public TimerWheel::Entry
+    {
+    public:
+        Waiter(LimitHandler *pThis, AsyncState *pState) :
+            m_pThis(pThis), m_state(pState), m_timed(false), m_done(false)
+        {
+        }
+
+    public:
+        // TimerWheel::Entry
+        virtual void timeout();
+
+    public:
+        obj_ptr<LimitHandler> m_pThis;
+        AsyncState *m_state;
+        std::list<Waiter *>::iterator m_it;
+        bool m_timed;
+        bool m_done;
+    };
+
+    void key(object_base *v, std::string &retVal);
+    bool acquire(const std::string &key);
+    void release();
+
+private:
+    naked_ptr<Handler_base> m_hdlr;
+    obj_ptr<Stats> m_stats;
+    double m_rate;
+    double m_burst;
+    std::string m_keyHeader;
+    int32_t m_concurrency;
+    int32_t m_queueSize;
+    int32_t m_queueTimeout;
+
+    exlib::spinlock m_lock;
+    std::map<std::string, Bucket> m_buckets;
+    std::list<std::string> m_lru;
+    std::list<Waiter *> m_queue;
+    int32_t m_active;
+};
+
+} /* namespace fibjs */
+#endif /* LIMITHANDLER_H_ */
@@ -0,0 +1,35 @@
+/*
+ * Metrics.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include <string>
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+namespace fibjs
+{
+
+class Stats;
+
+class Metrics
+{
+public:
+    static int32_t add(Stats *stats);
+    static void remove(int32_t id);
+
+    static void lock();
+    static void unlock();
+
+    static void render(std::string &retVal, bool bOpenMetrics);
+
+public:
+    static void label(std::string &retVal, const char *name, const std::string &value);
+    static void value(std::string &retVal, int64_t v);
+};
+
+} /* namespace fibjs */
+#endif /* METRICS_H_ */
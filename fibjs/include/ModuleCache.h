@@ -0,0 +1,39 @@
+/*
+ * ModuleCache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "Stats.h"
+#include <string>
+
+#ifndef MODULECACHE_H_
+#define MODULECACHE_H_
+
+namespace fibjs
+{
+
+class ModuleCache
+{
+public:
+    // reads a module file, files found missing within the last second fail
+    // without a fs probe.
+    static result_t readFile(const std::string &fname, std::string &retVal);
+
+    // the file an id searched from dir was last resolved to, or the error
+    // of a failed search made within the last second.
+    static bool lookup(const std::string &dir, const std::string &id,
+                       std::string &fname, result_t &hr);
+    static void save(const std::string &dir, const std::string &id,
+                     const std::string &fname, result_t hr);
+
+    static void clear();
+    static Stats *stats();
+
+public:
+    static bool s_enabled;
+};
+
+} /* namespace fibjs */
+#endif /* MODULECACHE_H_ */
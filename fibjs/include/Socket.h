@@ -8,6 +8,7 @@
 #include "ifs/Socket.h"
 #include "Stream.h"
 #include "inetAddr.h"
+#include "TimerWheel.h"
 
 #ifndef SOCKET_H_
 #define SOCKET_H_
@@ -18,6 +19,12 @@ namespace fibjs
 #define KEEPALIVE_TIMEOUT   120
 #define SOCKET_BUFF_SIZE    2048
 
+#ifdef _WIN32
+#define SOCKET_E_TIMEOUT    (-WSAETIMEDOUT)
+#else
+#define SOCKET_E_TIMEOUT    (-ETIMEDOUT)
+#endif
+
 class Socket: public Socket_base
 {
     FIBER_FREE();
@@ -26,9 +33,11 @@ public:
     Socket() :
         m_sock(INVALID_SOCKET),
         m_family(net_base::_AF_INET), m_type(net_base::_SOCK_STREAM),
-        m_inRecv(0), m_inSend(0)
+        m_inRecv(0), m_inSend(0), m_timeout(0), m_recvSeq(0), m_timerGen(0),
+        m_timer(NULL),
+        m_deadline(false), m_timedOut(false)
 #ifdef _WIN32
-        , m_bBind(FALSE)
+        , m_bBind(FALSE), m_RecvOpt(NULL), m_expired(false)
 #else
         , m_RecvOpt(NULL), m_SendOpt(NULL)
 #endif
@@ -37,9 +46,11 @@ public:
 
     Socket(SOCKET s, int32_t family, int32_t type) :
         m_sock(s), m_family(family), m_type(type),
-        m_inRecv(0), m_inSend(0)
+        m_inRecv(0), m_inSend(0), m_timeout(0), m_recvSeq(0), m_timerGen(0),
+        m_timer(NULL),
+        m_deadline(false), m_timedOut(false)
 #ifdef _WIN32
-        , m_bBind(FALSE)
+        , m_bBind(FALSE), m_RecvOpt(NULL), m_expired(false)
 #else
         , m_RecvOpt(NULL), m_SendOpt(NULL)
 #endif
@@ -65,6 +76,8 @@ public:
     virtual result_t get_remotePort(int32_t &retVal);
     virtual result_t get_localAddress(std::string &retVal);
     virtual result_t get_localPort(int32_t &retVal);
+    virtual result_t get_timeout(int32_t &retVal);
+    virtual result_t set_timeout(int32_t newVal);
     virtual result_t connect(const char *host, int32_t port,
                              AsyncEvent *ac);
     virtual result_t bind(const char *addr, int32_t port, bool allowIPv4);
@@ -83,6 +96,17 @@ public:
     result_t create(int32_t family, int32_t type);
     result_t recv(int32_t bytes, obj_ptr<Buffer_base> &retVal,
                   AsyncEvent *ac, bool bRead);
+    void set_deadline(int32_t ms);
+
+private:
+    result_t resolve_connect(const char *host, int32_t port, AsyncEvent *ac);
+    class _timer;
+
+    void start_timer();
+    void stop_timer();
+    void arm_timer(int32_t ms);
+    void timeout(_timer *t);
+    void cancel_recv(intptr_t seq);
 
 private:
     SOCKET m_sock;
@@ -92,8 +116,17 @@ private:
     intptr_t m_inRecv;
     intptr_t m_inSend;
 
+    int32_t m_timeout;
+    intptr_t m_recvSeq;
+    intptr_t m_timerGen;
+    _timer *m_timer;
+    bool m_deadline;
+    bool m_timedOut;
+
 #ifdef _WIN32
     BOOL m_bBind;
+    void *m_RecvOpt;
+    bool m_expired;
 #else
     void *m_RecvOpt;
     void *m_SendOpt;
@@ -11,6 +11,7 @@
 #include "Cipher.h"
 #include "ssl.h"
 #include <mbedtls/mbedtls/net.h>
+#include <mbedtls/mbedtls/ssl_ticket.h>
 
 #ifndef SSLSOCKET_H_
 #define SSLSOCKET_H_
@@ -21,6 +22,50 @@ namespace fibjs
 class SslSocket: public SslSocket_base
 {
 private:
+    class _server_conf: public obj_base
+    {
+    public:
+        _server_conf()
+        {
+            mbedtls_ssl_config_init(&m_conf);
+#ifdef MBEDTLS_SSL_TICKET_C
+            mbedtls_ssl_ticket_init(&m_ticket);
+#endif
+        }
+
+        ~_server_conf()
+        {
+#ifdef MBEDTLS_SSL_TICKET_C
+            mbedtls_ssl_ticket_free(&m_ticket);
+#endif
+            mbedtls_ssl_config_free(&m_conf);
+        }
+
+    public:
+        result_t init(SslSocket *pThis);
+
+    private:
+#ifdef MBEDTLS_SSL_TICKET_C
+        static int32_t ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+                                    unsigned char *start, const unsigned char *end,
+                                    size_t *tlen, uint32_t *lifetime);
+        static int32_t ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+                                    unsigned char *buf, size_t len);
+#endif
+
+    public:
+        mbedtls_ssl_config m_conf;
+
+    private:
+        obj_ptr<X509Cert> m_ca;
+        std::vector<obj_ptr<X509Cert_base> > m_crts;
+        std::vector<obj_ptr<PKey_base> > m_keys;
+#ifdef MBEDTLS_SSL_TICKET_C
+        mbedtls_ssl_ticket_context m_ticket;
+        exlib::spinlock m_ticket_lock;
+#endif
+    };
+
     class asyncSsl: public AsyncState
     {
     public:
@@ -168,6 +213,7 @@ public:
     virtual result_t set_verification(int32_t newVal);
     virtual result_t get_ca(obj_ptr<X509Cert_base> &retVal);
     virtual result_t get_peerCert(obj_ptr<X509Cert_base> &retVal);
+    virtual result_t get_resumed(bool &retVal);
     virtual result_t connect(Stream_base *s, const char *server_name, int32_t &retVal, AsyncEvent *ac);
     virtual result_t accept(Stream_base *s, obj_ptr<SslSocket_base> &retVal, AsyncEvent *ac);
 
@@ -179,21 +225,33 @@ private:
     static int32_t my_send(void *ctx, const unsigned char *buf, size_t len);
 
     result_t handshake(int32_t *retVal, AsyncEvent *ac);
+    result_t server_conf(obj_ptr<_server_conf> &retVal);
 
 public:
     result_t setCert(X509Cert_base *crt, PKey_base *key);
 
+    Stream_base *stream()
+    {
+        return m_s;
+    }
+
 public:
     mbedtls_ssl_context m_ssl;
     mbedtls_ssl_config m_ssl_conf;
+    std::string m_session_key;
 
 private:
+    obj_ptr<_server_conf> m_server_conf;
+    // config shared with the listener, m_ssl points into it until freed
+    obj_ptr<_server_conf> m_accept_conf;
+    exlib::spinlock m_conf_lock;
     obj_ptr<X509Cert> m_ca;
     std::vector<obj_ptr<X509Cert_base> > m_crts;
     std::vector<obj_ptr<PKey_base> > m_keys;
     obj_ptr<Stream_base> m_s;
     std::string m_recv;
     int32_t m_recv_pos;
+    bool m_resumed;
     std::string m_send;
 };
 
@@ -9,17 +9,76 @@
 #define STATS_H_
 
 #include "ifs/Stats.h"
+#include "Metrics.h"
 
 namespace fibjs
 {
 
 class Stats: public Stats_base
 {
+public:
+    class _histogram
+    {
+    public:
+        enum
+        {
+            SUB_BITS = 5,
+            SUB_COUNT = 1 << SUB_BITS,
+            MAX_SHIFT = 40,
+            BUCKETS = SUB_COUNT * 2 + MAX_SHIFT * SUB_COUNT
+        };
+
+    public:
+        _histogram() : m_buckets(BUCKETS)
+        {
+            reset();
+        }
+
+    public:
+        void record(int64_t value)
+        {
+            m_buckets[index(value)].inc();
+        }
+
+        void reset()
+        {
+            for (int32_t i = 0; i < BUCKETS; i++)
+                m_buckets[i] = 0;
+        }
+
+        void snapshot(std::vector<int64_t> &retVal, int64_t &count);
+
+        static int32_t index(int64_t value);
+        static int64_t lower(int32_t idx);
+        static int64_t upper(int32_t idx);
+        static int64_t percentile(std::vector<int64_t> &buckets, int64_t count, double p);
+
+    private:
+        std::vector<exlib::atomic> m_buckets;
+    };
+
+public:
+    Stats() :
+        m_static(0), m_size(0)
+    {
+        m_id = Metrics::add(this);
+    }
+
+    ~Stats()
+    {
+        Metrics::remove(m_id);
+    }
+
 public:
     // Stats_base
+    virtual result_t get_name(std::string &retVal);
+    virtual result_t set_name(const char *newVal);
     virtual result_t inc(const char *key);
     virtual result_t dec(const char *key);
     virtual result_t add(const char *key, int32_t value);
+    virtual result_t record(const char *key, double value);
+    virtual result_t percentile(const char *key, double p, double &retVal);
+    virtual result_t histogram(const char *key, v8::Local<v8::Object> &retVal);
     virtual result_t reset();
     virtual result_t uptime(int32_t &retVal);
     virtual result_t _named_getter(const char *property, int32_t &retVal);
@@ -41,6 +100,11 @@ public:
         m_counters[n].add(value);
     }
 
+    void record(int32_t n, int64_t value)
+    {
+        m_histograms[n].record(value);
+    }
+
 public:
     void init(int32_t sn, int32_t n);
     void set_key(int32_t n, const char *key);
@@ -64,13 +128,35 @@ public:
         init(NULL, 0, keys, n);
     }
 
+    void init_histograms(int32_t n);
+    void set_histogram(int32_t n, const char *key);
+    result_t set_histogram(int32_t n, v8::Local<v8::Value> key);
+
+    void init_histograms(const char **keys, int32_t n)
+    {
+        int32_t i;
+
+        init_histograms(n);
+
+        for (i = 0; i < n; i++)
+            set_histogram(i, keys[i]);
+    }
+
+    void render_counters(std::string &retVal);
+    void render_histograms(std::string &retVal);
+
 private:
     int32_t find(const char *key);
+    int32_t find_histogram(const char *key);
 
 private:
+    int32_t m_id;
+    std::string m_name;
     int32_t m_static, m_size;
     std::vector<std::string> m_keys;
     std::vector<exlib::atomic> m_counters;
+    std::vector<std::string> m_hkeys;
+    std::vector<_histogram> m_histograms;
     date_t m_date;
 };
 
@@ -0,0 +1,56 @@
+/*
+ * Ticks.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+#ifndef TICKS_H_
+#define TICKS_H_
+
+namespace fibjs
+{
+
+// monotonic clock in nanoseconds, only differences are meaningful
+inline int64_t Ticks()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER s_freq;
+    LARGE_INTEGER t;
+
+    if (s_freq.QuadPart == 0)
+        QueryPerformanceFrequency(&s_freq);
+
+    QueryPerformanceCounter(&t);
+
+    return t.QuadPart / s_freq.QuadPart * 1000000000ll
+           + t.QuadPart % s_freq.QuadPart * 1000000000ll / s_freq.QuadPart;
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t s_timebase;
+
+    if (s_timebase.denom == 0)
+        mach_timebase_info(&s_timebase);
+
+    return (int64_t)(mach_absolute_time() * s_timebase.numer / s_timebase.denom);
+#else
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+        return 0;
+
+    return ts.tv_sec * 1000000000ll + ts.tv_nsec;
+#endif
+}
+
+} /* namespace fibjs */
+#endif /* TICKS_H_ */
@@ -0,0 +1,60 @@
+/*
+ * TimerWheel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+namespace fibjs
+{
+
+class TimerWheel
+{
+public:
+    class Entry
+    {
+    public:
+        Entry() :
+            m_prev(NULL), m_next(NULL), m_slot(NULL), m_expire(0)
+        {
+        }
+
+        virtual ~Entry()
+        {
+        }
+
+    public:
+        // called in a fiber of its own once the entry expires
+        virtual void timeout() = 0;
+
+    private:
+        Entry *m_prev;
+        Entry *m_next;
+        Entry **m_slot;
+        int64_t m_expire;
+
+        friend class TimerWheel;
+    };
+
+public:
+    static void start(Entry *e, int32_t ms);
+    static bool cancel(Entry *e);
+
+private:
+    class _wake;
+
+    static void add(Entry *e);
+    static void unlink(Entry *e);
+    static void schedule(int64_t expire);
+    static void tick(int64_t gen);
+    static void _timeout(Entry *e);
+};
+
+} /* namespace fibjs */
+#endif /* TIMERWHEEL_H_ */
@@ -37,6 +37,8 @@ public:
     // WebSocketHandler_base
     virtual result_t get_maxSize(int32_t &retVal);
     virtual result_t set_maxSize(int32_t newVal);
+    virtual result_t get_compress(bool &retVal);
+    virtual result_t set_compress(bool newVal);
     virtual result_t get_handler(obj_ptr<Handler_base> &retVal);
     virtual result_t set_handler(Handler_base *newVal);
     virtual result_t get_stats(obj_ptr<Stats_base> &retVal);
@@ -48,6 +50,7 @@ public:
 private:
     naked_ptr<Handler_base> m_hdlr;
     int32_t m_maxSize;
+    bool m_compress;
 };
 
 } /* namespace fibjs */
@@ -0,0 +1,50 @@
+/*
+ * WebSocketHub.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/WebSocketHub.h"
+#include "WebSocketStream.h"
+#include "Stats.h"
+#include <map>
+
+#ifndef WEBSOCKETHUB_H_
+#define WEBSOCKETHUB_H_
+
+namespace fibjs
+{
+
+class WebSocketHub: public WebSocketHub_base
+{
+public:
+    WebSocketHub(int32_t maxPending);
+
+public:
+    // WebSocketHub_base
+    virtual result_t add(Stream_base *stm);
+    virtual result_t remove(Stream_base *stm);
+    virtual result_t send(const char *data, int32_t &retVal);
+    virtual result_t send(Buffer_base *data, int32_t &retVal);
+    virtual result_t close();
+    virtual result_t get_compress(bool &retVal);
+    virtual result_t set_compress(bool newVal);
+    virtual result_t get_maxPending(int32_t &retVal);
+    virtual result_t set_maxPending(int32_t newVal);
+    virtual result_t get_size(int32_t &retVal);
+    virtual result_t get_stats(obj_ptr<Stats_base> &retVal);
+
+private:
+    result_t broadcast(int32_t type, std::string &payload, int32_t &retVal);
+    void evict(WebSocketStream *ws);
+
+private:
+    std::map<WebSocketStream *, obj_ptr<WebSocketStream> > m_members;
+    obj_ptr<Stats> m_stats;
+    int32_t m_maxPending;
+    bool m_compress;
+};
+
+} /* namespace fibjs */
+#endif /* WEBSOCKETHUB_H_ */
@@ -53,6 +53,9 @@ public:
 
 public:
     static result_t copy(Stream_base *from, Stream_base *to, int64_t bytes, uint32_t mask, AsyncEvent *ac);
+    static void mask(char *buf, size_t sz, uint32_t mask, int64_t pos);
+    static void frame(std::string &retVal, int32_t type, bool compressed, bool masked,
+                      const std::string &payload);
 
 public:
     obj_ptr<Stream_base> m_stm;
@@ -0,0 +1,106 @@
+/*
+ * WebSocketStream.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/Stream.h"
+#include <zlib/include/zlib.h>
+#include <list>
+
+#ifndef WEBSOCKETSTREAM_H_
+#define WEBSOCKETSTREAM_H_
+
+namespace fibjs
+{
+
+class WebSocketStream: public Stream_base
+{
+public:
+    WebSocketStream(Stream_base *stm, bool bServer);
+    ~WebSocketStream();
+
+public:
+    // Stream_base
+    virtual result_t read(int32_t bytes, obj_ptr<Buffer_base> &retVal, AsyncEvent *ac);
+    virtual result_t write(Buffer_base *data, AsyncEvent *ac);
+    virtual result_t close(AsyncEvent *ac);
+    virtual result_t copyTo(Stream_base *stm, int64_t bytes, int64_t &retVal, AsyncEvent *ac);
+
+public:
+    class _deflate_param
+    {
+    public:
+        _deflate_param() :
+            server_no_context_takeover(false), client_no_context_takeover(false),
+            server_max_window_bits(0), client_max_window_bits(0)
+        {
+        }
+
+    public:
+        bool parse(const char *ext);
+        std::string str();
+
+    public:
+        bool server_no_context_takeover;
+        bool client_no_context_takeover;
+        int32_t server_max_window_bits;
+        int32_t client_max_window_bits;
+    };
+
+public:
+    result_t setDeflate(bool bServer, _deflate_param &param);
+    result_t send(int32_t type, bool masked, std::string &payload, AsyncEvent *ac);
+    result_t send(Buffer_base *frame);
+    result_t decompress(std::string &data, int32_t maxSize);
+
+    int64_t pending();
+
+    bool deflated()
+    {
+        return m_deflate;
+    }
+
+    bool shared_deflate()
+    {
+        return m_shared;
+    }
+
+    bool server()
+    {
+        return m_server;
+    }
+
+    static result_t deflate_frame(std::string &data);
+
+private:
+    class asyncFlush;
+
+    result_t push(Buffer_base *frame, AsyncEvent *ac);
+    static result_t compress(z_stream &zs, std::string &data);
+
+private:
+    obj_ptr<Stream_base> m_stm;
+
+    // keeps compression and framing in send order, the spinlock below only
+    // guards the queue
+    exlib::Locker m_sendLock;
+
+    exlib::spinlock m_lock;
+    std::list<obj_ptr<Buffer_base> > m_queue;
+    std::list<AsyncEvent *> m_acs;
+    int64_t m_pending;
+    bool m_writing;
+    result_t m_error;
+
+    bool m_server;
+    bool m_deflate;
+    bool m_reset;
+    bool m_shared;
+    z_stream m_zdef;
+    z_stream m_zinf;
+};
+
+} /* namespace fibjs */
+#endif /* WEBSOCKETSTREAM_H_ */
@@ -19,60 +19,51 @@ namespace fibjs
 {
 
 #define LOGTIME true
+#define LOG_BUFFER_SIZE 4096
+#define MAX_LOG_BUFFER_SIZE 1048576
 
 class logger : public AsyncEvent
 {
 public:
-    class item : public exlib::linkitem
+    enum
     {
-    public:
-        item(int32_t priority, std::string& msg) :
-            m_priority(priority), m_msg(msg)
-        {
-            m_d.now();
-        }
+        OVERFLOW_BLOCK = 0,
+        OVERFLOW_DROP
+    };
 
-        std::string full(bool type = LOGTIME)
+    class item
+    {
+    public:
+        item() : m_priority(0)
         {
-            static const char *s_levels[] =
-            {
-                "FATAL  - ",
-                "ALERT  - ",
-                "CRIT   - ",
-                "ERROR  - ",
-                "WARN   - ",
-                "NOTICE - ",
-                "INFO   - ",
-                "DEBUG  - ",
-                "",
-                "",
-                ""
-            };
-            std::string s;
-            if (type) {
-                m_d.sqlString(s);
-                s.append(" ", 1);
-            }
-
-            s.append(s_levels[m_priority]);
-            s.append(m_msg);
-
-            return s;
         }
 
     public:
+        exlib::atomic m_seq;
         int32_t m_priority;
         std::string m_msg;
         date_t m_d;
     };
 
 public:
-    logger() : m_bWorking(false), m_bStop(false)
+    logger() : m_items(NULL), m_overflow(OVERFLOW_BLOCK), m_head(0),
+        m_last(NULL), m_bStop(false)
     {
         int32_t i;
 
         for (i = 0; i < console_base::_NOTSET; i ++)
             m_levels[i] = true;
+
+        m_tail = 0;
+        m_dropped = 0;
+        m_working = 0;
+
+        resize(LOG_BUFFER_SIZE);
+    }
+
+    virtual ~logger()
+    {
+        delete[] m_items;
     }
 
     virtual result_t config(v8::Local<v8::Object> o)
@@ -112,41 +103,70 @@ public:
             m_levels[console_base::_PRINT] = true;
         }
 
+        int32_t size;
+
+        hr = GetConfigValue(o, "buffer", size);
+        if (hr == CALL_E_PARAMNOTOPTIONAL)
+        {
+        }
+        else if (hr < 0)
+            return hr;
+        else
+        {
+            if (size < 16 || size > MAX_LOG_BUFFER_SIZE)
+                return CHECK_ERROR(Runtime::setError("console: buffer must between 16 to 1048576."));
+
+            resize(size);
+        }
+
+        std::string overflow;
+
+        hr = GetConfigValue(o, "overflow", overflow);
+        if (hr == CALL_E_PARAMNOTOPTIONAL)
+        {
+        }
+        else if (hr < 0)
+            return hr;
+        else if (!qstrcmp(overflow.c_str(), "block"))
+            m_overflow = OVERFLOW_BLOCK;
+        else if (!qstrcmp(overflow.c_str(), "drop"))
+            m_overflow = OVERFLOW_DROP;
+        else
+            return CHECK_ERROR(Runtime::setError("console: unknown overflow policy."));
+
         return 0;
     }
 
     virtual int32_t post(int32_t v)
     {
         result_t hr = v;
-        bool bStop = false;
+        bool bStop;
 
-        do
+        while (true)
         {
-            if (hr < 0)
+            if (hr >= 0 && ready())
             {
-                m_lock.lock();
-                m_bWorking = false;
-                bStop = m_bStop;
-                m_lock.unlock();
+                hr = write(this);
+                if (hr == CALL_E_PENDDING)
+                    return hr;
 
-                break;
+                continue;
             }
 
             m_lock.lock();
-
-            m_acLog.getList(m_workinglogs);
-            if (m_workinglogs.empty()) {
-                m_bWorking = false;
-                bStop = m_bStop;
+            m_working.xchg(0);
+            if (hr >= 0 && ready())
+            {
+                m_working.xchg(1);
                 m_lock.unlock();
-
-                break;
+                continue;
             }
 
+            bStop = m_bStop;
             m_lock.unlock();
 
-            hr = write(this);
-        } while (hr != CALL_E_PENDDING);
+            break;
+        }
 
         if (bStop)
             destroy();
@@ -166,22 +186,41 @@ public:
     {
         if (priority >= 0 && priority < console_base::_NOTSET && m_levels[priority])
         {
-            item* i = new item(priority, msg);
+            intptr_t pos;
+            item* i;
 
-            m_lock.lock();
-            m_acLog.putTail(i);
-            if (!m_bWorking)
+            while ((i = acquire(pos)) == NULL)
             {
-                m_bWorking = true;
-                async();
+                if (m_overflow == OVERFLOW_DROP)
+                {
+                    m_dropped.inc();
+                    return;
+                }
+
+                wait();
+            }
+
+            i->m_priority = priority;
+            i->m_msg = msg;
+            i->m_d.now();
+            i->m_seq.xchg(pos + 1);
+
+            if ((intptr_t)m_working == 0)
+            {
+                m_lock.lock();
+                if ((intptr_t)m_working == 0)
+                {
+                    m_working.xchg(1);
+                    async();
+                }
+                m_lock.unlock();
             }
-            m_lock.unlock();
         }
     }
 
     void flush(bool bFiber)
     {
-        while (!m_acLog.empty() || m_bWorking)
+        while ((intptr_t)m_working || (intptr_t)m_tail != m_head)
             if (bFiber)
                 coroutine_base::sleep(1);
             else
@@ -191,7 +230,7 @@ public:
     void stop()
     {
         m_lock.lock();
-        if (!m_bWorking)
+        if (!(intptr_t)m_working)
         {
             destroy();
             return;
@@ -201,6 +240,78 @@ public:
         m_lock.unlock();
     }
 
+    item* next()
+    {
+        item* p;
+
+        release();
+
+        if ((intptr_t)m_dropped)
+        {
+            char buf[64];
+
+            m_drop.m_priority = console_base::_WARN;
+            sprintf(buf, "console: %d messages dropped.", (int32_t)m_dropped.xchg(0));
+            m_drop.m_msg = buf;
+            m_drop.m_d.now();
+
+            return m_last = &m_drop;
+        }
+
+        p = &m_items[m_head & m_mask];
+        if ((intptr_t)p->m_seq != m_head + 1)
+            return NULL;
+
+        return m_last = p;
+    }
+
+    void discard()
+    {
+        intptr_t tail;
+
+        release();
+        tail = m_tail;
+
+        while (tail - m_head > 0 && next())
+            release();
+    }
+
+    void format(item* p, std::string& retVal, bool type = LOGTIME)
+    {
+        static const char *s_levels[] =
+        {
+            "FATAL  - ",
+            "ALERT  - ",
+            "CRIT   - ",
+            "ERROR  - ",
+            "WARN   - ",
+            "NOTICE - ",
+            "INFO   - ",
+            "DEBUG  - ",
+            "",
+            "",
+            ""
+        };
+
+        if (type)
+        {
+            double t = p->m_d.diff(m_stampDate);
+
+            if (m_stampDate.empty() || t < 0 || t >= 1000)
+            {
+                m_stampDate = p->m_d;
+                m_stampDate.fix(date_t::_SECOND);
+                m_stampDate.sqlString(m_stamp);
+            }
+
+            retVal.append(m_stamp);
+            retVal.append(" ", 1);
+        }
+
+        retVal.append(s_levels[p->m_priority]);
+        retVal.append(p->m_msg);
+    }
+
 public:
     static std::string &notice()
     {
@@ -225,19 +336,91 @@ public:
     static TextColor *get_std_color();
 
 protected:
-    exlib::List<item> m_workinglogs;
+    std::string m_buffer;
 
     void destroy()
     {
-        item* p1;
-        while ((p1 = m_acLog.getHead()) != 0)
-            delete p1;
         delete this;
     }
 
 private:
-    exlib::List<item> m_acLog;
-    bool m_bWorking;
+    void resize(int32_t size)
+    {
+        int32_t i;
+
+        for (m_size = 16; m_size < size; m_size <<= 1);
+        m_mask = m_size - 1;
+
+        delete[] m_items;
+        m_items = new item[m_size];
+
+        for (i = 0; i < m_size; i ++)
+            m_items[i].m_seq = i;
+    }
+
+    item* acquire(intptr_t& pos)
+    {
+        item* p;
+        intptr_t dif;
+
+        pos = m_tail;
+        while (true)
+        {
+            p = &m_items[pos & m_mask];
+            dif = (intptr_t)p->m_seq - pos;
+
+            if (dif == 0)
+            {
+                if (m_tail.CompareAndSwap(pos, pos + 1) == pos)
+                    return p;
+            }
+            else if (dif < 0)
+                return NULL;
+
+            pos = m_tail;
+        }
+    }
+
+    void release()
+    {
+        if (m_last == &m_drop)
+            m_last = NULL;
+        else if (m_last)
+        {
+            if (m_last->m_msg.capacity() > STREAM_BUFF_SIZE)
+                std::string().swap(m_last->m_msg);
+
+            m_last->m_seq.xchg(m_head + m_size);
+            m_head ++;
+            m_last = NULL;
+        }
+    }
+
+    bool ready()
+    {
+        release();
+        return (intptr_t)m_dropped || (intptr_t)m_items[m_head & m_mask].m_seq == m_head + 1;
+    }
+
+    void wait();
+
+private:
+    item* m_items;
+    int32_t m_size;
+    int32_t m_mask;
+    int32_t m_overflow;
+
+    exlib::atomic m_tail;
+    exlib::atomic m_dropped;
+
+    intptr_t m_head;
+    item* m_last;
+    item m_drop;
+
+    date_t m_stampDate;
+    std::string m_stamp;
+
+    exlib::atomic m_working;
     bool m_bStop;
     exlib::spinlock m_lock;
     bool m_levels[console_base::_NOTSET];
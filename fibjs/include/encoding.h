@@ -8,6 +8,11 @@
 #include "Buffer.h"
 #include "utf8.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HEX_SSE2
+#endif
+
 #ifndef ENCODING_H_
 #define ENCODING_H_
 
@@ -61,9 +66,9 @@ inline void baseEncode(const char *pEncodingTable, int32_t dwBits,
 inline void baseEncode(const char *pEncodingTable, int32_t dwBits,
                        Buffer_base *data, std::string &retVal)
 {
-	std::string strData;
-	data->toString(strData);
-	baseEncode(pEncodingTable, dwBits, strData, retVal);
+	const std::string &strData = ((Buffer *)data)->data();
+	baseEncode(pEncodingTable, dwBits, strData.c_str(),
+	           (int32_t)strData.length(), retVal);
 }
 
 inline void baseDecode(const char *pdecodeTable, int32_t dwBits,
@@ -107,5 +112,255 @@ inline void baseDecode(const char *pdecodeTable, int32_t dwBits,
 	retVal = new Buffer(strBuf);
 }
 
+
+inline const char *base64Chars()
+{
+	return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+// decode value of a base64 char, '-' and '_' of the url safe alphabet are
+// accepted too, -1 for chars to be skipped.
+inline int32_t base64Value(unsigned char ch)
+{
+	class _table
+	{
+	public:
+		_table()
+		{
+			const char *chars = base64Chars();
+			int32_t i;
+
+			memset(v, -1, sizeof(v));
+			for (i = 0; i < 64; i ++)
+				v[(unsigned char)chars[i]] = (signed char)i;
+			v['-'] = 62;
+			v['_'] = 63;
+		}
+
+	public:
+		signed char v[256];
+	};
+
+	static _table s_table;
+
+	return s_table.v[ch];
+}
+
+inline int32_t base64Size(int32_t sz)
+{
+	return (sz + 2) / 3 * 4;
+}
+
+// encodes whole 3 bytes groups, and pads the tail with '='. out must hold
+// base64Size(sz) chars.
+inline void base64Encode(const char *data, int32_t sz, char *out)
+{
+	const unsigned char *p = (const unsigned char *)data;
+	const char *chars = base64Chars();
+	uint32_t v;
+
+	while (sz >= 3)
+	{
+		v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+
+		out[0] = chars[v >> 18];
+		out[1] = chars[(v >> 12) & 0x3f];
+		out[2] = chars[(v >> 6) & 0x3f];
+		out[3] = chars[v & 0x3f];
+
+		p += 3;
+		out += 4;
+		sz -= 3;
+	}
+
+	if (sz > 0)
+	{
+		v = (uint32_t)p[0] << 16;
+		if (sz > 1)
+			v |= (uint32_t)p[1] << 8;
+
+		out[0] = chars[v >> 18];
+		out[1] = chars[(v >> 12) & 0x3f];
+		out[2] = sz > 1 ? chars[(v >> 6) & 0x3f] : '=';
+		out[3] = '=';
+	}
+}
+
+inline void base64Encode(const char *data, int32_t sz, std::string &retVal)
+{
+	retVal.resize(base64Size(sz));
+	if (sz > 0)
+		base64Encode(data, sz, &retVal[0]);
+}
+
+class base64Decoder
+{
+public:
+	base64Decoder() : m_curr(0), m_bits(0)
+	{
+	}
+
+public:
+	// appends the decoded bytes to retVal, the bits of an incomplete group
+	// are kept for the next call.
+	void decode(const char *data, int32_t sz, std::string &retVal)
+	{
+		const unsigned char *p = (const unsigned char *)data;
+		const unsigned char *end = p + sz;
+		size_t pos = retVal.length();
+		int32_t a, b, c, d;
+		char *out;
+
+		retVal.resize(pos + (sz / 4 + 1) * 3);
+		out = &retVal[0] + pos;
+
+		while (p < end)
+		{
+			if (m_bits == 0 && end - p >= 4)
+			{
+				a = base64Value(p[0]);
+				b = base64Value(p[1]);
+				c = base64Value(p[2]);
+				d = base64Value(p[3]);
+
+				if ((a | b | c | d) >= 0)
+				{
+					uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+
+					out[0] = (char)(v >> 16);
+					out[1] = (char)(v >> 8);
+					out[2] = (char)v;
+
+					out += 3;
+					p += 4;
+					continue;
+				}
+			}
+
+			a = base64Value(*p++);
+			if (a >= 0)
+			{
+				m_curr = (m_curr << 6) | a;
+				m_bits += 6;
+
+				if (m_bits >= 8)
+				{
+					m_bits -= 8;
+					*out++ = (char)(m_curr >> m_bits);
+					m_curr &= (1 << m_bits) - 1;
+				}
+			}
+		}
+
+		retVal.resize(out - retVal.c_str());
+	}
+
+private:
+	int32_t m_curr;
+	int32_t m_bits;
+};
+
+inline void base64Decode(const char *data, int32_t sz, std::string &retVal)
+{
+	base64Decoder dec;
+
+	retVal.clear();
+	dec.decode(data, sz, retVal);
+}
+
+inline void hexEncode(const char *data, int32_t sz, char *out)
+{
+	static const char HexChar[] = "0123456789abcdef";
+	const unsigned char *p = (const unsigned char *)data;
+
+#ifdef HEX_SSE2
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	const __m128i nine = _mm_set1_epi8(9);
+	const __m128i zero = _mm_set1_epi8('0');
+	const __m128i alpha = _mm_set1_epi8('a' - '0' - 10);
+
+	while (sz >= 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *)p);
+		__m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), mask);
+		__m128i lo = _mm_and_si128(v, mask);
+		__m128i v1 = _mm_unpacklo_epi8(hi, lo);
+		__m128i v2 = _mm_unpackhi_epi8(hi, lo);
+
+		v1 = _mm_add_epi8(_mm_add_epi8(v1, zero),
+		                  _mm_and_si128(_mm_cmpgt_epi8(v1, nine), alpha));
+		v2 = _mm_add_epi8(_mm_add_epi8(v2, zero),
+		                  _mm_and_si128(_mm_cmpgt_epi8(v2, nine), alpha));
+
+		_mm_storeu_si128((__m128i *)out, v1);
+		_mm_storeu_si128((__m128i *)(out + 16), v2);
+
+		p += 16;
+		out += 32;
+		sz -= 16;
+	}
+#endif
+
+	while (sz > 0)
+	{
+		out[0] = HexChar[*p >> 4];
+		out[1] = HexChar[*p & 0xf];
+
+		p ++;
+		out += 2;
+		sz --;
+	}
+}
+
+inline void hexEncode(const char *data, int32_t sz, std::string &retVal)
+{
+	retVal.resize(sz * 2);
+	if (sz > 0)
+		hexEncode(data, sz, &retVal[0]);
+}
+
+// non hex chars are skipped, a hex char followed by a non hex char is
+// decoded as a single digit.
+inline void hexDecode(const char *data, int32_t sz, std::string &retVal)
+{
+	const unsigned char *p = (const unsigned char *)data;
+	const unsigned char *end = p + sz;
+	uint32_t ch1, ch2;
+	char *out;
+
+	retVal.resize(sz / 2);
+	if (sz < 2)
+	{
+		retVal.clear();
+		return;
+	}
+
+	out = &retVal[0];
+
+	while (p < end)
+	{
+		ch1 = *p++;
+		if (!qisxdigit(ch1))
+			continue;
+		ch1 = qhex(ch1);
+
+		if (p == end)
+			break;
+
+		ch2 = *p++;
+		if (qisxdigit(ch2))
+			ch2 = qhex(ch2);
+		else
+		{
+			ch2 = ch1;
+			ch1 = 0;
+		}
+
+		*out++ = (char)((ch1 << 4) + ch2);
+	}
+
+	retVal.resize(out - retVal.c_str());
+}
+
 } /* namespace fibjs */
 #endif /* ENCODING_H_ */
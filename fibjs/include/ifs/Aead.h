@@ -0,0 +1,220 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _Aead_base_H_
+#define _Aead_base_H_
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs
+{
+
+class Buffer_base;
+class Stream_base;
+
+class Aead_base : public object_base
+{
+    DECLARE_CLASS(Aead_base);
+
+public:
+    // Aead_base
+    virtual result_t get_name(std::string& retVal) = 0;
+    virtual result_t get_keySize(int32_t& retVal) = 0;
+    virtual result_t get_ivSize(int32_t& retVal) = 0;
+    virtual result_t get_tagSize(int32_t& retVal) = 0;
+    virtual result_t encrypt(Buffer_base* iv, Buffer_base* data, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t encrypt(Buffer_base* iv, Buffer_base* data, Buffer_base* aad, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t decrypt(Buffer_base* iv, Buffer_base* data, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t decrypt(Buffer_base* iv, Buffer_base* data, Buffer_base* aad, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t encryptTo(Buffer_base* iv, Stream_base* src, Stream_base* stm, AsyncEvent* ac) = 0;
+    virtual result_t decryptTo(Buffer_base* iv, Stream_base* src, Stream_base* stm, AsyncEvent* ac) = 0;
+
+public:
+    static void s_get_name(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_keySize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_ivSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_tagSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_encrypt(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_decrypt(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_encryptTo(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_decryptTo(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+public:
+    ASYNC_MEMBERVALUE3(Aead_base, encrypt, Buffer_base*, Buffer_base*, obj_ptr<Buffer_base>);
+    ASYNC_MEMBERVALUE4(Aead_base, encrypt, Buffer_base*, Buffer_base*, Buffer_base*, obj_ptr<Buffer_base>);
+    ASYNC_MEMBERVALUE3(Aead_base, decrypt, Buffer_base*, Buffer_base*, obj_ptr<Buffer_base>);
+    ASYNC_MEMBERVALUE4(Aead_base, decrypt, Buffer_base*, Buffer_base*, Buffer_base*, obj_ptr<Buffer_base>);
+    ASYNC_MEMBER3(Aead_base, encryptTo, Buffer_base*, Stream_base*, Stream_base*);
+    ASYNC_MEMBER3(Aead_base, decryptTo, Buffer_base*, Stream_base*, Stream_base*);
+};
+
+}
+
+#include "Buffer.h"
+#include "Stream.h"
+
+namespace fibjs
+{
+    inline ClassInfo& Aead_base::class_info()
+    {
+        static ClassData::ClassMethod s_method[] = 
+        {
+            {"encrypt", s_encrypt, false},
+            {"decrypt", s_decrypt, false},
+            {"encryptTo", s_encryptTo, false},
+            {"decryptTo", s_decryptTo, false}
+        };
+
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"name", s_get_name, block_set, false},
+            {"keySize", s_get_keySize, block_set, false},
+            {"ivSize", s_get_ivSize, block_set, false},
+            {"tagSize", s_get_tagSize, block_set, false}
+        };
+
+        static ClassData s_cd = 
+        { 
+            "Aead", NULL, 
+            4, s_method, 0, NULL, 4, s_property, NULL, NULL,
+            &object_base::class_info()
+        };
+
+        static ClassInfo s_ci(s_cd);
+        return s_ci;
+    }
+
+    inline void Aead_base::s_get_name(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        std::string vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Aead_base);
+
+        hr = pInst->get_name(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Aead_base::s_get_keySize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Aead_base);
+
+        hr = pInst->get_keySize(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Aead_base::s_get_ivSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Aead_base);
+
+        hr = pInst->get_ivSize(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Aead_base::s_get_tagSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Aead_base);
+
+        hr = pInst->get_tagSize(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Aead_base::s_encrypt(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<Buffer_base> vr;
+
+        METHOD_INSTANCE(Aead_base);
+        METHOD_ENTER(2, 2);
+
+        ARG(obj_ptr<Buffer_base>, 0);
+        ARG(obj_ptr<Buffer_base>, 1);
+
+        hr = pInst->ac_encrypt(v0, v1, vr);
+
+        METHOD_OVER(3, 3);
+
+        ARG(obj_ptr<Buffer_base>, 0);
+        ARG(obj_ptr<Buffer_base>, 1);
+        ARG(obj_ptr<Buffer_base>, 2);
+
+        hr = pInst->ac_encrypt(v0, v1, v2, vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Aead_base::s_decrypt(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<Buffer_base> vr;
+
+        METHOD_INSTANCE(Aead_base);
+        METHOD_ENTER(2, 2);
+
+        ARG(obj_ptr<Buffer_base>, 0);
+        ARG(obj_ptr<Buffer_base>, 1);
+
+        hr = pInst->ac_decrypt(v0, v1, vr);
+
+        METHOD_OVER(3, 3);
+
+        ARG(obj_ptr<Buffer_base>, 0);
+        ARG(obj_ptr<Buffer_base>, 1);
+        ARG(obj_ptr<Buffer_base>, 2);
+
+        hr = pInst->ac_decrypt(v0, v1, v2, vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Aead_base::s_encryptTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(Aead_base);
+        METHOD_ENTER(3, 3);
+
+        ARG(obj_ptr<Buffer_base>, 0);
+        ARG(obj_ptr<Stream_base>, 1);
+        ARG(obj_ptr<Stream_base>, 2);
+
+        hr = pInst->ac_encryptTo(v0, v1, v2);
+
+        METHOD_VOID();
+    }
+
+    inline void Aead_base::s_decryptTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(Aead_base);
+        METHOD_ENTER(3, 3);
+
+        ARG(obj_ptr<Buffer_base>, 0);
+        ARG(obj_ptr<Stream_base>, 1);
+        ARG(obj_ptr<Stream_base>, 2);
+
+        hr = pInst->ac_decryptTo(v0, v1, v2);
+
+        METHOD_VOID();
+    }
+
+}
+
+#endif
+
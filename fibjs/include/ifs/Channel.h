@@ -0,0 +1,173 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _Channel_base_H_
+#define _Channel_base_H_
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs
+{
+
+class Channel_base : public object_base
+{
+    DECLARE_CLASS(Channel_base);
+
+public:
+    // Channel_base
+    static result_t _new(int32_t size, obj_ptr<Channel_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    virtual result_t put(v8::Local<v8::Value> v) = 0;
+    virtual result_t take(v8::Local<v8::Value>& retVal) = 0;
+    virtual result_t tryPut(v8::Local<v8::Value> v, bool& retVal) = 0;
+    virtual result_t close() = 0;
+    virtual result_t get_length(int32_t& retVal) = 0;
+    virtual result_t get_closed(bool& retVal) = 0;
+
+public:
+    template<typename T>
+    static void __new(const T &args);
+
+public:
+    static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_put(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_take(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_tryPut(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_length(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_closed(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+};
+
+}
+
+namespace fibjs
+{
+    inline ClassInfo& Channel_base::class_info()
+    {
+        static ClassData::ClassMethod s_method[] = 
+        {
+            {"put", s_put, false},
+            {"take", s_take, false},
+            {"tryPut", s_tryPut, false},
+            {"close", s_close, false}
+        };
+
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"length", s_get_length, block_set, false},
+            {"closed", s_get_closed, block_set, false}
+        };
+
+        static ClassData s_cd = 
+        { 
+            "Channel", s__new, 
+            4, s_method, 0, NULL, 2, s_property, NULL, NULL,
+            &object_base::class_info()
+        };
+
+        static ClassInfo s_ci(s_cd);
+        return s_ci;
+    }
+
+    inline void Channel_base::s_get_length(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Channel_base);
+
+        hr = pInst->get_length(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Channel_base::s_get_closed(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        bool vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Channel_base);
+
+        hr = pInst->get_closed(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Channel_base::s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        CONSTRUCT_INIT();
+        __new(args);
+    }
+
+    template<typename T>void Channel_base::__new(const T& args)
+    {
+        obj_ptr<Channel_base> vr;
+
+        CONSTRUCT_ENTER(1, 1);
+
+        ARG(int32_t, 0);
+
+        hr = _new(v0, vr, args.This());
+
+        CONSTRUCT_RETURN();
+    }
+
+    inline void Channel_base::s_put(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(Channel_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(v8::Local<v8::Value>, 0);
+
+        hr = pInst->put(v0);
+
+        METHOD_VOID();
+    }
+
+    inline void Channel_base::s_take(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Local<v8::Value> vr;
+
+        METHOD_INSTANCE(Channel_base);
+        METHOD_ENTER(0, 0);
+
+        hr = pInst->take(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Channel_base::s_tryPut(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        bool vr;
+
+        METHOD_INSTANCE(Channel_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(v8::Local<v8::Value>, 0);
+
+        hr = pInst->tryPut(v0, vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Channel_base::s_close(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(Channel_base);
+        METHOD_ENTER(0, 0);
+
+        hr = pInst->close();
+
+        METHOD_VOID();
+    }
+
+}
+
+#endif
+
@@ -0,0 +1,169 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _DbPool_base_H_
+#define _DbPool_base_H_
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs
+{
+
+class object_base;
+class Stats_base;
+
+class DbPool_base : public object_base
+{
+    DECLARE_CLASS(DbPool_base);
+
+public:
+    // DbPool_base
+    virtual result_t acquire(obj_ptr<object_base>& retVal) = 0;
+    virtual result_t release(object_base* conn, bool healthy) = 0;
+    virtual result_t execute(v8::Local<v8::Function> func, v8::Local<v8::Value>& retVal) = 0;
+    virtual result_t close() = 0;
+    virtual result_t get_size(int32_t& retVal) = 0;
+    virtual result_t get_idle(int32_t& retVal) = 0;
+    virtual result_t get_stats(obj_ptr<Stats_base>& retVal) = 0;
+
+public:
+    static void s_acquire(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_release(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_execute(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_size(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_idle(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+};
+
+}
+
+#include "Stats.h"
+
+namespace fibjs
+{
+    inline ClassInfo& DbPool_base::class_info()
+    {
+        static ClassData::ClassMethod s_method[] = 
+        {
+            {"acquire", s_acquire, false},
+            {"release", s_release, false},
+            {"execute", s_execute, false},
+            {"close", s_close, false}
+        };
+
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"size", s_get_size, block_set, false},
+            {"idle", s_get_idle, block_set, false},
+            {"stats", s_get_stats, block_set, false}
+        };
+
+        static ClassData s_cd = 
+        { 
+            "DbPool", NULL, 
+            4, s_method, 0, NULL, 3, s_property, NULL, NULL,
+            &object_base::class_info()
+        };
+
+        static ClassInfo s_ci(s_cd);
+        return s_ci;
+    }
+
+    inline void DbPool_base::s_get_size(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(DbPool_base);
+
+        hr = pInst->get_size(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void DbPool_base::s_get_idle(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(DbPool_base);
+
+        hr = pInst->get_idle(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void DbPool_base::s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(DbPool_base);
+
+        hr = pInst->get_stats(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void DbPool_base::s_acquire(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<object_base> vr;
+
+        METHOD_INSTANCE(DbPool_base);
+        METHOD_ENTER(0, 0);
+
+        hr = pInst->acquire(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void DbPool_base::s_release(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(DbPool_base);
+        METHOD_ENTER(2, 1);
+
+        ARG(obj_ptr<object_base>, 0);
+        OPT_ARG(bool, 1, true);
+
+        hr = pInst->release(v0, v1);
+
+        METHOD_VOID();
+    }
+
+    inline void DbPool_base::s_execute(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Local<v8::Value> vr;
+
+        METHOD_INSTANCE(DbPool_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(v8::Local<v8::Function>, 0);
+
+        hr = pInst->execute(v0, vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void DbPool_base::s_close(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(DbPool_base);
+        METHOD_ENTER(0, 0);
+
+        hr = pInst->close();
+
+        METHOD_VOID();
+    }
+
+}
+
+#endif
+
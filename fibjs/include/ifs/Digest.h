@@ -13,13 +13,15 @@
  */
 
 #include "../object.h"
+#include "Stream.h"
 
 namespace fibjs
 {
 
+class Stream_base;
 class Buffer_base;
 
-class Digest_base : public object_base
+class Digest_base : public Stream_base
 {
     DECLARE_CLASS(Digest_base);
 
@@ -59,7 +61,7 @@ namespace fibjs
         { 
             "Digest", NULL, 
             2, s_method, 0, NULL, 1, s_property, NULL, NULL,
-            &object_base::class_info()
+            &Stream_base::class_info()
         };
 
         static ClassInfo s_ci(s_cd);
@@ -0,0 +1,107 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _HttpCacheHandler_base_H_
+#define _HttpCacheHandler_base_H_
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+#include "Handler.h"
+
+namespace fibjs
+{
+
+class Handler_base;
+class Stats_base;
+
+class HttpCacheHandler_base : public Handler_base
+{
+    DECLARE_CLASS(HttpCacheHandler_base);
+
+public:
+    // HttpCacheHandler_base
+    virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
+    virtual result_t clear() = 0;
+    virtual result_t get_stats(obj_ptr<Stats_base>& retVal) = 0;
+
+public:
+    static void s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_clear(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+};
+
+}
+
+#include "Stats.h"
+
+namespace fibjs
+{
+    inline ClassInfo& HttpCacheHandler_base::class_info()
+    {
+        static ClassData::ClassMethod s_method[] = 
+        {
+            {"clear", s_clear, false}
+        };
+
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"handler", s_get_handler, block_set, false},
+            {"stats", s_get_stats, block_set, false}
+        };
+
+        static ClassData s_cd = 
+        { 
+            "HttpCacheHandler", NULL, 
+            1, s_method, 0, NULL, 2, s_property, NULL, NULL,
+            &Handler_base::class_info()
+        };
+
+        static ClassInfo s_ci(s_cd);
+        return s_ci;
+    }
+
+    inline void HttpCacheHandler_base::s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Handler_base> vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpCacheHandler_base);
+
+        hr = pInst->get_handler(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpCacheHandler_base::s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpCacheHandler_base);
+
+        hr = pInst->get_stats(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpCacheHandler_base::s_clear(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(HttpCacheHandler_base);
+        METHOD_ENTER(0, 0);
+
+        hr = pInst->clear();
+
+        METHOD_VOID();
+    }
+
+}
+
+#endif
+
@@ -36,6 +36,14 @@ public:
     virtual result_t set_maxHeadersCount(int32_t newVal) = 0;
     virtual result_t get_maxUploadSize(int32_t& retVal) = 0;
     virtual result_t set_maxUploadSize(int32_t newVal) = 0;
+    virtual result_t get_maxPartSize(int32_t& retVal) = 0;
+    virtual result_t set_maxPartSize(int32_t newVal) = 0;
+    virtual result_t get_streamUpload(bool& retVal) = 0;
+    virtual result_t set_streamUpload(bool newVal) = 0;
+    virtual result_t get_timeout(int32_t& retVal) = 0;
+    virtual result_t set_timeout(int32_t newVal) = 0;
+    virtual result_t get_idleTimeout(int32_t& retVal) = 0;
+    virtual result_t set_idleTimeout(int32_t newVal) = 0;
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
     virtual result_t set_handler(Handler_base* newVal) = 0;
     virtual result_t get_stats(obj_ptr<Stats_base>& retVal) = 0;
@@ -54,6 +62,14 @@ public:
     static void s_set_maxHeadersCount(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_maxUploadSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_maxUploadSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_maxPartSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_maxPartSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_streamUpload(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_streamUpload(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_timeout(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_timeout(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_idleTimeout(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_idleTimeout(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_handler(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
@@ -73,6 +89,10 @@ namespace fibjs
             {"forceGZIP", s_get_forceGZIP, s_set_forceGZIP, false},
             {"maxHeadersCount", s_get_maxHeadersCount, s_set_maxHeadersCount, false},
             {"maxUploadSize", s_get_maxUploadSize, s_set_maxUploadSize, false},
+            {"maxPartSize", s_get_maxPartSize, s_set_maxPartSize, false},
+            {"streamUpload", s_get_streamUpload, s_set_streamUpload, false},
+            {"timeout", s_get_timeout, s_set_timeout, false},
+            {"idleTimeout", s_get_idleTimeout, s_set_idleTimeout, false},
             {"handler", s_get_handler, s_set_handler, false},
             {"stats", s_get_stats, block_set, false}
         };
@@ -80,7 +100,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "HttpHandler", s__new, 
-            0, NULL, 0, NULL, 6, s_property, NULL, NULL,
+            0, NULL, 0, NULL, 10, s_property, NULL, NULL,
             &Handler_base::class_info()
         };
 
@@ -180,6 +200,98 @@ namespace fibjs
         PROPERTY_SET_LEAVE();
     }
 
+    inline void HttpHandler_base::s_get_maxPartSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        hr = pInst->get_maxPartSize(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpHandler_base::s_set_maxPartSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        PROPERTY_VAL(int32_t);
+        hr = pInst->set_maxPartSize(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void HttpHandler_base::s_get_streamUpload(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        bool vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        hr = pInst->get_streamUpload(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpHandler_base::s_set_streamUpload(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        PROPERTY_VAL(bool);
+        hr = pInst->set_streamUpload(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void HttpHandler_base::s_get_timeout(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        hr = pInst->get_timeout(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpHandler_base::s_set_timeout(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        PROPERTY_VAL(int32_t);
+        hr = pInst->set_timeout(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void HttpHandler_base::s_get_idleTimeout(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        hr = pInst->get_idleTimeout(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpHandler_base::s_set_idleTimeout(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpHandler_base);
+
+        PROPERTY_VAL(int32_t);
+        hr = pInst->set_idleTimeout(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
     inline void HttpHandler_base::s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
     {
         obj_ptr<Handler_base> vr;
@@ -40,6 +40,10 @@ public:
     virtual result_t set_maxHeadersCount(int32_t newVal) = 0;
     virtual result_t get_maxUploadSize(int32_t& retVal) = 0;
     virtual result_t set_maxUploadSize(int32_t newVal) = 0;
+    virtual result_t get_maxPartSize(int32_t& retVal) = 0;
+    virtual result_t set_maxPartSize(int32_t newVal) = 0;
+    virtual result_t get_streamUpload(bool& retVal) = 0;
+    virtual result_t set_streamUpload(bool newVal) = 0;
     virtual result_t hasHeader(const char* name, bool& retVal) = 0;
     virtual result_t firstHeader(const char* name, Variant& retVal) = 0;
     virtual result_t allHeader(const char* name, obj_ptr<List_base>& retVal) = 0;
@@ -61,6 +65,10 @@ public:
     static void s_set_maxHeadersCount(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_maxUploadSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_maxUploadSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_maxPartSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_maxPartSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_streamUpload(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_streamUpload(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_hasHeader(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_firstHeader(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_allHeader(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -96,13 +104,15 @@ namespace fibjs
             {"keepAlive", s_get_keepAlive, s_set_keepAlive, false},
             {"upgrade", s_get_upgrade, s_set_upgrade, false},
             {"maxHeadersCount", s_get_maxHeadersCount, s_set_maxHeadersCount, false},
-            {"maxUploadSize", s_get_maxUploadSize, s_set_maxUploadSize, false}
+            {"maxUploadSize", s_get_maxUploadSize, s_set_maxUploadSize, false},
+            {"maxPartSize", s_get_maxPartSize, s_set_maxPartSize, false},
+            {"streamUpload", s_get_streamUpload, s_set_streamUpload, false}
         };
 
         static ClassData s_cd = 
         { 
             "HttpMessage", NULL, 
-            6, s_method, 0, NULL, 6, s_property, NULL, NULL,
+            6, s_method, 0, NULL, 8, s_property, NULL, NULL,
             &Message_base::class_info()
         };
 
@@ -237,6 +247,52 @@ namespace fibjs
         PROPERTY_SET_LEAVE();
     }
 
+    inline void HttpMessage_base::s_get_maxPartSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpMessage_base);
+
+        hr = pInst->get_maxPartSize(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpMessage_base::s_set_maxPartSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpMessage_base);
+
+        PROPERTY_VAL(int32_t);
+        hr = pInst->set_maxPartSize(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void HttpMessage_base::s_get_streamUpload(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        bool vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpMessage_base);
+
+        hr = pInst->get_streamUpload(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void HttpMessage_base::s_set_streamUpload(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(HttpMessage_base);
+
+        PROPERTY_VAL(bool);
+        hr = pInst->set_streamUpload(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
     inline void HttpMessage_base::s_hasHeader(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         bool vr;
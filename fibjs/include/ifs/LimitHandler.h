@@ -0,0 +1,116 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _LimitHandler_base_H_
+#define _LimitHandler_base_H_
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+#include "Handler.h"
+
+namespace fibjs
+{
+
+class Handler_base;
+class Stats_base;
+
+class LimitHandler_base : public Handler_base
+{
+    DECLARE_CLASS(LimitHandler_base);
+
+public:
+    // LimitHandler_base
+    static result_t _new(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts, obj_ptr<LimitHandler_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
+    virtual result_t get_stats(obj_ptr<Stats_base>& retVal) = 0;
+
+public:
+    template<typename T>
+    static void __new(const T &args);
+
+public:
+    static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+};
+
+}
+
+#include "Stats.h"
+
+namespace fibjs
+{
+    inline ClassInfo& LimitHandler_base::class_info()
+    {
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"handler", s_get_handler, block_set, false},
+            {"stats", s_get_stats, block_set, false}
+        };
+
+        static ClassData s_cd = 
+        { 
+            "LimitHandler", s__new, 
+            0, NULL, 0, NULL, 2, s_property, NULL, NULL,
+            &Handler_base::class_info()
+        };
+
+        static ClassInfo s_ci(s_cd);
+        return s_ci;
+    }
+
+    inline void LimitHandler_base::s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Handler_base> vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(LimitHandler_base);
+
+        hr = pInst->get_handler(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void LimitHandler_base::s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(LimitHandler_base);
+
+        hr = pInst->get_stats(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void LimitHandler_base::s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        CONSTRUCT_INIT();
+        __new(args);
+    }
+
+    template<typename T>void LimitHandler_base::__new(const T& args)
+    {
+        obj_ptr<LimitHandler_base> vr;
+
+        CONSTRUCT_ENTER(2, 1);
+
+        ARG(v8::Local<v8::Value>, 0);
+        OPT_ARG(v8::Local<v8::Object>, 1, v8::Object::New(Isolate::now()->m_isolate));
+
+        hr = _new(v0, v1, vr, args.This());
+
+        CONSTRUCT_RETURN();
+    }
+
+}
+
+#endif
+
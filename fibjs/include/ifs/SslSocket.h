@@ -34,6 +34,7 @@ public:
     virtual result_t set_verification(int32_t newVal) = 0;
     virtual result_t get_ca(obj_ptr<X509Cert_base>& retVal) = 0;
     virtual result_t get_peerCert(obj_ptr<X509Cert_base>& retVal) = 0;
+    virtual result_t get_resumed(bool& retVal) = 0;
     virtual result_t connect(Stream_base* s, const char* server_name, int32_t& retVal, AsyncEvent* ac) = 0;
     virtual result_t accept(Stream_base* s, obj_ptr<SslSocket_base>& retVal, AsyncEvent* ac) = 0;
 
@@ -47,6 +48,7 @@ public:
     static void s_set_verification(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_ca(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_get_peerCert(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_resumed(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_connect(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_accept(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -74,13 +76,14 @@ namespace fibjs
         {
             {"verification", s_get_verification, s_set_verification, false},
             {"ca", s_get_ca, block_set, false},
-            {"peerCert", s_get_peerCert, block_set, false}
+            {"peerCert", s_get_peerCert, block_set, false},
+            {"resumed", s_get_resumed, block_set, false}
         };
 
         static ClassData s_cd = 
         { 
             "SslSocket", s__new, 
-            2, s_method, 0, NULL, 3, s_property, NULL, NULL,
+            2, s_method, 0, NULL, 4, s_property, NULL, NULL,
             &Stream_base::class_info()
         };
 
@@ -135,6 +138,18 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void SslSocket_base::s_get_resumed(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        bool vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(SslSocket_base);
+
+        hr = pInst->get_resumed(vr);
+
+        METHOD_RETURN();
+    }
+
     inline void SslSocket_base::s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         CONSTRUCT_INIT();
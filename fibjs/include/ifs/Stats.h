@@ -25,9 +25,15 @@ public:
     // Stats_base
     static result_t _new(v8::Local<v8::Array> keys, obj_ptr<Stats_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(v8::Local<v8::Array> staticKeys, v8::Local<v8::Array> keys, obj_ptr<Stats_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(v8::Local<v8::Array> staticKeys, v8::Local<v8::Array> keys, v8::Local<v8::Array> histograms, obj_ptr<Stats_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    virtual result_t get_name(std::string& retVal) = 0;
+    virtual result_t set_name(const char* newVal) = 0;
     virtual result_t inc(const char* key) = 0;
     virtual result_t dec(const char* key) = 0;
     virtual result_t add(const char* key, int32_t value) = 0;
+    virtual result_t record(const char* key, double value) = 0;
+    virtual result_t percentile(const char* key, double p, double& retVal) = 0;
+    virtual result_t histogram(const char* key, v8::Local<v8::Object>& retVal) = 0;
     virtual result_t reset() = 0;
     virtual result_t uptime(int32_t& retVal) = 0;
     virtual result_t _named_getter(const char* property, int32_t& retVal) = 0;
@@ -39,9 +45,14 @@ public:
 
 public:
     static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_name(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_name(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_inc(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_dec(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_add(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_record(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_percentile(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_histogram(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_reset(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_uptime(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void i_NamedGetter(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
@@ -59,10 +70,18 @@ namespace fibjs
             {"inc", s_inc, false},
             {"dec", s_dec, false},
             {"add", s_add, false},
+            {"record", s_record, false},
+            {"percentile", s_percentile, false},
+            {"histogram", s_histogram, false},
             {"reset", s_reset, false},
             {"uptime", s_uptime, false}
         };
 
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"name", s_get_name, s_set_name, false}
+        };
+
         static ClassData::ClassNamed s_named = 
         {
             i_NamedGetter, i_NamedSetter, i_NamedDeleter, i_NamedEnumerator
@@ -71,7 +90,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "Stats", s__new, 
-            5, s_method, 0, NULL, 0, NULL, NULL, &s_named,
+            8, s_method, 0, NULL, 1, s_property, NULL, &s_named,
             &object_base::class_info()
         };
 
@@ -79,6 +98,29 @@ namespace fibjs
         return s_ci;
     }
 
+    inline void Stats_base::s_get_name(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        std::string vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Stats_base);
+
+        hr = pInst->get_name(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Stats_base::s_set_name(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(Stats_base);
+
+        PROPERTY_VAL(arg_string);
+        hr = pInst->set_name(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
     inline void Stats_base::i_NamedGetter(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
     {
         int32_t vr;
@@ -130,6 +172,14 @@ namespace fibjs
 
         hr = _new(v0, v1, vr, args.This());
 
+        METHOD_OVER(3, 3);
+
+        ARG(v8::Local<v8::Array>, 0);
+        ARG(v8::Local<v8::Array>, 1);
+        ARG(v8::Local<v8::Array>, 2);
+
+        hr = _new(v0, v1, v2, vr, args.This());
+
         CONSTRUCT_RETURN();
     }
 
@@ -170,6 +220,48 @@ namespace fibjs
         METHOD_VOID();
     }
 
+    inline void Stats_base::s_record(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(Stats_base);
+        METHOD_ENTER(2, 2);
+
+        ARG(arg_string, 0);
+        ARG(double, 1);
+
+        hr = pInst->record(v0, v1);
+
+        METHOD_VOID();
+    }
+
+    inline void Stats_base::s_percentile(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        double vr;
+
+        METHOD_INSTANCE(Stats_base);
+        METHOD_ENTER(2, 2);
+
+        ARG(arg_string, 0);
+        ARG(double, 1);
+
+        hr = pInst->percentile(v0, v1, vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void Stats_base::s_histogram(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Local<v8::Object> vr;
+
+        METHOD_INSTANCE(Stats_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(arg_string, 0);
+
+        hr = pInst->histogram(v0, vr);
+
+        METHOD_RETURN();
+    }
+
     inline void Stats_base::s_reset(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         METHOD_INSTANCE(Stats_base);
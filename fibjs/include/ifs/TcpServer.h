@@ -19,6 +19,7 @@ namespace fibjs
 
 class Socket_base;
 class Handler_base;
+class LimitHandler_base;
 class Stats_base;
 
 class TcpServer_base : public object_base
@@ -35,6 +36,7 @@ public:
     virtual result_t get_socket(obj_ptr<Socket_base>& retVal) = 0;
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
     virtual result_t set_handler(Handler_base* newVal) = 0;
+    virtual result_t limit(v8::Local<v8::Object> opts, obj_ptr<LimitHandler_base>& retVal) = 0;
     virtual result_t get_stats(obj_ptr<Stats_base>& retVal) = 0;
 
 public:
@@ -49,6 +51,7 @@ public:
     static void s_get_socket(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_handler(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_limit(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
 
 public:
@@ -60,6 +63,7 @@ public:
 
 #include "Socket.h"
 #include "Handler.h"
+#include "LimitHandler.h"
 #include "Stats.h"
 
 namespace fibjs
@@ -70,7 +74,8 @@ namespace fibjs
         {
             {"run", s_run, false},
             {"asyncRun", s_asyncRun, false},
-            {"stop", s_stop, false}
+            {"stop", s_stop, false},
+            {"limit", s_limit, false}
         };
 
         static ClassData::ClassProperty s_property[] = 
@@ -83,7 +88,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "TcpServer", s__new, 
-            3, s_method, 0, NULL, 3, s_property, NULL, NULL,
+            4, s_method, 0, NULL, 3, s_property, NULL, NULL,
             &object_base::class_info()
         };
 
@@ -196,6 +201,20 @@ namespace fibjs
         METHOD_VOID();
     }
 
+    inline void TcpServer_base::s_limit(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<LimitHandler_base> vr;
+
+        METHOD_INSTANCE(TcpServer_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(v8::Local<v8::Object>, 0);
+
+        hr = pInst->limit(v0, vr);
+
+        METHOD_RETURN();
+    }
+
 }
 
 #endif
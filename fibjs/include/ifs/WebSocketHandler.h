@@ -30,6 +30,8 @@ public:
     static result_t _new(v8::Local<v8::Value> hdlr, obj_ptr<WebSocketHandler_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     virtual result_t get_maxSize(int32_t& retVal) = 0;
     virtual result_t set_maxSize(int32_t newVal) = 0;
+    virtual result_t get_compress(bool& retVal) = 0;
+    virtual result_t set_compress(bool newVal) = 0;
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
     virtual result_t set_handler(Handler_base* newVal) = 0;
     virtual result_t get_stats(obj_ptr<Stats_base>& retVal) = 0;
@@ -42,6 +44,8 @@ public:
     static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_maxSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_maxSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_compress(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_compress(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_handler(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
@@ -58,6 +62,7 @@ namespace fibjs
         static ClassData::ClassProperty s_property[] = 
         {
             {"maxSize", s_get_maxSize, s_set_maxSize, false},
+            {"compress", s_get_compress, s_set_compress, false},
             {"handler", s_get_handler, s_set_handler, false},
             {"stats", s_get_stats, block_set, false}
         };
@@ -65,7 +70,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "WebSocketHandler", s__new, 
-            0, NULL, 0, NULL, 3, s_property, NULL, NULL,
+            0, NULL, 0, NULL, 4, s_property, NULL, NULL,
             &Handler_base::class_info()
         };
 
@@ -96,6 +101,29 @@ namespace fibjs
         PROPERTY_SET_LEAVE();
     }
 
+    inline void WebSocketHandler_base::s_get_compress(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        bool vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHandler_base);
+
+        hr = pInst->get_compress(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void WebSocketHandler_base::s_set_compress(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHandler_base);
+
+        PROPERTY_VAL(bool);
+        hr = pInst->set_compress(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
     inline void WebSocketHandler_base::s_get_handler(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
     {
         obj_ptr<Handler_base> vr;
@@ -0,0 +1,244 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _WebSocketHub_base_H_
+#define _WebSocketHub_base_H_
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs
+{
+
+class Stream_base;
+class Buffer_base;
+class Stats_base;
+
+class WebSocketHub_base : public object_base
+{
+    DECLARE_CLASS(WebSocketHub_base);
+
+public:
+    // WebSocketHub_base
+    static result_t _new(int32_t maxPending, obj_ptr<WebSocketHub_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    virtual result_t add(Stream_base* stm) = 0;
+    virtual result_t remove(Stream_base* stm) = 0;
+    virtual result_t send(const char* data, int32_t& retVal) = 0;
+    virtual result_t send(Buffer_base* data, int32_t& retVal) = 0;
+    virtual result_t close() = 0;
+    virtual result_t get_compress(bool& retVal) = 0;
+    virtual result_t set_compress(bool newVal) = 0;
+    virtual result_t get_maxPending(int32_t& retVal) = 0;
+    virtual result_t set_maxPending(int32_t newVal) = 0;
+    virtual result_t get_size(int32_t& retVal) = 0;
+    virtual result_t get_stats(obj_ptr<Stats_base>& retVal) = 0;
+
+public:
+    template<typename T>
+    static void __new(const T &args);
+
+public:
+    static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_add(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_remove(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_send(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_compress(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_compress(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_maxPending(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_maxPending(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_size(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+};
+
+}
+
+#include "Stream.h"
+#include "Buffer.h"
+#include "Stats.h"
+
+namespace fibjs
+{
+    inline ClassInfo& WebSocketHub_base::class_info()
+    {
+        static ClassData::ClassMethod s_method[] = 
+        {
+            {"add", s_add, false},
+            {"remove", s_remove, false},
+            {"send", s_send, false},
+            {"close", s_close, false}
+        };
+
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"compress", s_get_compress, s_set_compress, false},
+            {"maxPending", s_get_maxPending, s_set_maxPending, false},
+            {"size", s_get_size, block_set, false},
+            {"stats", s_get_stats, block_set, false}
+        };
+
+        static ClassData s_cd = 
+        { 
+            "WebSocketHub", s__new, 
+            4, s_method, 0, NULL, 4, s_property, NULL, NULL,
+            &object_base::class_info()
+        };
+
+        static ClassInfo s_ci(s_cd);
+        return s_ci;
+    }
+
+    inline void WebSocketHub_base::s_get_compress(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        bool vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHub_base);
+
+        hr = pInst->get_compress(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void WebSocketHub_base::s_set_compress(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHub_base);
+
+        PROPERTY_VAL(bool);
+        hr = pInst->set_compress(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void WebSocketHub_base::s_get_maxPending(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHub_base);
+
+        hr = pInst->get_maxPending(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void WebSocketHub_base::s_set_maxPending(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHub_base);
+
+        PROPERTY_VAL(int32_t);
+        hr = pInst->set_maxPending(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void WebSocketHub_base::s_get_size(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHub_base);
+
+        hr = pInst->get_size(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void WebSocketHub_base::s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+        PROPERTY_INSTANCE(WebSocketHub_base);
+
+        hr = pInst->get_stats(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void WebSocketHub_base::s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        CONSTRUCT_INIT();
+        __new(args);
+    }
+
+    template<typename T>void WebSocketHub_base::__new(const T& args)
+    {
+        obj_ptr<WebSocketHub_base> vr;
+
+        CONSTRUCT_ENTER(1, 0);
+
+        OPT_ARG(int32_t, 0, 4194304);
+
+        hr = _new(v0, vr, args.This());
+
+        CONSTRUCT_RETURN();
+    }
+
+    inline void WebSocketHub_base::s_add(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(WebSocketHub_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(obj_ptr<Stream_base>, 0);
+
+        hr = pInst->add(v0);
+
+        METHOD_VOID();
+    }
+
+    inline void WebSocketHub_base::s_remove(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(WebSocketHub_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(obj_ptr<Stream_base>, 0);
+
+        hr = pInst->remove(v0);
+
+        METHOD_VOID();
+    }
+
+    inline void WebSocketHub_base::s_send(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        int32_t vr;
+
+        METHOD_INSTANCE(WebSocketHub_base);
+        METHOD_ENTER(1, 1);
+
+        ARG(arg_string, 0);
+
+        hr = pInst->send(v0, vr);
+
+        METHOD_OVER(1, 1);
+
+        ARG(obj_ptr<Buffer_base>, 0);
+
+        hr = pInst->send(v0, vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void WebSocketHub_base::s_close(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_INSTANCE(WebSocketHub_base);
+        METHOD_ENTER(0, 0);
+
+        hr = pInst->close();
+
+        METHOD_VOID();
+    }
+
+}
+
+#endif
+
@@ -23,7 +23,9 @@ class Condition_base;
 class Event_base;
 class Trigger_base;
 class BlockQueue_base;
+class Channel_base;
 class Fiber_base;
+class Stats_base;
 
 class coroutine_base : public object_base
 {
@@ -40,6 +42,9 @@ public:
     static result_t get_fibers(v8::Local<v8::Array>& retVal);
     static result_t get_spareFibers(int32_t& retVal);
     static result_t set_spareFibers(int32_t newVal);
+    static result_t get_handlerStackSize(int32_t& retVal);
+    static result_t set_handlerStackSize(int32_t newVal);
+    static result_t get_stats(obj_ptr<Stats_base>& retVal);
 
 public:
     static void s_start(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -49,6 +54,9 @@ public:
     static void s_get_fibers(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_get_spareFibers(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_spareFibers(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_handlerStackSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_handlerStackSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
 };
 
 }
@@ -59,7 +67,9 @@ public:
 #include "Event.h"
 #include "Trigger.h"
 #include "BlockQueue.h"
+#include "Channel.h"
 #include "Fiber.h"
+#include "Stats.h"
 
 namespace fibjs
 {
@@ -80,19 +90,22 @@ namespace fibjs
             {"Condition", Condition_base::class_info},
             {"Event", Event_base::class_info},
             {"Trigger", Trigger_base::class_info},
-            {"BlockQueue", BlockQueue_base::class_info}
+            {"BlockQueue", BlockQueue_base::class_info},
+            {"Channel", Channel_base::class_info}
         };
 
         static ClassData::ClassProperty s_property[] = 
         {
             {"fibers", s_get_fibers, block_set, true},
-            {"spareFibers", s_get_spareFibers, s_set_spareFibers, true}
+            {"spareFibers", s_get_spareFibers, s_set_spareFibers, true},
+            {"handlerStackSize", s_get_handlerStackSize, s_set_handlerStackSize, true},
+            {"stats", s_get_stats, block_set, true}
         };
 
         static ClassData s_cd = 
         { 
             "coroutine", NULL, 
-            4, s_method, 6, s_object, 2, s_property, NULL, NULL,
+            4, s_method, 7, s_object, 4, s_property, NULL, NULL,
             NULL
         };
 
@@ -132,6 +145,38 @@ namespace fibjs
         PROPERTY_SET_LEAVE();
     }
 
+    inline void coroutine_base::s_get_handlerStackSize(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_handlerStackSize(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void coroutine_base::s_set_handlerStackSize(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(int32_t);
+
+        hr = set_handlerStackSize(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void coroutine_base::s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_stats(vr);
+
+        METHOD_RETURN();
+    }
+
     inline void coroutine_base::s_start(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         obj_ptr<Fiber_base> vr;
@@ -23,6 +23,7 @@ class X509Cert_base;
 class X509Crl_base;
 class X509Req_base;
 class Buffer_base;
+class Aead_base;
 
 class crypto_base : public object_base
 {
@@ -59,6 +60,7 @@ public:
     static result_t loadCert(const char* filename, obj_ptr<X509Cert_base>& retVal);
     static result_t loadCrl(const char* filename, obj_ptr<X509Crl_base>& retVal);
     static result_t loadReq(const char* filename, obj_ptr<X509Req_base>& retVal);
+    static result_t aead(const char* algo, Buffer_base* key, obj_ptr<Aead_base>& retVal);
     static result_t randomBytes(int32_t size, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     static result_t pseudoRandomBytes(int32_t size, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     static result_t randomArt(Buffer_base* data, const char* title, int32_t size, std::string& retVal);
@@ -89,6 +91,7 @@ public:
     static void s_loadCert(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_loadCrl(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_loadReq(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_aead(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_randomBytes(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_pseudoRandomBytes(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_randomArt(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -106,6 +109,7 @@ public:
 #include "X509Crl.h"
 #include "X509Req.h"
 #include "Buffer.h"
+#include "Aead.h"
 
 namespace fibjs
 {
@@ -117,6 +121,7 @@ namespace fibjs
             {"loadCert", s_loadCert, true},
             {"loadCrl", s_loadCrl, true},
             {"loadReq", s_loadReq, true},
+            {"aead", s_aead, true},
             {"randomBytes", s_randomBytes, true},
             {"pseudoRandomBytes", s_pseudoRandomBytes, true},
             {"randomArt", s_randomArt, true}
@@ -159,7 +164,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "crypto", NULL, 
-            7, s_method, 5, s_object, 21, s_property, NULL, NULL,
+            8, s_method, 5, s_object, 21, s_property, NULL, NULL,
             NULL
         };
 
@@ -367,6 +372,20 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void crypto_base::s_aead(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<Aead_base> vr;
+
+        METHOD_ENTER(2, 2);
+
+        ARG(arg_string, 0);
+        ARG(obj_ptr<Buffer_base>, 1);
+
+        hr = aead(v0, v1, vr);
+
+        METHOD_RETURN();
+    }
+
     inline void crypto_base::s_randomBytes(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         obj_ptr<Buffer_base> vr;
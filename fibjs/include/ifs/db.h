@@ -23,6 +23,8 @@ class SQLite_base;
 class MongoDB_base;
 class LevelDB_base;
 class Redis_base;
+class DbPool_base;
+class Stats_base;
 
 class db_base : public object_base
 {
@@ -36,6 +38,8 @@ public:
     static result_t openMongoDB(const char* connString, obj_ptr<MongoDB_base>& retVal, AsyncEvent* ac);
     static result_t openLevelDB(const char* connString, obj_ptr<LevelDB_base>& retVal, AsyncEvent* ac);
     static result_t openRedis(const char* connString, obj_ptr<Redis_base>& retVal, AsyncEvent* ac);
+    static result_t openPool(const char* connString, v8::Local<v8::Object> opts, obj_ptr<DbPool_base>& retVal);
+    static result_t get_stats(obj_ptr<Stats_base>& retVal);
     static result_t format(const char* sql, const v8::FunctionCallbackInfo<v8::Value>& args, std::string& retVal);
     static result_t formatMySQL(const char* sql, const v8::FunctionCallbackInfo<v8::Value>& args, std::string& retVal);
     static result_t escape(const char* str, bool mysql, std::string& retVal);
@@ -47,6 +51,8 @@ public:
     static void s_openMongoDB(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_openLevelDB(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_openRedis(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_openPool(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_format(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_formatMySQL(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_escape(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -67,6 +73,8 @@ public:
 #include "MongoDB.h"
 #include "LevelDB.h"
 #include "Redis.h"
+#include "DbPool.h"
+#include "Stats.h"
 
 namespace fibjs
 {
@@ -80,15 +88,21 @@ namespace fibjs
             {"openMongoDB", s_openMongoDB, true},
             {"openLevelDB", s_openLevelDB, true},
             {"openRedis", s_openRedis, true},
+            {"openPool", s_openPool, true},
             {"format", s_format, true},
             {"formatMySQL", s_formatMySQL, true},
             {"escape", s_escape, true}
         };
 
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"stats", s_get_stats, block_set, true}
+        };
+
         static ClassData s_cd = 
         { 
             "db", NULL, 
-            9, s_method, 0, NULL, 0, NULL, NULL, NULL,
+            10, s_method, 0, NULL, 1, s_property, NULL, NULL,
             NULL
         };
 
@@ -96,6 +110,16 @@ namespace fibjs
         return s_ci;
     }
 
+    inline void db_base::s_get_stats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_stats(vr);
+
+        METHOD_RETURN();
+    }
 
     inline void db_base::s_open(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
@@ -175,6 +199,20 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void db_base::s_openPool(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<DbPool_base> vr;
+
+        METHOD_ENTER(2, 1);
+
+        ARG(arg_string, 0);
+        OPT_ARG(v8::Local<v8::Object>, 1, v8::Object::New(Isolate::now()->m_isolate));
+
+        hr = openPool(v0, v1, vr);
+
+        METHOD_RETURN();
+    }
+
     inline void db_base::s_format(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         std::string vr;
@@ -18,6 +18,7 @@ namespace fibjs
 {
 
 class Buffer_base;
+class Stream_base;
 
 class encoding_base : public object_base
 {
@@ -29,6 +30,8 @@ public:
     static result_t base32Decode(const char* data, obj_ptr<Buffer_base>& retVal);
     static result_t base64Encode(Buffer_base* data, std::string& retVal);
     static result_t base64Decode(const char* data, obj_ptr<Buffer_base>& retVal);
+    static result_t base64EncodeTo(Stream_base* src, Stream_base* stm, AsyncEvent* ac);
+    static result_t base64DecodeTo(Stream_base* src, Stream_base* stm, AsyncEvent* ac);
     static result_t hexEncode(Buffer_base* data, std::string& retVal);
     static result_t hexDecode(const char* data, obj_ptr<Buffer_base>& retVal);
     static result_t iconvEncode(const char* charset, const char* data, obj_ptr<Buffer_base>& retVal);
@@ -47,6 +50,8 @@ public:
     static void s_base32Decode(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_base64Encode(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_base64Decode(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_base64EncodeTo(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_base64DecodeTo(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_hexEncode(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_hexDecode(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_iconvEncode(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -59,11 +64,16 @@ public:
     static void s_jsonDecode(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_bsonEncode(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_bsonDecode(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+public:
+    ASYNC_STATIC2(encoding_base, base64EncodeTo, Stream_base*, Stream_base*);
+    ASYNC_STATIC2(encoding_base, base64DecodeTo, Stream_base*, Stream_base*);
 };
 
 }
 
 #include "Buffer.h"
+#include "Stream.h"
 
 namespace fibjs
 {
@@ -75,6 +85,8 @@ namespace fibjs
             {"base32Decode", s_base32Decode, true},
             {"base64Encode", s_base64Encode, true},
             {"base64Decode", s_base64Decode, true},
+            {"base64EncodeTo", s_base64EncodeTo, true},
+            {"base64DecodeTo", s_base64DecodeTo, true},
             {"hexEncode", s_hexEncode, true},
             {"hexDecode", s_hexDecode, true},
             {"iconvEncode", s_iconvEncode, true},
@@ -92,7 +104,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "encoding", NULL, 
-            16, s_method, 0, NULL, 0, NULL, NULL, NULL,
+            18, s_method, 0, NULL, 0, NULL, NULL, NULL,
             NULL
         };
 
@@ -153,6 +165,30 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void encoding_base::s_base64EncodeTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_ENTER(2, 2);
+
+        ARG(obj_ptr<Stream_base>, 0);
+        ARG(obj_ptr<Stream_base>, 1);
+
+        hr = ac_base64EncodeTo(v0, v1);
+
+        METHOD_VOID();
+    }
+
+    inline void encoding_base::s_base64DecodeTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_ENTER(2, 2);
+
+        ARG(obj_ptr<Stream_base>, 0);
+        ARG(obj_ptr<Stream_base>, 1);
+
+        hr = ac_base64DecodeTo(v0, v1);
+
+        METHOD_VOID();
+    }
+
     inline void encoding_base::s_hexEncode(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         std::string vr;
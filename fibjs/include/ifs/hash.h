@@ -41,6 +41,7 @@ public:
     // hash_base
     static result_t digest(int32_t algo, Buffer_base* data, obj_ptr<Digest_base>& retVal);
     static result_t digest(int32_t algo, obj_ptr<Digest_base>& retVal);
+    static result_t digestMany(int32_t algo, v8::Local<v8::Array> datas, v8::Local<v8::Array>& retVal);
     static result_t md2(Buffer_base* data, obj_ptr<Digest_base>& retVal);
     static result_t md4(Buffer_base* data, obj_ptr<Digest_base>& retVal);
     static result_t md5(Buffer_base* data, obj_ptr<Digest_base>& retVal);
@@ -72,6 +73,7 @@ public:
     static void s_get_SHA512(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_get_RIPEMD160(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_digest(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_digestMany(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_md2(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_md4(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_md5(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -105,6 +107,7 @@ namespace fibjs
         static ClassData::ClassMethod s_method[] = 
         {
             {"digest", s_digest, true},
+            {"digestMany", s_digestMany, true},
             {"md2", s_md2, true},
             {"md4", s_md4, true},
             {"md5", s_md5, true},
@@ -142,7 +145,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "hash", NULL, 
-            20, s_method, 0, NULL, 9, s_property, NULL, NULL,
+            21, s_method, 0, NULL, 9, s_property, NULL, NULL,
             NULL
         };
 
@@ -233,6 +236,20 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void hash_base::s_digestMany(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Local<v8::Array> vr;
+
+        METHOD_ENTER(2, 2);
+
+        ARG(int32_t, 0);
+        ARG(v8::Local<v8::Array>, 1);
+
+        hr = digestMany(v0, v1, vr);
+
+        METHOD_RETURN();
+    }
+
     inline void hash_base::s_md2(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         obj_ptr<Digest_base> vr;
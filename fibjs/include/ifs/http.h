@@ -24,6 +24,8 @@ class HttpServer_base;
 class HttpsServer_base;
 class HttpHandler_base;
 class Handler_base;
+class HttpCacheHandler_base;
+class Stats_base;
 class Stream_base;
 class SeekableStream_base;
 class Map_base;
@@ -36,6 +38,15 @@ class http_base : public object_base
 public:
     // http_base
     static result_t fileHandler(const char* root, v8::Local<v8::Object> mimes, obj_ptr<Handler_base>& retVal);
+    static result_t metricsHandler(obj_ptr<Handler_base>& retVal);
+    static result_t cacheHandler(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts, obj_ptr<HttpCacheHandler_base>& retVal);
+    static result_t get_maxSockets(int32_t& retVal);
+    static result_t set_maxSockets(int32_t newVal);
+    static result_t get_keepAliveTimeout(int32_t& retVal);
+    static result_t set_keepAliveTimeout(int32_t newVal);
+    static result_t get_maxRequestsPerSocket(int32_t& retVal);
+    static result_t set_maxRequestsPerSocket(int32_t newVal);
+    static result_t get_agentStats(obj_ptr<Stats_base>& retVal);
     static result_t request(Stream_base* conn, HttpRequest_base* req, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
     static result_t request(const char* method, const char* url, v8::Local<v8::Object> headers, obj_ptr<HttpResponse_base>& retVal);
     static result_t request(const char* method, const char* url, SeekableStream_base* body, Map_base* headers, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
@@ -47,6 +58,15 @@ public:
 
 public:
     static void s_fileHandler(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_metricsHandler(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_cacheHandler(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_maxSockets(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_maxSockets(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_keepAliveTimeout(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_keepAliveTimeout(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_maxRequestsPerSocket(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_maxRequestsPerSocket(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_agentStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_request(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_post(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -65,6 +85,8 @@ public:
 #include "HttpsServer.h"
 #include "HttpHandler.h"
 #include "Handler.h"
+#include "HttpCacheHandler.h"
+#include "Stats.h"
 #include "Stream.h"
 #include "SeekableStream.h"
 #include "Map.h"
@@ -77,6 +99,8 @@ namespace fibjs
         static ClassData::ClassMethod s_method[] = 
         {
             {"fileHandler", s_fileHandler, true},
+            {"metricsHandler", s_metricsHandler, true},
+            {"cacheHandler", s_cacheHandler, true},
             {"request", s_request, true},
             {"get", s_get, true},
             {"post", s_post, true}
@@ -92,10 +116,18 @@ namespace fibjs
             {"Handler", HttpHandler_base::class_info}
         };
 
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"maxSockets", s_get_maxSockets, s_set_maxSockets, true},
+            {"keepAliveTimeout", s_get_keepAliveTimeout, s_set_keepAliveTimeout, true},
+            {"maxRequestsPerSocket", s_get_maxRequestsPerSocket, s_set_maxRequestsPerSocket, true},
+            {"agentStats", s_get_agentStats, block_set, true}
+        };
+
         static ClassData s_cd = 
         { 
             "http", NULL, 
-            4, s_method, 6, s_object, 0, NULL, NULL, NULL,
+            6, s_method, 6, s_object, 4, s_property, NULL, NULL,
             NULL
         };
 
@@ -103,6 +135,79 @@ namespace fibjs
         return s_ci;
     }
 
+    inline void http_base::s_get_maxSockets(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_maxSockets(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void http_base::s_set_maxSockets(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(int32_t);
+
+        hr = set_maxSockets(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void http_base::s_get_keepAliveTimeout(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_keepAliveTimeout(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void http_base::s_set_keepAliveTimeout(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(int32_t);
+
+        hr = set_keepAliveTimeout(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void http_base::s_get_maxRequestsPerSocket(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_maxRequestsPerSocket(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void http_base::s_set_maxRequestsPerSocket(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(int32_t);
+
+        hr = set_maxRequestsPerSocket(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void http_base::s_get_agentStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_agentStats(vr);
+
+        METHOD_RETURN();
+    }
 
     inline void http_base::s_fileHandler(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
@@ -118,6 +223,31 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void http_base::s_metricsHandler(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<Handler_base> vr;
+
+        METHOD_ENTER(0, 0);
+
+        hr = metricsHandler(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void http_base::s_cacheHandler(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        obj_ptr<HttpCacheHandler_base> vr;
+
+        METHOD_ENTER(2, 1);
+
+        ARG(v8::Local<v8::Value>, 0);
+        OPT_ARG(v8::Local<v8::Object>, 1, v8::Object::New(Isolate::now()->m_isolate));
+
+        hr = cacheHandler(v0, v1, vr);
+
+        METHOD_RETURN();
+    }
+
     inline void http_base::s_request(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         obj_ptr<HttpResponse_base> vr;
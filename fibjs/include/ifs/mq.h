@@ -21,6 +21,7 @@ class Message_base;
 class HttpHandler_base;
 class Chain_base;
 class Routing_base;
+class LimitHandler_base;
 class Handler_base;
 class AsyncWait_base;
 class object_base;
@@ -52,6 +53,7 @@ public:
 #include "HttpHandler.h"
 #include "Chain.h"
 #include "Routing.h"
+#include "LimitHandler.h"
 #include "Handler.h"
 #include "AsyncWait.h"
 
@@ -72,13 +74,14 @@ namespace fibjs
             {"Message", Message_base::class_info},
             {"HttpHandler", HttpHandler_base::class_info},
             {"Chain", Chain_base::class_info},
-            {"Routing", Routing_base::class_info}
+            {"Routing", Routing_base::class_info},
+            {"LimitHandler", LimitHandler_base::class_info}
         };
 
         static ClassData s_cd = 
         { 
             "mq", NULL, 
-            4, s_method, 4, s_object, 0, NULL, NULL, NULL,
+            4, s_method, 5, s_object, 0, NULL, NULL, NULL,
             NULL
         };
 
@@ -17,6 +17,7 @@
 namespace fibjs
 {
 
+class Stats_base;
 class Socket_base;
 class Stream_base;
 class Smtp_base;
@@ -38,6 +39,12 @@ public:
 public:
     // net_base
     static result_t resolve(const char* name, int32_t family, std::string& retVal, AsyncEvent* ac);
+    static result_t get_dnsCacheTTL(int32_t& retVal);
+    static result_t set_dnsCacheTTL(int32_t newVal);
+    static result_t get_dnsNegativeTTL(int32_t& retVal);
+    static result_t set_dnsNegativeTTL(int32_t newVal);
+    static result_t get_dnsStats(obj_ptr<Stats_base>& retVal);
+    static result_t clearDnsCache();
     static result_t ip(const char* name, std::string& retVal, AsyncEvent* ac);
     static result_t ipv6(const char* name, std::string& retVal, AsyncEvent* ac);
     static result_t connect(const char* host, int32_t port, int32_t family, obj_ptr<Stream_base>& retVal, AsyncEvent* ac);
@@ -51,6 +58,12 @@ public:
     static void s_get_SOCK_STREAM(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_get_SOCK_DGRAM(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_resolve(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_dnsCacheTTL(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_dnsCacheTTL(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_dnsNegativeTTL(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_dnsNegativeTTL(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_dnsStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_clearDnsCache(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_ip(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_ipv6(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_connect(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -68,6 +81,7 @@ public:
 
 }
 
+#include "Stats.h"
 #include "Socket.h"
 #include "Stream.h"
 #include "Smtp.h"
@@ -81,6 +95,7 @@ namespace fibjs
         static ClassData::ClassMethod s_method[] = 
         {
             {"resolve", s_resolve, true},
+            {"clearDnsCache", s_clearDnsCache, true},
             {"ip", s_ip, true},
             {"ipv6", s_ipv6, true},
             {"connect", s_connect, true},
@@ -101,13 +116,16 @@ namespace fibjs
             {"AF_INET", s_get_AF_INET, block_set, true},
             {"AF_INET6", s_get_AF_INET6, block_set, true},
             {"SOCK_STREAM", s_get_SOCK_STREAM, block_set, true},
-            {"SOCK_DGRAM", s_get_SOCK_DGRAM, block_set, true}
+            {"SOCK_DGRAM", s_get_SOCK_DGRAM, block_set, true},
+            {"dnsCacheTTL", s_get_dnsCacheTTL, s_set_dnsCacheTTL, true},
+            {"dnsNegativeTTL", s_get_dnsNegativeTTL, s_set_dnsNegativeTTL, true},
+            {"dnsStats", s_get_dnsStats, block_set, true}
         };
 
         static ClassData s_cd = 
         { 
             "net", NULL, 
-            6, s_method, 4, s_object, 4, s_property, NULL, NULL,
+            7, s_method, 4, s_object, 7, s_property, NULL, NULL,
             NULL
         };
 
@@ -143,6 +161,59 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void net_base::s_get_dnsCacheTTL(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_dnsCacheTTL(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void net_base::s_set_dnsCacheTTL(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(int32_t);
+
+        hr = set_dnsCacheTTL(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void net_base::s_get_dnsNegativeTTL(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_dnsNegativeTTL(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void net_base::s_set_dnsNegativeTTL(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(int32_t);
+
+        hr = set_dnsNegativeTTL(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void net_base::s_get_dnsStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_dnsStats(vr);
+
+        METHOD_RETURN();
+    }
+
     inline void net_base::s_resolve(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         std::string vr;
@@ -157,6 +228,15 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void net_base::s_clearDnsCache(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_ENTER(0, 0);
+
+        hr = clearDnsCache();
+
+        METHOD_VOID();
+    }
+
     inline void net_base::s_ip(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         std::string vr;
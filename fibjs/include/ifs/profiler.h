@@ -18,6 +18,7 @@ namespace fibjs
 {
 
 class HeapSnapshot_base;
+class Stream_base;
 
 class profiler_base : public object_base
 {
@@ -54,6 +55,9 @@ public:
     static result_t loadSnapshot(const char* fname, obj_ptr<HeapSnapshot_base>& retVal);
     static result_t takeSnapshot(obj_ptr<HeapSnapshot_base>& retVal);
     static result_t diff(v8::Local<v8::Function> test, v8::Local<v8::Object>& retVal);
+    static result_t startCPUProfile(int32_t interval);
+    static result_t stopCPUProfile(const char* fname, const char* format);
+    static result_t stopCPUProfile(Stream_base* stm, const char* format);
 
 public:
     static void s_get_Node_Hidden(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
@@ -81,11 +85,14 @@ public:
     static void s_loadSnapshot(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_takeSnapshot(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_diff(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_startCPUProfile(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_stopCPUProfile(const v8::FunctionCallbackInfo<v8::Value>& args);
 };
 
 }
 
 #include "HeapSnapshot.h"
+#include "Stream.h"
 
 namespace fibjs
 {
@@ -96,7 +103,9 @@ namespace fibjs
             {"saveSnapshot", s_saveSnapshot, true},
             {"loadSnapshot", s_loadSnapshot, true},
             {"takeSnapshot", s_takeSnapshot, true},
-            {"diff", s_diff, true}
+            {"diff", s_diff, true},
+            {"startCPUProfile", s_startCPUProfile, true},
+            {"stopCPUProfile", s_stopCPUProfile, true}
         };
 
         static ClassData::ClassProperty s_property[] = 
@@ -127,7 +136,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "profiler", NULL, 
-            4, s_method, 0, NULL, 21, s_property, NULL, NULL,
+            6, s_method, 0, NULL, 21, s_property, NULL, NULL,
             NULL
         };
 
@@ -330,6 +339,36 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void profiler_base::s_startCPUProfile(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_ENTER(1, 0);
+
+        OPT_ARG(int32_t, 0, 1000);
+
+        hr = startCPUProfile(v0);
+
+        METHOD_VOID();
+    }
+
+    inline void profiler_base::s_stopCPUProfile(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_ENTER(2, 1);
+
+        ARG(arg_string, 0);
+        OPT_ARG(arg_string, 1, "cpuprofile");
+
+        hr = stopCPUProfile(v0, v1);
+
+        METHOD_OVER(2, 1);
+
+        ARG(obj_ptr<Stream_base>, 0);
+        OPT_ARG(arg_string, 1, "cpuprofile");
+
+        hr = stopCPUProfile(v0, v1);
+
+        METHOD_VOID();
+    }
+
 }
 
 #endif
@@ -55,6 +55,8 @@ public:
     static result_t set_min_version(int32_t newVal);
     static result_t get_max_version(int32_t& retVal);
     static result_t set_max_version(int32_t newVal);
+    static result_t get_ticket_lifetime(int32_t& retVal);
+    static result_t set_ticket_lifetime(int32_t newVal);
 
 public:
     static void s_get_VERIFY_NONE(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
@@ -78,6 +80,8 @@ public:
     static void s_set_min_version(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
     static void s_get_max_version(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
     static void s_set_max_version(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_ticket_lifetime(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_ticket_lifetime(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
 
 public:
     ASYNC_STATICVALUE2(ssl_base, connect, const char*, obj_ptr<Stream_base>);
@@ -126,13 +130,14 @@ namespace fibjs
             {"ca", s_get_ca, block_set, true},
             {"verification", s_get_verification, s_set_verification, true},
             {"min_version", s_get_min_version, s_set_min_version, true},
-            {"max_version", s_get_max_version, s_set_max_version, true}
+            {"max_version", s_get_max_version, s_set_max_version, true},
+            {"ticket_lifetime", s_get_ticket_lifetime, s_set_ticket_lifetime, true}
         };
 
         static ClassData s_cd = 
         { 
             "ssl", NULL, 
-            3, s_method, 3, s_object, 15, s_property, NULL, NULL,
+            3, s_method, 3, s_object, 16, s_property, NULL, NULL,
             NULL
         };
 
@@ -291,6 +296,27 @@ namespace fibjs
         PROPERTY_SET_LEAVE();
     }
 
+    inline void ssl_base::s_get_ticket_lifetime(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        int32_t vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_ticket_lifetime(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void ssl_base::s_set_ticket_lifetime(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(int32_t);
+
+        hr = set_ticket_lifetime(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
     inline void ssl_base::s_connect(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         obj_ptr<Stream_base> vr;
@@ -42,6 +42,7 @@ public:
     static result_t beforeEach(v8::Local<v8::Function> func);
     static result_t afterEach(v8::Local<v8::Function> func);
     static result_t run(int32_t loglevel, int32_t& retVal);
+    static result_t bench(const char* name, v8::Local<v8::Function> fn, v8::Local<v8::Object> opts, v8::Local<v8::Object>& retVal);
     static result_t expect(v8::Local<v8::Value> actual, const char* msg, obj_ptr<Expect_base>& retVal);
     static result_t setup(int32_t mode);
     static result_t get_slow(int32_t& retVal);
@@ -59,6 +60,7 @@ public:
     static void s_beforeEach(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_afterEach(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_run(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_bench(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_expect(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_setup(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_slow(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
@@ -86,6 +88,7 @@ namespace fibjs
             {"beforeEach", s_beforeEach, true},
             {"afterEach", s_afterEach, true},
             {"run", s_run, true},
+            {"bench", s_bench, true},
             {"expect", s_expect, true},
             {"setup", s_setup, true}
         };
@@ -105,7 +108,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "test", NULL, 
-            11, s_method, 1, s_object, 3, s_property, NULL, NULL,
+            12, s_method, 1, s_object, 3, s_property, NULL, NULL,
             NULL
         };
 
@@ -253,6 +256,21 @@ namespace fibjs
         METHOD_RETURN();
     }
 
+    inline void test_base::s_bench(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Local<v8::Object> vr;
+
+        METHOD_ENTER(3, 2);
+
+        ARG(arg_string, 0);
+        ARG(v8::Local<v8::Function>, 1);
+        OPT_ARG(v8::Local<v8::Object>, 2, v8::Object::New(Isolate::now()->m_isolate));
+
+        hr = bench(v0, v1, v2, vr);
+
+        METHOD_RETURN();
+    }
+
     inline void test_base::s_expect(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         obj_ptr<Expect_base> vr;
@@ -18,32 +18,63 @@ namespace fibjs
 {
 
 class SandBox_base;
+class Stats_base;
 
 class vm_base : public object_base
 {
     DECLARE_CLASS(vm_base);
 
 public:
+    // vm_base
+    static result_t get_codeCacheDir(std::string& retVal);
+    static result_t set_codeCacheDir(const char* newVal);
+    static result_t get_codeCacheStats(obj_ptr<Stats_base>& retVal);
+    static result_t get_moduleCache(bool& retVal);
+    static result_t set_moduleCache(bool newVal);
+    static result_t get_moduleCacheStats(obj_ptr<Stats_base>& retVal);
+    static result_t clearModuleCache();
 
+public:
+    static void s_get_codeCacheDir(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_codeCacheDir(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_codeCacheStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_get_moduleCache(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_set_moduleCache(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args);
+    static void s_get_moduleCacheStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
+    static void s_clearModuleCache(const v8::FunctionCallbackInfo<v8::Value>& args);
 };
 
 }
 
 #include "SandBox.h"
+#include "Stats.h"
 
 namespace fibjs
 {
     inline ClassInfo& vm_base::class_info()
     {
+        static ClassData::ClassMethod s_method[] = 
+        {
+            {"clearModuleCache", s_clearModuleCache, true}
+        };
+
         static ClassData::ClassObject s_object[] = 
         {
             {"SandBox", SandBox_base::class_info}
         };
 
+        static ClassData::ClassProperty s_property[] = 
+        {
+            {"codeCacheDir", s_get_codeCacheDir, s_set_codeCacheDir, true},
+            {"codeCacheStats", s_get_codeCacheStats, block_set, true},
+            {"moduleCache", s_get_moduleCache, s_set_moduleCache, true},
+            {"moduleCacheStats", s_get_moduleCacheStats, block_set, true}
+        };
+
         static ClassData s_cd = 
         { 
             "vm", NULL, 
-            0, NULL, 1, s_object, 0, NULL, NULL, NULL,
+            1, s_method, 1, s_object, 4, s_property, NULL, NULL,
             NULL
         };
 
@@ -51,6 +82,77 @@ namespace fibjs
         return s_ci;
     }
 
+    inline void vm_base::s_get_codeCacheDir(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        std::string vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_codeCacheDir(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void vm_base::s_set_codeCacheDir(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(arg_string);
+        hr = set_codeCacheDir(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void vm_base::s_get_codeCacheStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_codeCacheStats(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void vm_base::s_get_moduleCache(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        bool vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_moduleCache(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void vm_base::s_set_moduleCache(v8::Local<v8::String> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &args)
+    {
+        PROPERTY_ENTER();
+        PROPERTY_VAL(bool);
+
+        hr = set_moduleCache(v0);
+
+        PROPERTY_SET_LEAVE();
+    }
+
+    inline void vm_base::s_get_moduleCacheStats(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args)
+    {
+        obj_ptr<Stats_base> vr;
+
+        PROPERTY_ENTER();
+
+        hr = get_moduleCacheStats(vr);
+
+        METHOD_RETURN();
+    }
+
+    inline void vm_base::s_clearModuleCache(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        METHOD_ENTER(0, 0);
+
+        hr = clearModuleCache();
+
+        METHOD_VOID();
+    }
 
 }
 
@@ -19,6 +19,7 @@ namespace fibjs
 
 class WebSocketMessage_base;
 class WebSocketHandler_base;
+class WebSocketHub_base;
 class Stream_base;
 
 class websocket_base : public object_base
@@ -37,7 +38,7 @@ public:
 
 public:
     // websocket_base
-    static result_t connect(const char* url, obj_ptr<Stream_base>& retVal, AsyncEvent* ac);
+    static result_t connect(const char* url, bool compress, obj_ptr<Stream_base>& retVal, AsyncEvent* ac);
 
 public:
     static void s_get_CONTINUE(v8::Local<v8::String> property, const v8::PropertyCallbackInfo<v8::Value> &args);
@@ -49,13 +50,14 @@ public:
     static void s_connect(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 public:
-    ASYNC_STATICVALUE2(websocket_base, connect, const char*, obj_ptr<Stream_base>);
+    ASYNC_STATICVALUE3(websocket_base, connect, const char*, bool, obj_ptr<Stream_base>);
 };
 
 }
 
 #include "WebSocketMessage.h"
 #include "WebSocketHandler.h"
+#include "WebSocketHub.h"
 #include "Stream.h"
 
 namespace fibjs
@@ -70,7 +72,8 @@ namespace fibjs
         static ClassData::ClassObject s_object[] = 
         {
             {"Message", WebSocketMessage_base::class_info},
-            {"Handler", WebSocketHandler_base::class_info}
+            {"Handler", WebSocketHandler_base::class_info},
+            {"Hub", WebSocketHub_base::class_info}
         };
 
         static ClassData::ClassProperty s_property[] = 
@@ -86,7 +89,7 @@ namespace fibjs
         static ClassData s_cd = 
         { 
             "websocket", NULL, 
-            1, s_method, 2, s_object, 6, s_property, NULL, NULL,
+            1, s_method, 3, s_object, 6, s_property, NULL, NULL,
             NULL
         };
 
@@ -140,11 +143,12 @@ namespace fibjs
     {
         obj_ptr<Stream_base> vr;
 
-        METHOD_ENTER(1, 1);
+        METHOD_ENTER(2, 1);
 
         ARG(arg_string, 0);
+        OPT_ARG(bool, 1, false);
 
-        hr = ac_connect(v0, vr);
+        hr = ac_connect(v0, v1, vr);
 
         METHOD_RETURN();
     }
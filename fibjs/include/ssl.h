@@ -15,10 +15,97 @@
 #include <mbedtls/mbedtls/ssl.h>
 #include <mbedtls/mbedtls/ssl_cache.h>
 #include "X509Cert.h"
+#include <map>
 
 namespace fibjs
 {
 
+class _session_cache
+{
+public:
+    _session_cache() : m_max(1024)
+    {
+    }
+
+    ~_session_cache()
+    {
+        std::map<std::string, mbedtls_ssl_session *>::iterator it;
+
+        for (it = m_sessions.begin(); it != m_sessions.end(); ++it)
+            free(it->second);
+    }
+
+public:
+    void get(const std::string &key, mbedtls_ssl_context *ssl)
+    {
+        std::map<std::string, mbedtls_ssl_session *>::iterator it;
+
+        m_lock.lock();
+        it = m_sessions.find(key);
+        if (it != m_sessions.end())
+            mbedtls_ssl_set_session(ssl, it->second);
+        m_lock.unlock();
+    }
+
+    void put(const std::string &key, const mbedtls_ssl_context *ssl)
+    {
+        mbedtls_ssl_session *session = new mbedtls_ssl_session;
+        std::map<std::string, mbedtls_ssl_session *>::iterator it;
+
+        mbedtls_ssl_session_init(session);
+        if (mbedtls_ssl_get_session(ssl, session) != 0)
+        {
+            free(session);
+            return;
+        }
+
+        m_lock.lock();
+        it = m_sessions.find(key);
+        if (it != m_sessions.end())
+        {
+            free(it->second);
+            it->second = session;
+        }
+        else
+        {
+            if (m_sessions.size() >= m_max)
+            {
+                free(m_sessions.begin()->second);
+                m_sessions.erase(m_sessions.begin());
+            }
+
+            m_sessions.insert(std::pair<std::string, mbedtls_ssl_session *>(key, session));
+        }
+        m_lock.unlock();
+    }
+
+    void remove(const std::string &key)
+    {
+        std::map<std::string, mbedtls_ssl_session *>::iterator it;
+
+        m_lock.lock();
+        it = m_sessions.find(key);
+        if (it != m_sessions.end())
+        {
+            free(it->second);
+            m_sessions.erase(it);
+        }
+        m_lock.unlock();
+    }
+
+private:
+    static void free(mbedtls_ssl_session *session)
+    {
+        mbedtls_ssl_session_free(session);
+        delete session;
+    }
+
+private:
+    exlib::spinlock m_lock;
+    std::map<std::string, mbedtls_ssl_session *> m_sessions;
+    size_t m_max;
+};
+
 class _ssl
 {
 public:
@@ -35,6 +122,8 @@ public:
 
         m_min_version = MBEDTLS_SSL_MINOR_VERSION_0;
         m_max_version = MBEDTLS_SSL_MINOR_VERSION_3;
+
+        m_ticket_lifetime = 86400;
     }
 
     ~_ssl()
@@ -60,6 +149,9 @@ public:
     int32_t m_authmode;
     int32_t m_min_version;
     int32_t m_max_version;
+    int32_t m_ticket_lifetime;
+
+    _session_cache m_sessions;
 
     obj_ptr<X509Cert_base> m_crt;
     obj_ptr<PKey_base> m_key;
@@ -8,6 +8,7 @@
 #include "Runtime.h"
 #include "Fiber.h"
 #include "SandBox.h"
+#include "CpuProfiler.h"
 
 namespace fibjs
 {
@@ -29,7 +30,7 @@ Runtime &Runtime::now()
 
 OSTls th_vm;
 
-Isolate::Isolate() : m_test_setup_bbd(false), m_test_setup_tdd(false)
+Isolate::Isolate() : m_test_setup_bbd(false), m_test_setup_tdd(false), m_profiler(NULL)
 {
 }
 
@@ -55,14 +56,24 @@ inline JSFiber* saveTrace()
     return fiber;
 }
 
+inline JSFiber* leaveJS()
+{
+    JSFiber* fiber = Isolate::rt::g_trace ? saveTrace() : NULL;
+
+    CpuProfiler::leave(fiber);
+    return fiber;
+}
+
 Isolate::rt::rt() :
-    m_fiber(g_trace ? saveTrace() : NULL),
+    m_fiber(leaveJS()),
     unlocker(Isolate::now()->m_isolate)
 {
 }
 
 Isolate::rt::~rt()
 {
+    CpuProfiler::enter(m_fiber);
+
     if (m_fiber)
         m_fiber->m_traceInfo.resize(0);
 }
@@ -11,6 +11,8 @@ static exlib::Queue<AsyncEvent> s_acPool;
 
 static int32_t s_threads;
 static exlib::atomic s_idleThreads;
+static exlib::atomic s_liveThreads;
+static exlib::atomic s_queued;
 
 class _acThread: public exlib::OSThread
 {
@@ -30,6 +32,8 @@ public:
 
         Runtime::reg(&rt);
 
+        s_liveThreads.inc();
+
         while (1)
         {
             if (s_idleThreads.inc() > s_threads * 3)
@@ -39,19 +43,30 @@ public:
             }
 
             p = s_acPool.get();
+            s_queued.dec();
             if (s_idleThreads.dec() == 0)
                 new _acThread();
 
             p->invoke();
         }
+
+        s_liveThreads.dec();
     }
 };
 
 void AsyncEvent::async()
 {
+    s_queued.inc();
     s_acPool.put(this);
 }
 
+void acpool_status(int32_t &threads, int32_t &idle, int32_t &queued)
+{
+    threads = (int32_t)s_liveThreads;
+    idle = (int32_t)s_idleThreads;
+    queued = (int32_t)s_queued;
+}
+
 void init_acThread()
 {
     int32_t cpus = 0;
@@ -20,6 +20,7 @@ void init_acThread();
 void init_logger();
 void init_net();
 void init_fiber();
+void init_metrics();
 bool options(int32_t* argc, char *argv[]);
 
 class ShellArrayBufferAllocator : public v8::ArrayBuffer::Allocator
@@ -84,6 +85,7 @@ void _main(const char *fname)
     isolate->m_global.Reset(isolate->m_isolate, glob);
 
     init_fiber();
+    init_metrics();
 
     result_t hr;
 
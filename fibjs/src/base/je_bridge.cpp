@@ -465,6 +465,33 @@ void operator delete[] (void* p) throw()
 
 #endif
 
+namespace fibjs
+{
+
+bool malloc_status(size_t &allocated, size_t &active, size_t &mapped)
+{
+	uint64_t epoch = 1;
+	size_t sz = sizeof(epoch);
+
+	je_mallctl("epoch", &epoch, &sz, &epoch, sz);
+
+	sz = sizeof(size_t);
+	if (je_mallctl("stats.allocated", &allocated, &sz, NULL, 0))
+		return false;
+
+	sz = sizeof(size_t);
+	if (je_mallctl("stats.active", &active, &sz, NULL, 0))
+		return false;
+
+	sz = sizeof(size_t);
+	if (je_mallctl("stats.mapped", &mapped, &sz, NULL, 0))
+		return false;
+
+	return true;
+}
+
+}
+
 #else
 
 namespace fibjs
@@ -474,6 +501,11 @@ void dump_memory(int32_t serial)
 {
 }
 
+bool malloc_status(size_t &allocated, size_t &active, size_t &mapped)
+{
+	return false;
+}
+
 }
 
 #endif
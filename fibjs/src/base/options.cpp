@@ -7,6 +7,7 @@
 
 #include "console.h"
 #include "Fiber.h"
+#include "CodeCache.h"
 
 namespace fibjs
 {
@@ -26,6 +27,8 @@ static void printHelp() {
 	       "  --trace_fiber        allow user to query the non-current\n"
 	       "                       fiber's stack infomation\n"
 	       "  --preemptive         activate the preemptive mode\n"
+	       "  --code_cache=dir     save compiled scripts in dir to speed up\n"
+	       "                       the next start\n"
 	       "  --help               print fibjs command line options\n"
 	       "  --v8-options         print v8 command line options\n"
 	       "\n"
@@ -57,6 +60,9 @@ bool options(int32_t* argc, char *argv[])
 		} else if (!qstrcmp(arg, "--preemptive")) {
 			df ++;
 			g_preemptive = true;
+		} else if (!qstrcmp(arg, "--code_cache=", 13)) {
+			df ++;
+			CodeCache::s_dir = arg + 13;
 		} else if (!qstrcmp(arg, "--help")) {
 			printHelp();
 			return true;
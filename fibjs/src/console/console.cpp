@@ -12,39 +12,12 @@
 #include "ifs/util.h"
 #include <map>
 #include "console.h"
+#include "Ticks.h"
 #include <stdlib.h>
 
-#ifdef _WIN32
-#include <windows.h>
-
-static LARGE_INTEGER systemFrequency;
-
-inline int64_t Ticks()
-{
-    LARGE_INTEGER t;
-
-    if (systemFrequency.QuadPart == 0)
-        QueryPerformanceFrequency(&systemFrequency);
-
-    QueryPerformanceCounter(&t);
-
-    return t.QuadPart * 1000000 / systemFrequency.QuadPart;
-}
-
-#else
+#ifndef _WIN32
 #include <dlfcn.h>
-#include <sys/time.h>
-
 #include "utils.h" // for ARRAYSIZE()
-
-inline int64_t Ticks()
-{
-    struct timeval tv;
-    if (gettimeofday(&tv, NULL) < 0)
-        return 0;
-    return (tv.tv_sec * 1000000ll) + tv.tv_usec;
-}
-
 #endif
 
 namespace fibjs
@@ -175,14 +148,14 @@ result_t console_base::time(const char *label)
 
 result_t console_base::timeEnd(const char *label)
 {
-    long t = (long) (Ticks() - s_timers[label]);
+    int64_t t = Ticks() - s_timers[label];
 
     s_timers.erase(label);
 
     std::string strBuffer;
     char numStr[64];
 
-    sprintf(numStr, "%.10g", t / 1000.0);
+    sprintf(numStr, "%.10g", t / 1000000.0);
 
     strBuffer.append(label);
     strBuffer.append(": ", 2);
@@ -201,32 +201,30 @@ result_t file_logger::initFile()
 
 result_t file_logger::write(AsyncEvent *ac)
 {
+    std::string &outBuffer = m_buffer;
     item *p1;
 
-    while (!m_workinglogs.empty())
+    while (true)
     {
-        std::string outBuffer;
         result_t hr;
 
         hr = initFile();
         if (hr < 0)
         {
-            while ((p1 = m_workinglogs.getHead()) != 0)
-                delete p1;
-
+            discard();
             break;
         }
 
-        while ((p1 = m_workinglogs.getHead()) != 0)
+        outBuffer.resize(0);
+
+        while ((p1 = next()) != 0)
         {
             if (p1->m_priority != console_base::_PRINT)
             {
-                outBuffer.append(p1->full());
+                format(p1, outBuffer);
                 outBuffer.append("\n", 1);
             }
 
-            delete p1;
-
             if (outBuffer.length() > STREAM_BUFF_SIZE)
                 break;
 
@@ -234,6 +232,14 @@ result_t file_logger::write(AsyncEvent *ac)
                 break;
         }
 
+        if (outBuffer.empty())
+        {
+            if (p1 == 0)
+                break;
+
+            continue;
+        }
+
         if (m_file)
         {
             hr = m_file->Write(outBuffer.c_str(), (int32_t)outBuffer.length());
@@ -244,6 +250,9 @@ result_t file_logger::write(AsyncEvent *ac)
             if (m_split_size && m_size >= m_split_size)
                 m_file.Release();
         }
+
+        if (p1 == 0)
+            break;
     }
 
     return 0;
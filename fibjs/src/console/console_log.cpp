@@ -6,6 +6,7 @@
  */
 
 #include "console.h"
+#include "Fiber.h"
 
 namespace fibjs
 {
@@ -22,6 +23,16 @@ void init_logger()
     s_std = new std_logger;
 }
 
+void logger::wait()
+{
+    if (!exlib::Service::hasService())
+        exlib::OSThread::sleep(1);
+    else if (JSFiber::current())
+        coroutine_base::sleep(1);
+    else
+        exlib::Fiber::sleep(1);
+}
+
 void asyncLog(int32_t priority, std::string msg)
 {
     if (priority <= s_loglevel)
@@ -176,27 +176,49 @@ void std_logger::out(const char *txt)
 
 result_t std_logger::write(AsyncEvent *ac)
 {
+    std::string &outBuffer = m_buffer;
     item *p1;
 
-    while ((p1 = m_workinglogs.getHead()) != 0)
+    outBuffer.resize(0);
+
+    while ((p1 = next()) != 0)
     {
-        std::string txt;
         if (p1->m_priority == console_base::_NOTICE)
-            txt = logger::notice() + p1->m_msg + COLOR_RESET + "\n";
+        {
+            outBuffer.append(logger::notice());
+            outBuffer.append(p1->m_msg);
+            outBuffer.append(COLOR_RESET "\n");
+        }
         else if (p1->m_priority == console_base::_WARN)
-            txt = logger::warn() + p1->m_msg + COLOR_RESET + "\n";
+        {
+            outBuffer.append(logger::warn());
+            outBuffer.append(p1->m_msg);
+            outBuffer.append(COLOR_RESET "\n");
+        }
         else if (p1->m_priority <= console_base::_ERROR)
-            txt = logger::error() + p1->m_msg + COLOR_RESET + "\n";
+        {
+            outBuffer.append(logger::error());
+            outBuffer.append(p1->m_msg);
+            outBuffer.append(COLOR_RESET "\n");
+        }
         else if (p1->m_priority == console_base::_PRINT)
-            txt = p1->m_msg;
+            outBuffer.append(p1->m_msg);
         else
-            txt = p1->m_msg + "\n";
-
-        out(txt.c_str());
+        {
+            outBuffer.append(p1->m_msg);
+            outBuffer.append("\n", 1);
+        }
 
-        delete p1;
+        if (outBuffer.length() > STREAM_BUFF_SIZE)
+        {
+            out(outBuffer.c_str());
+            outBuffer.resize(0);
+        }
     }
 
+    if (!outBuffer.empty())
+        out(outBuffer.c_str());
+
     return 0;
 }
 
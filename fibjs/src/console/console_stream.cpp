@@ -17,8 +17,8 @@ result_t stream_logger::write(AsyncEvent *ac)
 	class asyncWrite: public AsyncState
 	{
 	public:
-		asyncWrite(Stream_base* out, exlib::List<item>& logs, AsyncEvent *ac) :
-			AsyncState(ac), m_out(out), m_logs(logs)
+		asyncWrite(stream_logger* pThis, AsyncEvent *ac) :
+			AsyncState(ac), m_pThis(pThis)
 		{
 			set(write);
 		}
@@ -27,27 +27,38 @@ result_t stream_logger::write(AsyncEvent *ac)
 		static int32_t write(AsyncState *pState, int32_t n)
 		{
 			asyncWrite *pThis = (asyncWrite *) pState;
-			std::string outBuffer;
+			std::string &outBuffer = pThis->m_pThis->m_buffer;
 			item *p1;
 
-			while ((p1 = pThis->m_logs.getHead()) != 0)
-			{
-				std::string txt;
+			outBuffer.resize(0);
 
+			while ((p1 = pThis->m_pThis->next()) != 0)
+			{
 				if (p1->m_priority == console_base::_NOTICE)
-					txt = logger::notice() + p1->m_msg + COLOR_RESET + "\n";
+				{
+					outBuffer.append(logger::notice());
+					outBuffer.append(p1->m_msg);
+					outBuffer.append(COLOR_RESET "\n");
+				}
 				else if (p1->m_priority == console_base::_WARN)
-					txt = logger::warn() + p1->m_msg + COLOR_RESET + "\n";
+				{
+					outBuffer.append(logger::warn());
+					outBuffer.append(p1->m_msg);
+					outBuffer.append(COLOR_RESET "\n");
+				}
 				else if (p1->m_priority <= console_base::_ERROR)
-					txt = logger::error() + p1->m_msg + COLOR_RESET + "\n";
+				{
+					outBuffer.append(logger::error());
+					outBuffer.append(p1->m_msg);
+					outBuffer.append(COLOR_RESET "\n");
+				}
 				else if (p1->m_priority == console_base::_PRINT)
-					txt = p1->m_msg;
+					outBuffer.append(p1->m_msg);
 				else
-					txt = p1->m_msg + "\n";
-
-				outBuffer.append(txt);
-
-				delete p1;
+				{
+					outBuffer.append(p1->m_msg);
+					outBuffer.append("\n", 1);
+				}
 
 				if (outBuffer.length() > STREAM_BUFF_SIZE)
 					break;
@@ -58,26 +69,21 @@ result_t stream_logger::write(AsyncEvent *ac)
 
 			pThis->m_buffer = new Buffer(outBuffer);
 
-			return pThis->m_out->write(pThis->m_buffer, pThis);
+			return pThis->m_pThis->m_out->write(pThis->m_buffer, pThis);
 		}
 
 		virtual int32_t error(int32_t v)
 		{
-			item *p1;
-
-			while ((p1 = m_logs.getHead()) != 0)
-				delete p1;
-
+			m_pThis->discard();
 			return v;
 		}
 
 	private:
-		obj_ptr<Stream_base> m_out;
-		exlib::List<item>& m_logs;
+		stream_logger* m_pThis;
 		obj_ptr<Buffer_base> m_buffer;
 	};
 
-	return (new asyncWrite(m_out, m_workinglogs, ac))->post(0);
+	return (new asyncWrite(this, ac))->post(0);
 }
 
 }
@@ -18,12 +18,14 @@ result_t sys_logger::write(AsyncEvent *ac)
 {
 	item *p1;
 
-	while ((p1 = m_workinglogs.getHead()) != 0)
+	while ((p1 = next()) != 0)
 	{
 		if (p1->m_priority != console_base::_PRINT)
-			::syslog(p1->m_priority, "%s", p1->full(false).c_str());
-
-		delete p1;
+		{
+			m_buffer.resize(0);
+			format(p1, m_buffer, false);
+			::syslog(p1->m_priority, "%s", m_buffer.c_str());
+		}
 	}
 
 	return 0;
@@ -0,0 +1,236 @@
+/*
+ * Channel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "Channel.h"
+#include "Buffer.h"
+#include "encoding_bson.h"
+
+namespace fibjs
+{
+
+result_t Channel_base::_new(int32_t size, obj_ptr<Channel_base> &retVal,
+                            v8::Local<v8::Object> This)
+{
+    if (size < 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    retVal = new Channel(size);
+    return 0;
+}
+
+result_t Channel::pack(v8::Local<v8::Value> v, message &m)
+{
+    obj_ptr<Buffer_base> buf = Buffer_base::getInstance(v);
+
+    if (buf)
+    {
+        ((Buffer *)(Buffer_base *)buf)->detach(m.m_data);
+        m.m_buffer = true;
+        return 0;
+    }
+
+    bson bb;
+
+    bson_init(&bb);
+    encodeValue(&bb, "v", v);
+    bson_finish(&bb);
+
+    m.m_data.assign(bson_data(&bb), bson_size(&bb));
+    m.m_buffer = false;
+
+    bson_destroy(&bb);
+
+    return 0;
+}
+
+void Channel::unpack(message &m, v8::Local<v8::Value> &retVal)
+{
+    if (m.m_buffer)
+    {
+        obj_ptr<Buffer> buf = new Buffer();
+
+        buf->attach(m.m_data);
+        retVal = buf->wrap();
+        return;
+    }
+
+    v8::Local<v8::Object> o = decodeObject(m.m_data.c_str());
+    retVal = o->Get(v8::String::NewFromUtf8(Isolate::now()->m_isolate, "v"));
+}
+
+bool Channel::push(message &m)
+{
+    m_lock.lock();
+
+    if (m_closed)
+    {
+        m_lock.unlock();
+        return false;
+    }
+
+    m_list.push_back(message());
+    m_list.back().m_buffer = m.m_buffer;
+    m_list.back().m_data.swap(m.m_data);
+
+    m_lock.unlock();
+
+    m_semTake.post();
+    return true;
+}
+
+bool Channel::pop(message &m)
+{
+    m_lock.lock();
+
+    if (m_list.empty())
+    {
+        m_lock.unlock();
+        return false;
+    }
+
+    m.m_buffer = m_list.front().m_buffer;
+    m.m_data.swap(m_list.front().m_data);
+    m_list.pop_front();
+
+    m_lock.unlock();
+
+    return true;
+}
+
+void Channel::wait(exlib::Semaphore &sem)
+{
+    if (sem.trywait())
+        return;
+
+    Isolate::rt _rt;
+    sem.wait();
+}
+
+result_t Channel::put(v8::Local<v8::Value> v)
+{
+    bool bPut;
+    result_t hr;
+
+    if (m_closed)
+        return CHECK_ERROR(Runtime::setError("Channel: channel is closed."));
+
+    hr = tryPut(v, bPut);
+    if (hr < 0 || bPut)
+        return hr;
+
+    wait(m_semPut);
+
+    if (m_closed)
+    {
+        m_semPut.post();
+        return CHECK_ERROR(Runtime::setError("Channel: channel is closed."));
+    }
+
+    message m;
+
+    hr = pack(v, m);
+    if (hr < 0)
+    {
+        m_semPut.post();
+        return hr;
+    }
+
+    if (!push(m))
+    {
+        if (m.m_buffer)
+            ((Buffer *)Buffer_base::getInstance(v))->attach(m.m_data);
+
+        m_semPut.post();
+        return CHECK_ERROR(Runtime::setError("Channel: channel is closed."));
+    }
+
+    return 0;
+}
+
+result_t Channel::take(v8::Local<v8::Value> &retVal)
+{
+    message m;
+
+    wait(m_semTake);
+
+    if (!pop(m))
+    {
+        // closed and drained, pass the wakeup on to the next waiting fiber
+        m_semTake.post();
+        return CALL_RETURN_NULL;
+    }
+
+    m_semPut.post();
+    unpack(m, retVal);
+
+    return 0;
+}
+
+result_t Channel::tryPut(v8::Local<v8::Value> v, bool &retVal)
+{
+    retVal = false;
+    if (m_closed || !m_semPut.trywait())
+        return 0;
+
+    message m;
+    result_t hr;
+
+    hr = pack(v, m);
+    if (hr < 0)
+    {
+        m_semPut.post();
+        return hr;
+    }
+
+    if (!push(m))
+    {
+        if (m.m_buffer)
+            ((Buffer *)Buffer_base::getInstance(v))->attach(m.m_data);
+
+        m_semPut.post();
+        return 0;
+    }
+
+    retVal = true;
+    return 0;
+}
+
+result_t Channel::close()
+{
+    m_lock.lock();
+
+    if (m_closed)
+    {
+        m_lock.unlock();
+        return 0;
+    }
+
+    m_closed = true;
+    m_lock.unlock();
+
+    m_semTake.post();
+    m_semPut.post();
+
+    return 0;
+}
+
+result_t Channel::get_length(int32_t &retVal)
+{
+    m_lock.lock();
+    retVal = (int32_t)m_list.size();
+    m_lock.unlock();
+
+    return 0;
+}
+
+result_t Channel::get_closed(bool &retVal)
+{
+    retVal = m_closed;
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -7,6 +7,15 @@
 
 #include "Fiber.h"
 #include "ifs/os.h"
+#include "CpuProfiler.h"
+#include "Stats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
 
 namespace fibjs
 {
@@ -14,14 +23,54 @@ namespace fibjs
 extern int32_t stack_size;
 extern bool g_preemptive;
 
+#ifdef x64
+#define MAX_FIBER   100000
+#else
 #define MAX_FIBER   10000
+#endif
 #define MAX_IDLE   256
+#define STACK_MARGIN    (16 * 1024)
+
+class fiber_pool
+{
+public:
+    exlib::Queue<AsyncEvent> m_jobs;
+    int32_t m_stack;
+    int32_t m_idle;
+};
+
+enum
+{
+    POOL_NORMAL = 0,
+    POOL_HANDLER,
+    POOL_COUNT
+};
 
-static exlib::Queue<AsyncEvent> g_jobs;
+enum
+{
+    FIBER_FIBERS = 0,
+    FIBER_IDLE,
+    FIBER_MAX,
+    FIBER_CREATED,
+    FIBER_REUSED,
+    FIBER_RELEASED,
+    FIBER_TASKS,
+    FIBER_ERRORS
+};
+
+enum
+{
+    FIBER_TASK = 0
+};
+
+static fiber_pool s_pools[POOL_COUNT];
 static exlib::IDLE_PROC s_oldIdle;
 static int32_t s_fibers;
-static int32_t s_idleFibers;
+static int32_t s_maxFibers;
+static intptr_t s_pageSize;
+static Stats *s_stats;
 int32_t g_spareFibers;
+int32_t g_handlerStack;
 
 static int32_t g_tlsCurrent;
 DateCache FiberBase::g_dc;
@@ -51,20 +100,84 @@ public:
 
 } *s_null;
 
+static int32_t pool_stack(fiber_pool &pool)
+{
+    if (&pool == &s_pools[POOL_HANDLER] && g_handlerStack)
+        return g_handlerStack;
+    return stack_size;
+}
+
 static void onIdle()
 {
-    if (!g_jobs.empty() && (s_idleFibers == 0) &&  (s_fibers < MAX_FIBER))
+    for (int32_t i = 0; i < POOL_COUNT; i ++)
     {
-        s_fibers++;
-        s_idleFibers ++;
-        exlib::Fiber::Create(FiberBase::fiber_proc, NULL,
-                             stack_size * 1024);
+        fiber_pool &pool = s_pools[i];
+
+        if (!pool.m_jobs.empty() && (pool.m_idle == 0) && (s_fibers < MAX_FIBER))
+        {
+            s_fibers ++;
+            pool.m_idle ++;
+            pool.m_stack = pool_stack(pool);
+
+            s_stats->inc(FIBER_FIBERS);
+            s_stats->inc(FIBER_IDLE);
+            s_stats->inc(FIBER_CREATED);
+            if (s_fibers > s_maxFibers)
+            {
+                s_maxFibers = s_fibers;
+                s_stats->inc(FIBER_MAX);
+            }
+
+            exlib::Fiber::Create(FiberBase::fiber_proc, &pool,
+                                 pool.m_stack * 1024);
+        }
     }
 
     if (s_oldIdle)
         s_oldIdle();
 }
 
+static void release_stack(intptr_t top, int32_t size)
+{
+    intptr_t sp = (intptr_t)&sp;
+    intptr_t lo = (top - size * 1024 + STACK_MARGIN + s_pageSize - 1) & ~(s_pageSize - 1);
+    intptr_t hi = (sp - STACK_MARGIN) & ~(s_pageSize - 1);
+
+    if (hi <= lo)
+        return;
+
+#ifdef _WIN32
+    VirtualAlloc((void *)lo, hi - lo, MEM_RESET, PAGE_READWRITE);
+#else
+    madvise((void *)lo, hi - lo, MADV_DONTNEED);
+#endif
+
+    s_stats->inc(FIBER_RELEASED);
+}
+
+void fiber_status(int32_t &fibers, int32_t &idle)
+{
+    fibers = s_fibers;
+    idle = 0;
+
+    for (int32_t i = 0; i < POOL_COUNT; i ++)
+        idle += s_pools[i].m_idle;
+}
+
+void fiber_task(int64_t us, bool bError)
+{
+    s_stats->inc(FIBER_TASKS);
+    if (bError)
+        s_stats->inc(FIBER_ERRORS);
+    s_stats->record(FIBER_TASK, us);
+}
+
+result_t fiber_stats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = s_stats;
+    return 0;
+}
+
 extern exlib::LockedList<Isolate> s_isolates;
 class _preemptThread: public exlib::OSThread
 {
@@ -111,11 +224,33 @@ private:
 
 void init_fiber()
 {
+    static const char *s_staticCounter[] =
+    { "fibers", "idle", "max" };
+    static const char *s_Counter[] =
+    { "created", "reused", "released", "tasks", "errors" };
+    static const char *s_Histogram[] =
+    { "task" };
+
     g_spareFibers = MAX_IDLE;
     s_null = new null_fiber_data();
 
     s_fibers = 0;
-    s_idleFibers = 0;
+    s_maxFibers = 0;
+
+#ifdef _WIN32
+    SYSTEM_INFO si;
+
+    GetSystemInfo(&si);
+    s_pageSize = si.dwPageSize;
+#else
+    s_pageSize = sysconf(_SC_PAGESIZE);
+#endif
+
+    s_stats = new Stats();
+    s_stats->Ref();
+    s_stats->init(s_staticCounter, 3, s_Counter, 5);
+    s_stats->init_histograms(s_Histogram, 1);
+    s_stats->set_name("fiber");
 
     g_tlsCurrent = exlib::Fiber::tlsAlloc();
     s_oldIdle = exlib::Service::current()->onIdle(onIdle);
@@ -126,33 +261,47 @@ void init_fiber()
 
 void *FiberBase::fiber_proc(void *p)
 {
+    fiber_pool &pool = *(fiber_pool *)p;
+    int32_t size = pool.m_stack;
+    intptr_t top = (intptr_t)&size;
+
     Isolate* isolate = Isolate::now();
     v8::Locker locker(isolate->m_isolate);
     v8::Isolate::Scope isolate_scope(isolate->m_isolate);
 
+    if (size != stack_size)
+        isolate->m_isolate->SetStackLimit(top - (size - 16) * 1024);
+
     v8::HandleScope handle_scope(isolate->m_isolate);
     v8::Context::Scope context_scope(
         v8::Local<v8::Context>::New(isolate->m_isolate, isolate->m_context));
 
-    s_idleFibers --;
+    pool.m_idle --;
+    s_stats->dec(FIBER_IDLE);
     while (1)
     {
         AsyncEvent *ae;
 
-        if ((ae = g_jobs.tryget()) == NULL)
+        if ((ae = pool.m_jobs.tryget()) == NULL)
         {
-            s_idleFibers ++;
-            if (s_idleFibers > g_spareFibers) {
-                s_idleFibers --;
+            pool.m_idle ++;
+            if (pool.m_idle > g_spareFibers || size != pool_stack(pool)) {
+                pool.m_idle --;
                 break;
             }
 
+            s_stats->inc(FIBER_IDLE);
+
             {
                 v8::Unlocker unlocker(isolate->m_isolate);
-                ae = g_jobs.get();
+
+                release_stack(top, size);
+                ae = pool.m_jobs.get();
             }
 
-            s_idleFibers --;
+            pool.m_idle --;
+            s_stats->dec(FIBER_IDLE);
+            s_stats->inc(FIBER_REUSED);
         }
 
         {
@@ -162,6 +311,7 @@ void *FiberBase::fiber_proc(void *p)
     }
 
     s_fibers --;
+    s_stats->dec(FIBER_FIBERS);
 
     return NULL;
 }
@@ -191,7 +341,7 @@ void FiberBase::set_caller(Fiber_base* caller)
 void FiberBase::start()
 {
     set_caller(JSFiber::current());
-    g_jobs.put(this);
+    s_pools[POOL_NORMAL].m_jobs.put(this);
     Ref();
 }
 
@@ -262,6 +412,8 @@ JSFiber::scope::scope(JSFiber *fb) :
 
     exlib::Fiber::tlsPut(g_tlsCurrent, m_pFiber);
     Isolate::now()->m_fibers.putTail(m_pFiber);
+
+    CpuProfiler::enter(m_pFiber);
 }
 
 JSFiber::scope::~scope()
@@ -275,13 +427,17 @@ JSFiber::scope::~scope()
     o->SetAlignedPointerInInternalField(0, s_null);
 
     ReportException(try_catch, m_hr);
+    CpuProfiler::leave(m_pFiber, true);
     Isolate::now()->m_fibers.remove(m_pFiber);
     exlib::Fiber::tlsPut(g_tlsCurrent, 0);
 }
 
 void AsyncEvent::sync()
 {
-    g_jobs.put(this);
+    if (g_handlerStack)
+        s_pools[POOL_HANDLER].m_jobs.put(this);
+    else
+        s_pools[POOL_NORMAL].m_jobs.put(this);
 }
 
 } /* namespace fibjs */
@@ -15,6 +15,11 @@ namespace fibjs
 {
 
 extern int32_t g_spareFibers;
+extern int32_t g_handlerStack;
+extern int32_t stack_size;
+
+result_t fiber_stats(obj_ptr<Stats_base> &retVal);
+void fiber_task(int64_t us, bool bError);
 
 result_t coroutine_base::start(v8::Local<v8::Function> func,
                                const v8::FunctionCallbackInfo<v8::Value> &args, obj_ptr<Fiber_base> &retVal)
@@ -35,10 +40,12 @@ private:
             JSFiber::scope s;
             v8::Local<v8::Value> v;
             int32_t pos = m_pos;
+            date_t d1, d2;
 
             s->set_caller(m_caller);
 
             m_pos ++;
+            d1.now();
             if (func.IsEmpty())
                 v = v8::Local<v8::Function>::Cast(datas->Get(pos))
                     ->Call(s->wrap(), 0, NULL);
@@ -48,6 +55,9 @@ private:
                 v = func->Call(s->wrap(), 1, &a);
             }
 
+            d2.now();
+            fiber_task((int64_t)(d2.diff(d1) * 1000), v.IsEmpty());
+
             if (!v.IsEmpty())
                 retVal->Set(pos, v);
             else
@@ -228,4 +238,24 @@ result_t coroutine_base::set_spareFibers(int32_t newVal)
     return 0;
 }
 
+result_t coroutine_base::get_handlerStackSize(int32_t& retVal)
+{
+    retVal = g_handlerStack;
+    return 0;
+}
+
+result_t coroutine_base::set_handlerStackSize(int32_t newVal)
+{
+    if (newVal != 0 && (newVal < 64 || newVal > stack_size))
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    g_handlerStack = newVal;
+    return 0;
+}
+
+result_t coroutine_base::get_stats(obj_ptr<Stats_base>& retVal)
+{
+    return fiber_stats(retVal);
+}
+
 }
@@ -0,0 +1,401 @@
+/*
+ * Aead.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/crypto.h"
+#include "Aead.h"
+#include "Buffer.h"
+#include "ssl.h"
+#include <string.h>
+
+namespace fibjs
+{
+
+#define AEAD_TAG_SIZE   16
+#define AEAD_IV_SIZE    12
+#define AEAD_BLOCK_SIZE 16
+#define AEAD_SYNC_SIZE  16384
+
+static struct _aead_algo
+{
+    const char *name;
+    size_t size;
+} s_algos[] =
+{
+    { "aes-128-gcm", 16 },
+    { "aes-192-gcm", 24 },
+    { "aes-256-gcm", 32 }
+};
+
+result_t crypto_base::aead(const char *algo, Buffer_base *key,
+                           obj_ptr<Aead_base> &retVal)
+{
+    std::string strKey;
+    int32_t i;
+
+    for (i = 0; i < (int32_t)(sizeof(s_algos) / sizeof(s_algos[0])); i ++)
+        if (!qstricmp(algo, s_algos[i].name))
+            break;
+
+    if (i == (int32_t)(sizeof(s_algos) / sizeof(s_algos[0])))
+        return CHECK_ERROR(Runtime::setError("Aead: Invalid algorithm"));
+
+    key->toString(strKey);
+    if (strKey.length() != s_algos[i].size)
+        return CHECK_ERROR(Runtime::setError("Aead: Invalid key size"));
+
+    retVal = new Aead(s_algos[i].name, strKey);
+    memset(&strKey[0], 0, strKey.length());
+
+    return 0;
+}
+
+Aead::Aead(const char *name, std::string &key) : m_name(name), m_key(key)
+{
+    put(get());
+}
+
+Aead::~Aead()
+{
+    size_t i;
+
+    for (i = 0; i < m_ctxs.size(); i ++)
+    {
+        mbedtls_gcm_free(m_ctxs[i]);
+        delete m_ctxs[i];
+    }
+
+    memset(&m_key[0], 0, m_key.length());
+}
+
+mbedtls_gcm_context *Aead::get()
+{
+    mbedtls_gcm_context *ctx = NULL;
+
+    m_lock.lock();
+    if (!m_ctxs.empty())
+    {
+        ctx = m_ctxs.back();
+        m_ctxs.pop_back();
+    }
+    m_lock.unlock();
+
+    if (!ctx)
+    {
+        ctx = new mbedtls_gcm_context;
+        mbedtls_gcm_init(ctx);
+        mbedtls_gcm_setkey(ctx, MBEDTLS_CIPHER_ID_AES,
+                           (const unsigned char *)m_key.c_str(),
+                           (uint32_t)m_key.length() * 8);
+    }
+
+    return ctx;
+}
+
+void Aead::put(mbedtls_gcm_context *ctx)
+{
+    m_lock.lock();
+    m_ctxs.push_back(ctx);
+    m_lock.unlock();
+}
+
+result_t Aead::get_name(std::string &retVal)
+{
+    retVal = m_name;
+    return 0;
+}
+
+result_t Aead::get_keySize(int32_t &retVal)
+{
+    retVal = (int32_t)m_key.length() * 8;
+    return 0;
+}
+
+result_t Aead::get_ivSize(int32_t &retVal)
+{
+    retVal = AEAD_IV_SIZE;
+    return 0;
+}
+
+result_t Aead::get_tagSize(int32_t &retVal)
+{
+    retVal = AEAD_TAG_SIZE;
+    return 0;
+}
+
+result_t Aead::process(int32_t mode, Buffer_base *iv, Buffer_base *data,
+                       Buffer_base *aad, obj_ptr<Buffer_base> &retVal,
+                       AsyncEvent *ac)
+{
+    const std::string &strIv = ((Buffer *)iv)->data();
+    const std::string &strData = ((Buffer *)data)->data();
+    const char *strAad = NULL;
+    size_t aad_len = 0;
+
+    if (!ac && strData.length() > AEAD_SYNC_SIZE)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    if (strIv.empty())
+        return CHECK_ERROR(Runtime::setError("Aead: Invalid iv size"));
+
+    if (aad)
+    {
+        const std::string &s = ((Buffer *)aad)->data();
+
+        strAad = s.c_str();
+        aad_len = s.length();
+    }
+
+    mbedtls_gcm_context *ctx = get();
+    std::string output;
+    int32_t ret;
+
+    if (mode == MBEDTLS_GCM_ENCRYPT)
+    {
+        size_t sz = strData.length();
+
+        output.resize(sz + AEAD_TAG_SIZE);
+        ret = mbedtls_gcm_crypt_and_tag(ctx, MBEDTLS_GCM_ENCRYPT, sz,
+                                        (const unsigned char *)strIv.c_str(), strIv.length(),
+                                        (const unsigned char *)strAad, aad_len,
+                                        (const unsigned char *)strData.c_str(),
+                                        (unsigned char *)&output[0],
+                                        AEAD_TAG_SIZE, (unsigned char *)&output[sz]);
+    }
+    else
+    {
+        if (strData.length() < AEAD_TAG_SIZE)
+        {
+            put(ctx);
+            return CHECK_ERROR(Runtime::setError("Aead: Invalid data size"));
+        }
+
+        size_t sz = strData.length() - AEAD_TAG_SIZE;
+
+        output.resize(sz);
+        ret = mbedtls_gcm_auth_decrypt(ctx, sz,
+                                       (const unsigned char *)strIv.c_str(), strIv.length(),
+                                       (const unsigned char *)strAad, aad_len,
+                                       (const unsigned char *)strData.c_str() + sz, AEAD_TAG_SIZE,
+                                       (const unsigned char *)strData.c_str(),
+                                       sz ? (unsigned char *)&output[0] : NULL);
+    }
+
+    put(ctx);
+
+    if (ret != 0)
+        return CHECK_ERROR(_ssl::setError(ret));
+
+    obj_ptr<Buffer> buf = new Buffer();
+
+    buf->attach(output);
+    retVal = buf;
+
+    return 0;
+}
+
+result_t Aead::encrypt(Buffer_base *iv, Buffer_base *data,
+                       obj_ptr<Buffer_base> &retVal, AsyncEvent *ac)
+{
+    return process(MBEDTLS_GCM_ENCRYPT, iv, data, NULL, retVal, ac);
+}
+
+result_t Aead::encrypt(Buffer_base *iv, Buffer_base *data, Buffer_base *aad,
+                       obj_ptr<Buffer_base> &retVal, AsyncEvent *ac)
+{
+    return process(MBEDTLS_GCM_ENCRYPT, iv, data, aad, retVal, ac);
+}
+
+result_t Aead::decrypt(Buffer_base *iv, Buffer_base *data,
+                       obj_ptr<Buffer_base> &retVal, AsyncEvent *ac)
+{
+    return process(MBEDTLS_GCM_DECRYPT, iv, data, NULL, retVal, ac);
+}
+
+result_t Aead::decrypt(Buffer_base *iv, Buffer_base *data, Buffer_base *aad,
+                       obj_ptr<Buffer_base> &retVal, AsyncEvent *ac)
+{
+    return process(MBEDTLS_GCM_DECRYPT, iv, data, aad, retVal, ac);
+}
+
+class asyncAead: public AsyncState
+{
+public:
+    asyncAead(Aead *pThis, int32_t mode, Stream_base *src, Stream_base *stm,
+              AsyncEvent *ac) :
+        AsyncState(ac), m_pThis(pThis), m_mode(mode), m_src(src), m_stm(stm)
+    {
+        m_ctx = m_pThis->get();
+        set(read);
+    }
+
+    ~asyncAead()
+    {
+        m_pThis->put(m_ctx);
+    }
+
+public:
+    result_t start(Buffer_base *iv)
+    {
+        const std::string &strIv = ((Buffer *)iv)->data();
+        int32_t ret;
+
+        if (strIv.empty())
+            return CHECK_ERROR(Runtime::setError("Aead: Invalid iv size"));
+
+        ret = mbedtls_gcm_starts(m_ctx, m_mode,
+                                 (const unsigned char *)strIv.c_str(), strIv.length(),
+                                 NULL, 0);
+        if (ret != 0)
+            return CHECK_ERROR(_ssl::setError(ret));
+
+        return 0;
+    }
+
+    static int32_t read(AsyncState *pState, int32_t n)
+    {
+        asyncAead *pThis = (asyncAead *) pState;
+
+        pThis->set(read_ok);
+        return pThis->m_src->read(-1, pThis->m_buffer, pThis);
+    }
+
+    static int32_t read_ok(AsyncState *pState, int32_t n)
+    {
+        asyncAead *pThis = (asyncAead *) pState;
+        std::string &strTail = pThis->m_tail;
+        std::string strBuf;
+        size_t sz;
+        int32_t ret;
+
+        if (n == CALL_RETURN_NULL)
+        {
+            unsigned char tag[AEAD_TAG_SIZE];
+
+            sz = strTail.length();
+            if (pThis->m_mode == MBEDTLS_GCM_DECRYPT)
+            {
+                if (sz < AEAD_TAG_SIZE)
+                    return CHECK_ERROR(Runtime::setError("Aead: Invalid data size"));
+                sz -= AEAD_TAG_SIZE;
+            }
+
+            strBuf.resize(sz + AEAD_TAG_SIZE);
+            ret = mbedtls_gcm_update(pThis->m_ctx, sz,
+                                     (const unsigned char *)strTail.c_str(),
+                                     (unsigned char *)&strBuf[0]);
+            if (ret == 0)
+                ret = mbedtls_gcm_finish(pThis->m_ctx, tag, AEAD_TAG_SIZE);
+            if (ret != 0)
+                return CHECK_ERROR(_ssl::setError(ret));
+
+            if (pThis->m_mode == MBEDTLS_GCM_DECRYPT)
+            {
+                const unsigned char *p = (const unsigned char *)strTail.c_str() + sz;
+                unsigned char diff = 0;
+                int32_t i;
+
+                for (i = 0; i < AEAD_TAG_SIZE; i ++)
+                    diff |= p[i] ^ tag[i];
+
+                if (diff)
+                    return CHECK_ERROR(_ssl::setError(MBEDTLS_ERR_GCM_AUTH_FAILED));
+
+                strBuf.resize(sz);
+            }
+            else
+                memcpy(&strBuf[sz], tag, AEAD_TAG_SIZE);
+
+            strTail.clear();
+            pThis->set(end);
+        }
+        else
+        {
+            strTail.append(((Buffer *)(Buffer_base *)pThis->m_buffer)->data());
+
+            sz = strTail.length();
+            if (pThis->m_mode == MBEDTLS_GCM_DECRYPT)
+                sz = sz > AEAD_TAG_SIZE ? sz - AEAD_TAG_SIZE : 0;
+            sz -= sz % AEAD_BLOCK_SIZE;
+
+            if (sz > 0)
+            {
+                strBuf.resize(sz);
+                ret = mbedtls_gcm_update(pThis->m_ctx, sz,
+                                         (const unsigned char *)strTail.c_str(),
+                                         (unsigned char *)&strBuf[0]);
+                if (ret != 0)
+                    return CHECK_ERROR(_ssl::setError(ret));
+
+                strTail.erase(0, sz);
+            }
+
+            pThis->set(read);
+        }
+
+        if (strBuf.empty())
+            return 0;
+
+        obj_ptr<Buffer> buf = new Buffer();
+
+        buf->attach(strBuf);
+        pThis->m_buffer = buf;
+
+        return pThis->m_stm->write(pThis->m_buffer, pThis);
+    }
+
+    static int32_t end(AsyncState *pState, int32_t n)
+    {
+        return pState->done();
+    }
+
+private:
+    obj_ptr<Aead> m_pThis;
+    int32_t m_mode;
+    mbedtls_gcm_context *m_ctx;
+    obj_ptr<Stream_base> m_src;
+    obj_ptr<Stream_base> m_stm;
+    obj_ptr<Buffer_base> m_buffer;
+    std::string m_tail;
+};
+
+result_t Aead::encryptTo(Buffer_base *iv, Stream_base *src, Stream_base *stm,
+                         AsyncEvent *ac)
+{
+    if (!ac)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    asyncAead *pState = new asyncAead(this, MBEDTLS_GCM_ENCRYPT, src, stm, ac);
+    result_t hr = pState->start(iv);
+
+    if (hr < 0)
+    {
+        delete pState;
+        return hr;
+    }
+
+    return pState->post(0);
+}
+
+result_t Aead::decryptTo(Buffer_base *iv, Stream_base *src, Stream_base *stm,
+                         AsyncEvent *ac)
+{
+    if (!ac)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    asyncAead *pState = new asyncAead(this, MBEDTLS_GCM_DECRYPT, src, stm, ac);
+    result_t hr = pState->start(iv);
+
+    if (hr < 0)
+    {
+        delete pState;
+        return hr;
+    }
+
+    return pState->post(0);
+}
+
+}
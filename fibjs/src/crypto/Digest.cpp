@@ -43,19 +43,40 @@ result_t Digest::update(Buffer_base *data)
     if (m_iAlgo < 0)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
-    std::string str;
-    data->toString(str);
+    const std::string &str = ((Buffer *)data)->data();
 
     if (m_bMac)
         mbedtls_md_hmac_update(&m_ctx, (const unsigned char *) str.c_str(),
-                               (int32_t)str.length());
+                               str.length());
     else
         mbedtls_md_update(&m_ctx, (const unsigned char *) str.c_str(),
-                          (int32_t)str.length());
+                          str.length());
 
     return 0;
 }
 
+result_t Digest::read(int32_t bytes, obj_ptr<Buffer_base> &retVal,
+                      AsyncEvent *ac)
+{
+    return CALL_RETURN_NULL;
+}
+
+result_t Digest::write(Buffer_base *data, AsyncEvent *ac)
+{
+    return update(data);
+}
+
+result_t Digest::close(AsyncEvent *ac)
+{
+    return 0;
+}
+
+result_t Digest::copyTo(Stream_base *stm, int64_t bytes, int64_t &retVal,
+                        AsyncEvent *ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
 result_t Digest::digest(obj_ptr<Buffer_base> &retVal)
 {
     if (m_iAlgo < 0)
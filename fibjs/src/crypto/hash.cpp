@@ -6,7 +6,10 @@
  */
 
 #include "ifs/hash.h"
+#include "ifs/os.h"
 #include "Digest.h"
+#include "Buffer.h"
+#include <vector>
 
 namespace fibjs
 {
@@ -33,6 +36,157 @@ result_t hash_base::digest(int32_t algo, obj_ptr<Digest_base> &retVal)
     return 0;
 }
 
+#define DIGEST_CHUNK_SIZE    65536
+
+class DigestBatch
+{
+public:
+    class Job: public AsyncEvent
+    {
+    public:
+        Job(DigestBatch *batch, size_t pos, size_t end) :
+            m_batch(batch), m_pos(pos), m_end(end)
+        {
+        }
+
+    public:
+        virtual void invoke()
+        {
+            m_batch->run(m_pos, m_end);
+            delete this;
+        }
+
+    private:
+        DigestBatch *m_batch;
+        size_t m_pos;
+        size_t m_end;
+    };
+
+public:
+    DigestBatch(const mbedtls_md_info_t *info) : m_info(info)
+    {
+    }
+
+public:
+    void run(size_t pos, size_t end)
+    {
+        int32_t sz = mbedtls_md_get_size(m_info);
+
+        while (pos < end)
+        {
+            const std::string &str = *m_datas[pos];
+            std::string &strBuf = m_results[pos];
+
+            strBuf.resize(sz);
+            mbedtls_md(m_info, (const unsigned char *)str.c_str(), str.length(),
+                       (unsigned char *)&strBuf[0]);
+            pos ++;
+        }
+
+        if (m_left.dec() == 0)
+            m_done.set();
+    }
+
+    void run()
+    {
+        size_t cnt = m_datas.size();
+        size_t total = 0;
+        size_t i, pos, len;
+        int32_t cpus = 0;
+        std::vector<size_t> jobs;
+
+        m_results.resize(cnt);
+
+        for (i = 0; i < cnt; i ++)
+            total += m_datas[i]->length();
+
+        os_base::CPUs(cpus);
+        if (cpus < 1)
+            cpus = 1;
+
+        len = total / cpus;
+        if (len < DIGEST_CHUNK_SIZE)
+            len = DIGEST_CHUNK_SIZE;
+
+        total = 0;
+        for (i = 0; i < cnt; i ++)
+        {
+            total += m_datas[i]->length();
+            if (total >= len)
+            {
+                jobs.push_back(i + 1);
+                total = 0;
+            }
+        }
+
+        if (jobs.empty() || jobs.back() != cnt)
+            jobs.push_back(cnt);
+
+        for (i = 0; i < jobs.size(); i ++)
+            m_left.inc();
+
+        pos = 0;
+        for (i = 0; i < jobs.size() - 1; i ++)
+        {
+            (new Job(this, pos, jobs[i]))->async();
+            pos = jobs[i];
+        }
+
+        run(pos, cnt);
+
+        // the isolate is kept locked so the buffers can not change under the workers
+        m_done.wait();
+    }
+
+public:
+    const mbedtls_md_info_t *m_info;
+    std::vector<const std::string *> m_datas;
+    std::vector<std::string> m_results;
+
+private:
+    exlib::atomic m_left;
+    exlib::Event m_done;
+};
+
+result_t hash_base::digestMany(int32_t algo, v8::Local<v8::Array> datas,
+                               v8::Local<v8::Array> &retVal)
+{
+    if (algo < hash_base::_MD2 || algo > hash_base::_RIPEMD160)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    DigestBatch batch(mbedtls_md_info_from_type((mbedtls_md_type_t)algo));
+    std::vector<obj_ptr<Buffer_base> > bufs;
+    int32_t sz = datas->Length();
+    int32_t i;
+    result_t hr;
+
+    bufs.resize(sz);
+    batch.m_datas.resize(sz);
+
+    for (i = 0; i < sz; i ++)
+    {
+        hr = GetArgumentValue(datas->Get(i), bufs[i]);
+        if (hr < 0)
+            return CHECK_ERROR(hr);
+
+        batch.m_datas[i] = &((Buffer *)(Buffer_base *)bufs[i])->data();
+    }
+
+    if (sz > 0)
+        batch.run();
+
+    retVal = v8::Array::New(Isolate::now()->m_isolate);
+    for (i = 0; i < sz; i ++)
+    {
+        obj_ptr<Buffer> buf = new Buffer();
+
+        buf->attach(batch.m_results[i]);
+        retVal->Set(i, buf->wrap());
+    }
+
+    return 0;
+}
+
 result_t hash_base::md2(Buffer_base *data, obj_ptr<Digest_base> &retVal)
 {
     return digest(hash_base::_MD2, data, retVal);
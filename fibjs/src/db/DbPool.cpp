@@ -0,0 +1,453 @@
+/*
+ * DbPool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "DbPool.h"
+#include "ifs/db.h"
+#include "ifs/console.h"
+#include "Redis.h"
+
+namespace fibjs
+{
+
+static const char *s_staticCounter[] =
+{ "connections", "inuse" };
+static const char *s_Counter[] =
+{
+    "acquire", "release", "wait", "waitTime", "leaseTime",
+    "timeout", "connect", "close", "error"
+};
+
+enum
+{
+    POOL_CONNECTIONS = 0, POOL_INUSE,
+    POOL_ACQUIRE, POOL_RELEASE, POOL_WAIT, POOL_WAITTIME, POOL_LEASETIME,
+    POOL_TIMEOUT, POOL_CONNECT, POOL_CLOSE, POOL_ERROR
+};
+
+result_t db_base::openPool(const char *connString, v8::Local<v8::Object> opts,
+                           obj_ptr<DbPool_base> &retVal)
+{
+    if (qstrcmp(connString, "mysql:", 6) && qstrcmp(connString, "sqlite:", 7)
+            && qstrcmp(connString, "redis:", 6) && qstrcmp(connString, "mongodb:", 8))
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    obj_ptr<DbPool> pool = new DbPool(connString);
+    result_t hr = pool->setOptions(opts);
+    if (hr < 0)
+        return hr;
+
+    pool->start();
+    retVal = pool;
+
+    return 0;
+}
+
+static result_t _ping(object_base *conn)
+{
+    obj_ptr<DbConnection_base> sql = DbConnection_base::getInstance(conn);
+    if (sql)
+    {
+        obj_ptr<DBResult_base> rs;
+        return sql->ac_execute("SELECT 1", rs);
+    }
+
+    obj_ptr<Redis> redis = (Redis *)Redis_base::getInstance(conn);
+    if (redis)
+    {
+        Redis::_param param;
+        Variant v;
+
+        param.add("PING");
+        std::string req = param.str();
+
+        return redis->ac__command(req, v);
+    }
+
+    obj_ptr<MongoDB_base> mdb = MongoDB_base::getInstance(conn);
+    if (mdb)
+    {
+        v8::Local<v8::Object> o;
+        return mdb->runCommand("ping", v8::Int32::New(Isolate::now()->m_isolate, 1), o);
+    }
+
+    return 0;
+}
+
+static result_t _close(object_base *conn)
+{
+    obj_ptr<DbConnection_base> sql = DbConnection_base::getInstance(conn);
+    if (sql)
+        return sql->ac_close();
+
+    obj_ptr<Redis_base> redis = Redis_base::getInstance(conn);
+    if (redis)
+        return redis->close();
+
+    obj_ptr<MongoDB_base> mdb = MongoDB_base::getInstance(conn);
+    if (mdb)
+        return mdb->ac_close();
+
+    return 0;
+}
+
+DbPool::DbPool(const char *connString) :
+    m_connString(connString), m_min(0), m_max(10),
+    m_idleTimeout(60000), m_maxWait(0), m_checkInterval(30000),
+    m_count(0), m_closed(false), m_checking(false)
+{
+    m_stats = new Stats();
+    m_stats->init(s_staticCounter, 2, s_Counter, 9);
+    m_stats->set_name("db_pool");
+}
+
+DbPool::~DbPool()
+{
+}
+
+result_t DbPool::setOptions(v8::Local<v8::Object> opts)
+{
+    result_t hr;
+
+    hr = GetConfigValue(opts, "min", m_min);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(opts, "max", m_max);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(opts, "idleTimeout", m_idleTimeout);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(opts, "maxWait", m_maxWait);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(opts, "checkInterval", m_checkInterval);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    if (m_max < 1 || m_min < 0 || m_min > m_max)
+        return CHECK_ERROR(Runtime::setError("DbPool: min must between 0 to max."));
+
+    if (m_checkInterval < 1)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    return 0;
+}
+
+void DbPool::start()
+{
+    Ref();
+    resume();
+}
+
+result_t DbPool::connect(obj_ptr<object_base> &retVal)
+{
+    result_t hr;
+
+    m_count ++;
+    m_stats->inc(POOL_CONNECTIONS);
+
+    hr = db_base::ac_open(m_connString.c_str(), retVal);
+    if (hr < 0)
+    {
+        m_count --;
+        m_stats->dec(POOL_CONNECTIONS);
+        m_stats->inc(POOL_ERROR);
+        return hr;
+    }
+
+    m_stats->inc(POOL_CONNECT);
+    return 0;
+}
+
+void DbPool::drop(object_base *conn)
+{
+    obj_ptr<object_base> c = conn;
+
+    m_count --;
+    m_stats->dec(POOL_CONNECTIONS);
+    m_stats->inc(POOL_CLOSE);
+
+    _close(c);
+}
+
+bool DbPool::wakeup(object_base *conn)
+{
+    while (!m_waiters.empty())
+    {
+        obj_ptr<_waiter> w = m_waiters.front();
+        m_waiters.pop_front();
+
+        if (!w->m_done)
+        {
+            w->m_done = true;
+            w->m_conn = conn;
+            w->m_event.set();
+
+            if (m_maxWait > 0)
+                exlib::Fiber::cancel_sleep(w);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+result_t DbPool::acquire(obj_ptr<object_base> &retVal)
+{
+    date_t t1;
+    result_t hr;
+
+    if (m_closed)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    t1.now();
+
+    if (!m_idles.empty())
+    {
+        retVal = m_idles.back().m_conn;
+        m_idles.pop_back();
+    }
+    else if (m_count < m_max)
+    {
+        hr = connect(retVal);
+        if (hr < 0)
+            return hr;
+    }
+    else
+    {
+        obj_ptr<_waiter> w = new _waiter();
+
+        m_stats->inc(POOL_WAIT);
+        m_waiters.push_back(w);
+
+        if (m_maxWait > 0)
+        {
+            w->Ref();
+            exlib::Fiber::sleep(m_maxWait, w);
+        }
+
+        {
+            Isolate::rt _rt;
+            w->m_event.wait();
+        }
+
+        date_t t2;
+        t2.now();
+        m_stats->add(POOL_WAITTIME, (int32_t)t2.diff(t1));
+
+        if (w->m_timeout)
+        {
+            m_waiters.remove(w);
+            m_stats->inc(POOL_TIMEOUT);
+            return CHECK_ERROR(Runtime::setError("DbPool: wait for connection timeout."));
+        }
+
+        if (!w->m_conn)
+            return CHECK_ERROR(Runtime::setError("DbPool: pool is closed."));
+
+        retVal = w->m_conn;
+    }
+
+    m_leases.insert(std::pair<object_base *, _item>(retVal, _item(retVal)));
+    m_stats->inc(POOL_INUSE);
+    m_stats->inc(POOL_ACQUIRE);
+
+    return 0;
+}
+
+result_t DbPool::release(object_base *conn, bool healthy)
+{
+    std::map<object_base *, _item>::iterator it = m_leases.find(conn);
+
+    if (it == m_leases.end())
+        return CHECK_ERROR(Runtime::setError("DbPool: connection is not leased from this pool."));
+
+    date_t t1;
+    t1.now();
+    m_stats->add(POOL_LEASETIME, (int32_t)t1.diff(it->second.m_time));
+    m_stats->dec(POOL_INUSE);
+    m_stats->inc(POOL_RELEASE);
+
+    m_leases.erase(it);
+
+    if (!healthy || m_closed)
+    {
+        drop(conn);
+
+        if (!m_closed && !m_waiters.empty())
+        {
+            obj_ptr<object_base> c;
+
+            if (connect(c) < 0)
+                return 0;
+
+            if (!wakeup(c))
+                m_idles.push_back(_item(c));
+        }
+
+        return 0;
+    }
+
+    if (!wakeup(conn))
+        m_idles.push_back(_item(conn));
+
+    return 0;
+}
+
+result_t DbPool::execute(v8::Local<v8::Function> func, v8::Local<v8::Value> &retVal)
+{
+    obj_ptr<object_base> conn;
+    result_t hr;
+
+    hr = acquire(conn);
+    if (hr < 0)
+        return hr;
+
+    v8::Local<v8::Value> v = conn->wrap();
+    retVal = func->Call(wrap(), 1, &v);
+
+    if (retVal.IsEmpty())
+    {
+        m_stats->inc(POOL_ERROR);
+        release(conn, false);
+        return CALL_E_JAVASCRIPT;
+    }
+
+    return release(conn, true);
+}
+
+result_t DbPool::close()
+{
+    if (m_closed)
+        return 0;
+
+    m_closed = true;
+
+    while (!m_waiters.empty())
+    {
+        obj_ptr<_waiter> w = m_waiters.front();
+        m_waiters.pop_front();
+
+        if (!w->m_done)
+        {
+            w->m_done = true;
+            w->m_event.set();
+
+            if (m_maxWait > 0)
+                exlib::Fiber::cancel_sleep(w);
+        }
+    }
+
+    while (!m_idles.empty())
+    {
+        obj_ptr<object_base> conn = m_idles.back().m_conn;
+        m_idles.pop_back();
+        drop(conn);
+    }
+
+    if (!m_checking)
+        exlib::Fiber::cancel_sleep(this);
+
+    return 0;
+}
+
+void DbPool::check()
+{
+    if (m_closed)
+    {
+        Unref();
+        return;
+    }
+
+    std::list<_item> idles;
+    date_t t1;
+
+    m_checking = true;
+    idles.swap(m_idles);
+    t1.now();
+
+    while (!idles.empty())
+    {
+        _item &idle = idles.front();
+        obj_ptr<object_base> conn = idle.m_conn;
+        bool expired = m_idleTimeout > 0 && t1.diff(idle.m_time) > m_idleTimeout;
+        date_t t = idle.m_time;
+
+        idles.pop_front();
+
+        if (m_closed || (expired && m_count > m_min))
+        {
+            drop(conn);
+            continue;
+        }
+
+        result_t hr = _ping(conn);
+        if (hr < 0)
+        {
+            asyncLog(console_base::_WARN, "DbPool: " + getResultMessage(hr));
+            m_stats->inc(POOL_ERROR);
+            drop(conn);
+            continue;
+        }
+
+        if (!wakeup(conn))
+        {
+            m_idles.push_front(_item(conn));
+            m_idles.front().m_time = t;
+        }
+    }
+
+    while (!m_closed && m_count < m_min)
+    {
+        obj_ptr<object_base> conn;
+
+        result_t hr = connect(conn);
+        if (hr < 0)
+        {
+            asyncLog(console_base::_WARN, "DbPool: " + getResultMessage(hr));
+            break;
+        }
+
+        if (!wakeup(conn))
+            m_idles.push_front(_item(conn));
+    }
+
+    m_checking = false;
+
+    if (m_closed)
+    {
+        Unref();
+        return;
+    }
+
+    exlib::Fiber::sleep(m_checkInterval, this);
+}
+
+result_t DbPool::get_size(int32_t &retVal)
+{
+    retVal = m_count;
+    return 0;
+}
+
+result_t DbPool::get_idle(int32_t &retVal)
+{
+    retVal = (int32_t)m_idles.size();
+    return 0;
+}
+
+result_t DbPool::get_stats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = m_stats;
+    return 0;
+}
+
+} /* namespace fibjs */
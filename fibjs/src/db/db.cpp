@@ -7,10 +7,40 @@
 
 #include "ifs/db.h"
 #include "ifs/Buffer.h"
+#include "DbStats.h"
 
 namespace fibjs
 {
 
+static const char *s_Counter[] =
+{ "sql", "redis", "error" };
+static const char *s_Histogram[] =
+{ "sql", "redis" };
+
+static Stats *init_stats()
+{
+    Stats *stats = new Stats();
+
+    stats->init(s_Counter, 3);
+    stats->init_histograms(s_Histogram, 2);
+    stats->set_name("db");
+    stats->Ref();
+
+    return stats;
+}
+
+Stats *db_stats()
+{
+    static Stats *s_stats = init_stats();
+    return s_stats;
+}
+
+result_t db_base::get_stats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = db_stats();
+    return 0;
+}
+
 result_t db_base::open(const char *connString, obj_ptr<object_base> &retVal, AsyncEvent *ac)
 {
     if (!qstrcmp(connString, "mysql:", 6))
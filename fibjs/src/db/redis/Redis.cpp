@@ -14,6 +14,7 @@
 #include "RedisList.h"
 #include "RedisSet.h"
 #include "RedisSortedSet.h"
+#include "DbStats.h"
 
 namespace fibjs
 {
@@ -74,6 +75,7 @@ result_t Redis::_command(std::string &req, Variant &retVal, AsyncEvent *ac)
             AsyncState(ac), m_pThis(pThis), m_req(req), m_retVal(retVal)
         {
             m_subMode = pThis->m_subMode;
+            m_d.now();
 
             m_stmBuffered = pThis->m_stmBuffered;
             set(send);
@@ -191,6 +193,7 @@ result_t Redis::_command(std::string &req, Variant &retVal, AsyncEvent *ac)
 
             if (m_subMode == 0)
             {
+                db_record(DB_REDIS, hr, m_d);
                 m_retVal = m_val;
                 return done(hr);
             }
@@ -286,6 +289,8 @@ result_t Redis::_command(std::string &req, Variant &retVal, AsyncEvent *ac)
         {
             if (m_subMode == 1)
                 m_pThis->_trigger("suberror", (Variant *)NULL, 0);
+            else if (m_subMode == 0)
+                db_record(DB_REDIS, v, m_d);
 
             return v;
         }
@@ -301,6 +306,7 @@ result_t Redis::_command(std::string &req, Variant &retVal, AsyncEvent *ac)
         QuickArray<int32_t> m_counts;
         std::string m_strLine;
         int32_t m_subMode;
+        date_t m_d;
     };
 
     if (!ac)
@@ -8,6 +8,7 @@
 #include "SQLite.h"
 #include "ifs/db.h"
 #include "DBResult.h"
+#include "DbStats.h"
 #include "Buffer.h"
 
 namespace fibjs
@@ -266,7 +267,13 @@ result_t SQLite::execute(const char *sql, obj_ptr<DBResult_base> &retVal, AsyncE
     if (!ac)
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return execute(sql, (int32_t) qstrlen(sql), retVal);
+    date_t d;
+    d.now();
+
+    result_t hr = execute(sql, (int32_t) qstrlen(sql), retVal);
+    db_record(DB_SQL, hr, d);
+
+    return hr;
 }
 
 result_t SQLite::execute(const char *sql, const v8::FunctionCallbackInfo<v8::Value> &args,
@@ -10,6 +10,7 @@
 #include "Buffer.h"
 #include "ifs/db.h"
 #include "DBResult.h"
+#include "DbStats.h"
 #include "Url.h"
 #include "Fiber.h"
 
@@ -309,7 +310,13 @@ result_t mysql::execute(const char *sql, obj_ptr<DBResult_base> &retVal, AsyncEv
     if (!ac)
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return execute(sql, (int32_t) qstrlen(sql), retVal);
+    date_t d;
+    d.now();
+
+    result_t hr = execute(sql, (int32_t) qstrlen(sql), retVal);
+    db_record(DB_SQL, hr, d);
+
+    return hr;
 }
 
 result_t mysql::execute(const char *sql, const v8::FunctionCallbackInfo<v8::Value> &args,
@@ -38,90 +38,164 @@ result_t encoding_base::base32Decode(const char *data,
 
 result_t encoding_base::base64Encode(Buffer_base *data, std::string &retVal)
 {
-    baseEncode(
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
-        6, data, retVal);
+    const std::string &strData = ((Buffer *)data)->data();
+
+    fibjs::base64Encode(strData.c_str(), (int32_t)strData.length(), retVal);
     return 0;
 }
 
 result_t encoding_base::base64Decode(const char *data,
                                      obj_ptr<Buffer_base> &retVal)
 {
-    static const char decodeTable[] =
-    {
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 62, -1, 63, /* 2x  !"#$%&'()*+,-./   */
-        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1, /* 3x 0123456789:;<=>?   */
-        -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, /* 4x @ABCDEFGHIJKLMNO   */
-        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, 63, /* 5X PQRSTUVWXYZ[\]^_   */
-        -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, /* 6x `abcdefghijklmno   */
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1 /* 7X pqrstuvwxyz{\}~DEL */
-    };
+    obj_ptr<Buffer> buf = new Buffer();
+    std::string strBuf;
+
+    fibjs::base64Decode(data, (int32_t)qstrlen(data), strBuf);
+    buf->attach(strBuf);
 
-    baseDecode(decodeTable, 6, data, retVal);
+    retVal = buf;
     return 0;
 }
 
 result_t encoding_base::hexEncode(Buffer_base *data, std::string &retVal)
 {
-    std::string strData;
-    static char HexChar[] = "0123456789abcdef";
-    int32_t i, pos, len1;
-
-    data->toString(strData);
-
-    i = (int32_t) strData.length() * 2;
-    retVal.resize(i);
-
-    len1 = 0;
-    pos = 0;
-
-    for (i = 0; i < (int32_t) strData.length(); i++)
-    {
-        retVal[pos * 2] = HexChar[(unsigned char) strData[i] >> 4];
-        retVal[pos * 2 + 1] = HexChar[(unsigned char) strData[i] & 0xf];
-        pos++;
-        len1 += 2;
-    }
+    const std::string &strData = ((Buffer *)data)->data();
 
+    fibjs::hexEncode(strData.c_str(), (int32_t)strData.length(), retVal);
     return 0;
 }
 
 result_t encoding_base::hexDecode(const char *data,
                                   obj_ptr<Buffer_base> &retVal)
 {
-    int32_t pos, len = (int32_t) qstrlen(data);
-    const char *end = data + len;
+    obj_ptr<Buffer> buf = new Buffer();
     std::string strBuf;
-    uint32_t ch1, ch2;
 
-    strBuf.resize(len / 2);
+    fibjs::hexDecode(data, (int32_t)qstrlen(data), strBuf);
+    buf->attach(strBuf);
+
+    retVal = buf;
+    return 0;
+}
 
-    pos = 0;
-    while ((ch1 = utf8_getchar(data, end)) != 0)
+class asyncBase64: public AsyncState
+{
+public:
+    asyncBase64(bool bEncode, Stream_base *src, Stream_base *stm, AsyncEvent *ac) :
+        AsyncState(ac), m_bEncode(bEncode), m_src(src), m_stm(stm)
     {
-        if (qisxdigit(ch1))
-            ch1 = qhex(ch1);
-        else
-            continue;
+        set(read);
+    }
+
+    static int32_t read(AsyncState *pState, int32_t n)
+    {
+        asyncBase64 *pThis = (asyncBase64 *) pState;
+
+        pThis->set(read_ok);
+        return pThis->m_src->read(-1, pThis->m_buffer, pThis);
+    }
+
+    static int32_t read_ok(AsyncState *pState, int32_t n)
+    {
+        asyncBase64 *pThis = (asyncBase64 *) pState;
+        std::string strBuf;
 
-        ch2 = utf8_getchar(data, end);
-        if (ch2 == 0)
-            break;
+        if (n == CALL_RETURN_NULL)
+        {
+            if (!pThis->m_bEncode || pThis->m_tail.empty())
+                return pThis->done();
+
+            base64Encode(pThis->m_tail.c_str(), (int32_t)pThis->m_tail.length(), strBuf);
+            pThis->m_tail.clear();
 
-        if (qisxdigit(ch2))
-            ch2 = qhex(ch2);
+            pThis->set(end);
+        }
         else
         {
-            ch2 = ch1;
-            ch1 = 0;
+            const std::string &strData = ((Buffer *)(Buffer_base *)pThis->m_buffer)->data();
+
+            if (pThis->m_bEncode)
+            {
+                const char *p = strData.c_str();
+                int32_t sz = (int32_t)strData.length();
+                int32_t sz1;
+
+                if (!pThis->m_tail.empty())
+                {
+                    int32_t n1 = 3 - (int32_t)pThis->m_tail.length();
+
+                    if (n1 > sz)
+                        n1 = sz;
+
+                    pThis->m_tail.append(p, n1);
+                    p += n1;
+                    sz -= n1;
+
+                    if (pThis->m_tail.length() == 3)
+                    {
+                        base64Encode(pThis->m_tail.c_str(), 3, strBuf);
+                        pThis->m_tail.clear();
+                    }
+                }
+
+                sz1 = sz / 3 * 3;
+                if (sz1 > 0)
+                {
+                    size_t pos = strBuf.length();
+
+                    strBuf.resize(pos + base64Size(sz1));
+                    base64Encode(p, sz1, &strBuf[pos]);
+                }
+
+                pThis->m_tail.append(p + sz1, sz - sz1);
+            }
+            else
+                pThis->m_decoder.decode(strData.c_str(), (int32_t)strData.length(), strBuf);
+
+            pThis->set(read);
         }
 
-        strBuf[pos++] = (ch1 << 4) + ch2;
+        if (strBuf.empty())
+            return 0;
+
+        obj_ptr<Buffer> buf = new Buffer();
+
+        buf->attach(strBuf);
+        pThis->m_buffer = buf;
+
+        return pThis->m_stm->write(pThis->m_buffer, pThis);
     }
 
-    retVal = new Buffer(strBuf);
+    static int32_t end(AsyncState *pState, int32_t n)
+    {
+        return pState->done();
+    }
 
-    return 0;
+private:
+    bool m_bEncode;
+    obj_ptr<Stream_base> m_src;
+    obj_ptr<Stream_base> m_stm;
+    obj_ptr<Buffer_base> m_buffer;
+    std::string m_tail;
+    base64Decoder m_decoder;
+};
+
+result_t encoding_base::base64EncodeTo(Stream_base *src, Stream_base *stm,
+                                       AsyncEvent *ac)
+{
+    if (!ac)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncBase64(true, src, stm, ac))->post(0);
+}
+
+result_t encoding_base::base64DecodeTo(Stream_base *src, Stream_base *stm,
+                                       AsyncEvent *ac)
+{
+    if (!ac)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncBase64(false, src, stm, ac))->post(0);
 }
 
 result_t encoding_base::iconvEncode(const char *charset, const char *data,
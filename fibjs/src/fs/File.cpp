@@ -9,6 +9,7 @@
 
 #ifndef _WIN32
 #include <sys/ioctl.h>
+#include <unistd.h>
 #endif
 
 #include <fcntl.h>
@@ -252,6 +253,48 @@ result_t File::open(const char *fname, const char *flags)
     return 0;
 }
 
+result_t File::tmpFile()
+{
+    close();
+
+#ifdef _WIN32
+    wchar_t path[MAX_PATH];
+    wchar_t fname[MAX_PATH];
+
+    if (!GetTempPathW(MAX_PATH, path) || !GetTempFileNameW(path, L"fj", 0, fname))
+        return CHECK_ERROR(LastError());
+
+    m_fd = _wopen(fname, _O_BINARY | _O_RDWR | _O_CREAT | _O_TRUNC | _O_TEMPORARY,
+                  _S_IREAD | _S_IWRITE);
+    if (m_fd < 0)
+        return CHECK_ERROR(LastError());
+
+    name = utf16to8String(fname);
+#else
+    const char *path = getenv("TMPDIR");
+    std::string fname;
+
+    if (!path || !*path)
+        path = "/tmp";
+
+    fname = path;
+    fname.append("/fibjs.XXXXXX");
+
+    m_fd = mkstemp(&fname[0]);
+    if (m_fd < 0)
+        return CHECK_ERROR(LastError());
+
+    ::unlink(fname.c_str());
+
+    if (::fcntl(m_fd, F_SETFD, FD_CLOEXEC))
+        return CHECK_ERROR(LastError());
+
+    name = fname;
+#endif
+
+    return 0;
+}
+
 result_t File::get_name(std::string &retVal)
 {
     if (m_fd == -1)
@@ -46,7 +46,15 @@ result_t fs_base::tmpFile(obj_ptr<File_base> &retVal, AsyncEvent *ac)
     if (!ac)
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    retVal = new File();
+    obj_ptr<File> pFile = new File();
+    result_t hr;
+
+    hr = pFile->tmpFile();
+    if (hr < 0)
+        return hr;
+
+    retVal = pFile;
+
     return 0;
 }
 
@@ -1,5 +1,6 @@
 #include "Buffer.h"
 #include "ifs/encoding.h"
+#include "encoding.h"
 #include "Int64.h"
 #include <cstring>
 #include <string>
@@ -201,16 +202,24 @@ result_t Buffer::append(const char *str, const char *codec)
         return 0;
     }
 
+    if (!qstrcmp(codec, "hex") || !qstrcmp(codec, "base64"))
+    {
+        std::string strBuf;
+
+        if (codec[0] == 'h')
+            hexDecode(str, (int32_t)qstrlen(str), strBuf);
+        else
+            base64Decode(str, (int32_t)qstrlen(str), strBuf);
+
+        extMemory((int32_t) strBuf.length());
+        m_data.append(strBuf);
+        return 0;
+    }
+
     obj_ptr<Buffer_base> data;
     result_t hr;
 
-    if (!qstrcmp(codec, "hex"))
-        hr = encoding_base::hexDecode(str, data);
-    else if (!qstrcmp(codec, "base64"))
-        hr = encoding_base::base64Decode(str, data);
-    else
-        hr = encoding_base::iconvEncode(codec, str, data);
-
+    hr = encoding_base::iconvEncode(codec, str, data);
     if (hr < 0)
         return hr;
 
@@ -244,20 +253,23 @@ result_t Buffer::write(const char* str, int32_t offset, int32_t length, const ch
         return 0;
     }
 
-    result_t hr;
-    obj_ptr<Buffer_base> data;
+    result_t hr = 0;
     std::string strBuf;
 
     if (!qstrcmp(codec, "hex"))
-        hr = encoding_base::hexDecode(str, data);
+        hexDecode(str, (int32_t)qstrlen(str), strBuf);
     else if (!qstrcmp(codec, "base64"))
-        hr = encoding_base::base64Decode(str, data);
+        base64Decode(str, (int32_t)qstrlen(str), strBuf);
     else
+    {
+        obj_ptr<Buffer_base> data;
+
         hr = encoding_base::iconvEncode(codec, str, data);
+        if (hr < 0)
+            return hr;
+        data->toString(strBuf);
+    }
 
-    if (hr < 0)
-        return hr;
-    data->toString(strBuf);
     m_data.replace(offset, max_length, strBuf.c_str(), max_length);
 
     return hr;
@@ -7,12 +7,13 @@
 
 #include "ifs/global.h"
 #include "Fiber.h"
+#include "TimerWheel.h"
 
 namespace fibjs
 {
 
 class Timer : public Timer_base,
-	public exlib::Task_base
+	public TimerWheel::Entry
 {
 public:
 	Timer(v8::Local<v8::Function> callback, int32_t timeout, bool repeat = false) :
@@ -34,7 +35,7 @@ public:
 		m_isolate = Isolate::now()->m_isolate;
 		m_callback.Reset(m_isolate, callback);
 
-		resume();
+		syncCall(_callback, this);
 		Ref();
 	}
 
@@ -54,25 +55,25 @@ public:
 	// Timer_base
 	virtual result_t clear()
 	{
-		m_cancel = true;
-		exlib::Fiber::cancel_sleep(this);
+		if (!m_cancel)
+		{
+			m_cancel = true;
+			if (TimerWheel::cancel(this))
+				Unref();
+		}
 		return 0;
 	}
 
 public:
-	// exlib::Task_base
-	virtual void suspend()
+	// TimerWheel::Entry
+	virtual void timeout()
 	{
-	}
-
-	virtual void resume()
-	{
-		syncCall(_callback, this);
+		callback();
 	}
 
 	void sleep()
 	{
-		exlib::Fiber::sleep(m_timeout, this);
+		TimerWheel::start(this, m_timeout);
 	}
 
 private:
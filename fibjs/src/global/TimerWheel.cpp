@@ -0,0 +1,277 @@
+/*
+ * TimerWheel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "TimerWheel.h"
+#include "Ticks.h"
+#include <vector>
+
+namespace fibjs
+{
+
+#define WHEEL_BITS0     8
+#define WHEEL_BITS      6
+#define WHEEL_LEVELS    3
+#define WHEEL_SIZE0     (1 << WHEEL_BITS0)
+#define WHEEL_SIZE      (1 << WHEEL_BITS)
+#define WHEEL_RANGE     ((int64_t)1 << (WHEEL_BITS0 + WHEEL_BITS * WHEEL_LEVELS))
+
+static exlib::spinlock s_lock;
+static TimerWheel::Entry *s_slots0[WHEEL_SIZE0];
+static TimerWheel::Entry *s_slots[WHEEL_LEVELS][WHEEL_SIZE];
+static int64_t s_now;
+static int64_t s_count;
+static int64_t s_wake;
+static int64_t s_gen;
+
+inline int64_t now_ms()
+{
+    return Ticks() / 1000000;
+}
+
+class TimerWheel::_wake: public exlib::Task_base
+{
+public:
+    _wake(int64_t gen, int64_t expire) : m_gen(gen), m_expire(expire)
+    {
+    }
+
+public:
+    void sleep()
+    {
+        int64_t delay = m_expire - now_ms();
+
+        if (delay < 0)
+            delay = 0;
+
+        exlib::Fiber::sleep((int32_t)delay, this);
+    }
+
+    static void _sleep(_wake *pThis)
+    {
+        pThis->sleep();
+    }
+
+public:
+    // exlib::Task_base
+    virtual void suspend()
+    {
+    }
+
+    virtual void resume()
+    {
+        syncCall(_tick, this);
+    }
+
+private:
+    static void _tick(_wake *pThis)
+    {
+        int64_t gen = pThis->m_gen;
+
+        delete pThis;
+        TimerWheel::tick(gen);
+    }
+
+private:
+    int64_t m_gen;
+    int64_t m_expire;
+};
+
+void TimerWheel::add(Entry *e)
+{
+    int64_t expire = e->m_expire;
+    int64_t delta;
+    Entry **slot;
+
+    if (expire < s_now)
+        expire = s_now;
+    delta = expire - s_now;
+
+    if (delta < WHEEL_SIZE0)
+        slot = &s_slots0[expire & (WHEEL_SIZE0 - 1)];
+    else
+    {
+        int32_t level = 0;
+        int32_t shift = WHEEL_BITS0;
+
+        if (delta >= WHEEL_RANGE)
+        {
+            expire = s_now + WHEEL_RANGE - 1;
+            delta = WHEEL_RANGE - 1;
+        }
+
+        while (delta >= ((int64_t)1 << (shift + WHEEL_BITS)))
+        {
+            level ++;
+            shift += WHEEL_BITS;
+        }
+
+        slot = &s_slots[level][(expire >> shift) & (WHEEL_SIZE - 1)];
+    }
+
+    e->m_slot = slot;
+    e->m_prev = NULL;
+    e->m_next = *slot;
+    if (*slot)
+        (*slot)->m_prev = e;
+    *slot = e;
+}
+
+void TimerWheel::unlink(Entry *e)
+{
+    if (e->m_prev)
+        e->m_prev->m_next = e->m_next;
+    else
+        *e->m_slot = e->m_next;
+
+    if (e->m_next)
+        e->m_next->m_prev = e->m_prev;
+
+    e->m_prev = e->m_next = NULL;
+    e->m_slot = NULL;
+}
+
+void TimerWheel::schedule(int64_t expire)
+{
+    if (s_wake != 0 && s_wake <= expire)
+        return;
+
+    _wake *w = new _wake(++s_gen, expire);
+
+    s_wake = expire;
+    if (exlib::Service::hasService())
+        w->sleep();
+    else
+        syncCall(_wake::_sleep, w);
+}
+
+void TimerWheel::start(Entry *e, int32_t ms)
+{
+    int64_t now = now_ms();
+
+    if (ms < 1)
+        ms = 1;
+
+    s_lock.lock();
+
+    if (e->m_slot)
+        unlink(e);
+    else
+        s_count ++;
+
+    if (s_count == 1 && s_now < now)
+        s_now = now;
+
+    e->m_expire = now + ms;
+    if (e->m_expire <= s_now)
+        e->m_expire = s_now + 1;
+
+    add(e);
+    schedule(e->m_expire);
+
+    s_lock.unlock();
+}
+
+bool TimerWheel::cancel(Entry *e)
+{
+    bool bCancel = false;
+
+    s_lock.lock();
+    if (e->m_slot)
+    {
+        unlink(e);
+        s_count --;
+        bCancel = true;
+    }
+    s_lock.unlock();
+
+    return bCancel;
+}
+
+void TimerWheel::tick(int64_t gen)
+{
+    std::vector<Entry *> expired;
+    int64_t now = now_ms();
+    Entry *e;
+    size_t i;
+
+    s_lock.lock();
+
+    if (gen != s_gen)
+    {
+        s_lock.unlock();
+        return;
+    }
+
+    s_wake = 0;
+
+    while (s_now < now && s_count > 0)
+    {
+        int64_t t = ++s_now;
+        int32_t idx = (int32_t)(t & (WHEEL_SIZE0 - 1));
+
+        if (idx == 0)
+        {
+            int32_t level;
+
+            for (level = WHEEL_LEVELS - 1; level >= 0; level --)
+            {
+                int32_t shift = WHEEL_BITS0 + WHEEL_BITS * level;
+
+                if ((t & (((int64_t)1 << shift) - 1)) == 0)
+                {
+                    Entry **slot = &s_slots[level][(t >> shift) & (WHEEL_SIZE - 1)];
+                    Entry *p = *slot;
+
+                    *slot = NULL;
+                    while (p)
+                    {
+                        e = p;
+                        p = p->m_next;
+                        add(e);
+                    }
+                }
+            }
+        }
+
+        while ((e = s_slots0[idx]) != NULL)
+        {
+            unlink(e);
+            s_count --;
+            expired.push_back(e);
+        }
+    }
+
+    if (s_count == 0)
+    {
+        if (s_now < now)
+            s_now = now;
+    }
+    else
+    {
+        int64_t t = s_now + 1;
+
+        while ((t & (WHEEL_SIZE0 - 1)) && !s_slots0[t & (WHEEL_SIZE0 - 1)])
+            t ++;
+
+        schedule(t);
+    }
+
+    s_lock.unlock();
+
+    // only the bookkeeping is batched, a callback that blocks must not
+    // hold up the others
+    for (i = 0; i < expired.size(); i ++)
+        syncCall(_timeout, expired[i]);
+}
+
+void TimerWheel::_timeout(Entry *e)
+{
+    e->timeout();
+}
+
+} /* namespace fibjs */
@@ -0,0 +1,356 @@
+/*
+ * HttpAgent.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/http.h"
+#include "HttpAgent.h"
+#include "TimerWheel.h"
+#include <map>
+#include <list>
+
+namespace fibjs
+{
+
+int32_t HttpAgent::s_maxSockets = 32;
+int32_t HttpAgent::s_keepAliveTimeout = 4000;
+int32_t HttpAgent::s_maxRequests = 1000;
+
+enum
+{
+    AGENT_ACTIVE = 0,
+    AGENT_IDLE,
+    AGENT_PENDING,
+    AGENT_CONNECTS,
+    AGENT_REUSES,
+    AGENT_EXPIRED
+};
+
+class _idle
+{
+public:
+    _idle(Stream_base *conn, int32_t uses, date_t &d) :
+        m_conn(conn), m_uses(uses), m_time(d)
+    {
+    }
+
+public:
+    obj_ptr<Stream_base> m_conn;
+    int32_t m_uses;
+    date_t m_time;
+};
+
+class _waiter
+{
+public:
+    _waiter(AsyncEvent *ac, obj_ptr<Stream_base> *conn, int32_t *uses) :
+        m_ac(ac), m_conn(conn), m_uses(uses)
+    {
+    }
+
+public:
+    AsyncEvent *m_ac;
+    obj_ptr<Stream_base> *m_conn;
+    int32_t *m_uses;
+};
+
+class _pool
+{
+public:
+    _pool() : m_active(0)
+    {
+    }
+
+public:
+    int32_t m_active;
+    std::list<_idle> m_idle;
+    std::list<_waiter> m_waiters;
+};
+
+static exlib::spinlock s_lock;
+static std::map<std::string, _pool> s_pools;
+
+static Stats *create_stats()
+{
+    static const char *s_staticCounter[] =
+    { "active", "idle", "pending" };
+    static const char *s_Counter[] =
+    { "connects", "reuses", "expired" };
+
+    Stats *stats = new Stats();
+
+    stats->Ref();
+    stats->init(s_staticCounter, 3, s_Counter, 3);
+    stats->set_name("http_agent");
+
+    return stats;
+}
+
+Stats *HttpAgent::stats()
+{
+    static Stats *s_stats = create_stats();
+    return s_stats;
+}
+
+// returns the ms until the next idle connection expires, or -1 if none
+static int32_t purge(Stats *stats, date_t &now,
+                     std::list<obj_ptr<Stream_base> > &expired)
+{
+    std::map<std::string, _pool>::iterator it = s_pools.begin();
+    int32_t next = -1;
+
+    while (it != s_pools.end())
+    {
+        _pool &pool = it->second;
+
+        while (!pool.m_idle.empty() &&
+                now.diff(pool.m_idle.front().m_time) >= HttpAgent::s_keepAliveTimeout)
+        {
+            expired.push_back(pool.m_idle.front().m_conn);
+            pool.m_idle.pop_front();
+
+            stats->dec(AGENT_IDLE);
+            stats->inc(AGENT_EXPIRED);
+        }
+
+        if (!pool.m_idle.empty())
+        {
+            int32_t left = HttpAgent::s_keepAliveTimeout -
+                           (int32_t)now.diff(pool.m_idle.front().m_time);
+
+            if (next < 0 || left < next)
+                next = left;
+        }
+
+        if (pool.m_active == 0 && pool.m_idle.empty() && pool.m_waiters.empty())
+            s_pools.erase(it++);
+        else
+            ++it;
+    }
+
+    return next;
+}
+
+// idle connections are closed on time even if no further request is made,
+// the timer runs only while some connection is idle
+class _purger: public TimerWheel::Entry
+{
+public:
+    _purger() : m_armed(false)
+    {
+    }
+
+public:
+    // TimerWheel::Entry
+    virtual void timeout()
+    {
+        std::list<obj_ptr<Stream_base> > expired;
+        date_t now;
+        int32_t next;
+
+        now.now();
+
+        s_lock.lock();
+
+        next = purge(HttpAgent::stats(), now, expired);
+        m_armed = next >= 0;
+        if (m_armed)
+            TimerWheel::start(this, next);
+
+        s_lock.unlock();
+    }
+
+    // called with s_lock held
+    void arm()
+    {
+        if (!m_armed)
+        {
+            m_armed = true;
+            TimerWheel::start(this, HttpAgent::s_keepAliveTimeout);
+        }
+    }
+
+    // keepAliveTimeout has changed, the pending check may be too late
+    void rearm()
+    {
+        if (m_armed)
+            TimerWheel::start(this, HttpAgent::s_keepAliveTimeout);
+    }
+
+private:
+    bool m_armed;
+};
+
+static _purger s_purger;
+
+result_t HttpAgent::acquire(const std::string &key, obj_ptr<Stream_base> &conn,
+                            int32_t &uses, AsyncEvent *ac)
+{
+    Stats *stats = HttpAgent::stats();
+    std::list<obj_ptr<Stream_base> > expired;
+    date_t now;
+
+    now.now();
+    conn.Release();
+    uses = 0;
+
+    s_lock.lock();
+
+    _pool &pool = s_pools[key];
+
+    // the purge timer may not have caught up with this pool yet
+    while (!pool.m_idle.empty() &&
+            now.diff(pool.m_idle.front().m_time) >= s_keepAliveTimeout)
+    {
+        expired.push_back(pool.m_idle.front().m_conn);
+        pool.m_idle.pop_front();
+
+        stats->dec(AGENT_IDLE);
+        stats->inc(AGENT_EXPIRED);
+    }
+
+    if (!pool.m_idle.empty())
+    {
+        _idle &idle = pool.m_idle.back();
+
+        conn = idle.m_conn;
+        uses = idle.m_uses;
+        pool.m_idle.pop_back();
+        pool.m_active ++;
+
+        stats->dec(AGENT_IDLE);
+        stats->inc(AGENT_ACTIVE);
+        stats->inc(AGENT_REUSES);
+
+        s_lock.unlock();
+        return 0;
+    }
+
+    if (s_maxSockets <= 0 || pool.m_active < s_maxSockets)
+    {
+        pool.m_active ++;
+
+        stats->inc(AGENT_ACTIVE);
+        stats->inc(AGENT_CONNECTS);
+
+        s_lock.unlock();
+        return 0;
+    }
+
+    pool.m_waiters.push_back(_waiter(ac, &conn, &uses));
+    stats->inc(AGENT_PENDING);
+
+    s_lock.unlock();
+    return CALL_E_PENDDING;
+}
+
+bool HttpAgent::release(const std::string &key, Stream_base *conn, int32_t uses)
+{
+    Stats *stats = HttpAgent::stats();
+    bool bKeep = conn && s_keepAliveTimeout > 0 &&
+                 (s_maxRequests <= 0 || uses < s_maxRequests);
+    date_t now;
+
+    now.now();
+
+    s_lock.lock();
+
+    _pool &pool = s_pools[key];
+
+    if (!pool.m_waiters.empty())
+    {
+        _waiter w = pool.m_waiters.front();
+
+        pool.m_waiters.pop_front();
+        stats->dec(AGENT_PENDING);
+
+        if (bKeep)
+        {
+            *w.m_conn = conn;
+            *w.m_uses = uses;
+            stats->inc(AGENT_REUSES);
+        }
+        else
+            stats->inc(AGENT_CONNECTS);
+
+        s_lock.unlock();
+
+        w.m_ac->apost(0);
+        return bKeep;
+    }
+
+    pool.m_active --;
+    stats->dec(AGENT_ACTIVE);
+
+    if (bKeep)
+    {
+        pool.m_idle.push_back(_idle(conn, uses, now));
+        stats->inc(AGENT_IDLE);
+        s_purger.arm();
+    }
+    else if (pool.m_active == 0 && pool.m_idle.empty())
+        s_pools.erase(key);
+
+    s_lock.unlock();
+
+    return bKeep;
+}
+
+result_t http_base::get_maxSockets(int32_t &retVal)
+{
+    retVal = HttpAgent::s_maxSockets;
+    return 0;
+}
+
+result_t http_base::set_maxSockets(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    HttpAgent::s_maxSockets = newVal;
+    return 0;
+}
+
+result_t http_base::get_keepAliveTimeout(int32_t &retVal)
+{
+    retVal = HttpAgent::s_keepAliveTimeout;
+    return 0;
+}
+
+result_t http_base::set_keepAliveTimeout(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    s_lock.lock();
+    HttpAgent::s_keepAliveTimeout = newVal;
+    s_purger.rearm();
+    s_lock.unlock();
+
+    return 0;
+}
+
+result_t http_base::get_maxRequestsPerSocket(int32_t &retVal)
+{
+    retVal = HttpAgent::s_maxRequests;
+    return 0;
+}
+
+result_t http_base::set_maxRequestsPerSocket(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    HttpAgent::s_maxRequests = newVal;
+    return 0;
+}
+
+result_t http_base::get_agentStats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = HttpAgent::stats();
+    return 0;
+}
+
+} /* namespace fibjs */
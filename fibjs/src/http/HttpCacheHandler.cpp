@@ -0,0 +1,743 @@
+/*
+ * HttpCacheHandler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/http.h"
+#include "ifs/mq.h"
+#include "ifs/zlib.h"
+#include "HttpCacheHandler.h"
+#include "HttpCollection.h"
+#include "JSHandler.h"
+#include "MemoryStream.h"
+#include "Buffer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace fibjs
+{
+
+static const char *s_staticCounter[] =
+{ "entries", "bytes" };
+static const char *s_Counter[] =
+{ "hit", "miss", "not_modified", "coalesced", "stored", "evicted" };
+
+enum
+{
+    CACHE_ENTRIES = 0,
+    CACHE_BYTES,
+    CACHE_HIT,
+    CACHE_MISS,
+    CACHE_NOT_MODIFIED,
+    CACHE_COALESCED,
+    CACHE_STORED,
+    CACHE_EVICTED
+};
+
+result_t http_base::cacheHandler(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts,
+                                 obj_ptr<HttpCacheHandler_base> &retVal)
+{
+    obj_ptr<HttpCacheHandler> cache_hdlr = new HttpCacheHandler();
+    result_t hr = cache_hdlr->init(hdlr, opts);
+    if (hr < 0)
+        return hr;
+
+    retVal = cache_hdlr;
+
+    return 0;
+}
+
+HttpCacheHandler::HttpCacheHandler() :
+    m_ttl(60000), m_maxSize(64 * 1024 * 1024), m_head(NULL), m_tail(NULL), m_size(0)
+{
+    m_stats = new Stats();
+    m_stats->init(s_staticCounter, 2, s_Counter, 6);
+    m_stats->set_name("http_cache");
+}
+
+HttpCacheHandler::~HttpCacheHandler()
+{
+    clear();
+}
+
+result_t HttpCacheHandler::init(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts)
+{
+    obj_ptr<Handler_base> hdlr1;
+    result_t hr = JSHandler::New(hdlr, hdlr1);
+    if (hr < 0)
+        return hr;
+
+    wrap()->SetHiddenValue(v8::String::NewFromUtf8(Isolate::now()->m_isolate, "handler"),
+                           hdlr1->wrap());
+    m_hdlr = hdlr1;
+
+    int32_t ttl;
+
+    hr = GetConfigValue(opts, "ttl", ttl);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+    {
+    }
+    else if (hr < 0)
+        return hr;
+    else
+    {
+        if (ttl < 0)
+            return CHECK_ERROR(CALL_E_OUTRANGE);
+        m_ttl = ttl;
+    }
+
+    int64_t maxSize;
+
+    hr = GetConfigValue(opts, "maxSize", maxSize);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+    {
+    }
+    else if (hr < 0)
+        return hr;
+    else
+    {
+        if (maxSize < 0)
+            return CHECK_ERROR(CALL_E_OUTRANGE);
+        m_maxSize = (size_t)maxSize;
+    }
+
+    v8::Local<v8::Array> vary;
+
+    hr = GetConfigValue(opts, "vary", vary);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+    {
+    }
+    else if (hr < 0)
+        return hr;
+    else
+    {
+        int32_t len = vary->Length();
+        int32_t i;
+
+        for (i = 0; i < len; i++)
+        {
+            std::string v;
+
+            hr = GetArgumentValue(vary->Get(i), v);
+            if (hr < 0)
+                return CHECK_ERROR(hr);
+
+            m_vary.push_back(v);
+        }
+    }
+
+    return 0;
+}
+
+void HttpCacheHandler::key(HttpRequest_base *req, std::string &retVal)
+{
+    std::string str;
+    Variant v;
+    size_t i;
+
+    // one handler may serve several virtual hosts
+    if (req->firstHeader("Host", v) != CALL_RETURN_NULL)
+    {
+        str = v.string();
+        for (i = 0; i < str.length(); i ++)
+            retVal += (char)qtolower(str[i]);
+    }
+
+    retVal += '\n';
+    req->get_address(str);
+    retVal.append(str);
+
+    req->get_queryString(str);
+    if (!str.empty())
+    {
+        retVal += '?';
+        retVal.append(str);
+    }
+
+    for (i = 0; i < m_vary.size(); i ++)
+    {
+        retVal += '\n';
+        if (req->firstHeader(m_vary[i].c_str(), v) != CALL_RETURN_NULL)
+            retVal.append(v.string());
+    }
+}
+
+// true if every request header a response Vary names is part of the key,
+// Accept-Encoding is served by the cache itself from the plain and gzip copies
+bool HttpCacheHandler::keyed(const std::string &vary)
+{
+    const char *p = vary.c_str();
+
+    while (*p)
+    {
+        const char *p1;
+        size_t i;
+
+        while (*p == ' ' || *p == '\t' || *p == ',')
+            p ++;
+        if (!*p)
+            break;
+
+        p1 = p;
+        while (*p1 && *p1 != ',' && *p1 != ' ' && *p1 != '\t')
+            p1 ++;
+
+        std::string name(p, p1 - p);
+
+        if (!qstricmp(name.c_str(), "Accept-Encoding"))
+        {
+            p = p1;
+            continue;
+        }
+
+        for (i = 0; i < m_vary.size(); i ++)
+            if (!qstricmp(name.c_str(), m_vary[i].c_str()))
+                break;
+
+        if (i == m_vary.size())
+            return false;
+
+        p = p1;
+    }
+
+    return true;
+}
+
+static void vary(HttpResponse_base *rep)
+{
+    Variant hdr;
+
+    if (rep->firstHeader("Vary", hdr) == CALL_RETURN_NULL)
+        rep->setHeader("Vary", "Accept-Encoding");
+    else
+    {
+        std::string str = hdr.string();
+
+        if (str != "*" && !qstristr(str.c_str(), "Accept-Encoding"))
+            rep->setHeader("Vary", str + ", Accept-Encoding");
+    }
+}
+
+void HttpCacheHandler::link(Entry *e)
+{
+    e->m_prev = NULL;
+    e->m_next = m_head;
+    if (m_head)
+        m_head->m_prev = e;
+    else
+        m_tail = e;
+    m_head = e;
+}
+
+void HttpCacheHandler::unlink(Entry *e)
+{
+    if (e->m_prev)
+        e->m_prev->m_next = e->m_next;
+    else
+        m_head = e->m_next;
+
+    if (e->m_next)
+        e->m_next->m_prev = e->m_prev;
+    else
+        m_tail = e->m_prev;
+
+    e->m_prev = e->m_next = NULL;
+}
+
+void HttpCacheHandler::remove(Entry *e)
+{
+    unlink(e);
+    m_entries.erase(e->m_key);
+
+    m_size -= e->m_size;
+    m_stats->dec(CACHE_ENTRIES);
+    m_stats->add(CACHE_BYTES, -(int32_t)e->m_size);
+
+    delete e;
+}
+
+void HttpCacheHandler::store(Entry *e)
+{
+    std::map<std::string, Entry *>::iterator it;
+
+    if (e->m_size > m_maxSize)
+    {
+        delete e;
+        return;
+    }
+
+    m_lock.lock();
+
+    it = m_entries.find(e->m_key);
+    if (it != m_entries.end())
+        remove(it->second);
+
+    while (m_tail && m_size + e->m_size > m_maxSize)
+    {
+        remove(m_tail);
+        m_stats->inc(CACHE_EVICTED);
+    }
+
+    m_entries.insert(std::pair<std::string, Entry *>(e->m_key, e));
+    link(e);
+
+    m_size += e->m_size;
+    m_stats->inc(CACHE_ENTRIES);
+    m_stats->add(CACHE_BYTES, (int32_t)e->m_size);
+    m_stats->inc(CACHE_STORED);
+
+    m_lock.unlock();
+}
+
+class HttpCacheHandler::asyncInvoke: public AsyncState
+{
+public:
+    asyncInvoke(HttpCacheHandler *pThis, HttpRequest_base *req, AsyncEvent *ac) :
+        AsyncState(ac), m_pThis(pThis), m_req(req), m_bCache(false),
+        m_bRefresh(false), m_bWaited(false), m_bLeader(false), m_bHead(false),
+        m_gzip(false)
+    {
+        obj_ptr<Message_base> m;
+        req->get_response(m);
+        m_rep = (HttpResponse_base *)(Message_base *)m;
+
+        std::string str;
+        Variant hdr;
+
+        m_req->get_method(str);
+        m_bHead = !qstricmp(str.c_str(), "HEAD");
+        if (m_bHead || !qstricmp(str.c_str(), "GET"))
+        {
+            m_bCache = true;
+            m_pThis->key(m_req, m_key);
+
+            if (m_req->firstHeader("Cache-Control", hdr) != CALL_RETURN_NULL)
+            {
+                str = hdr.string();
+                if (qstristr(str.c_str(), "no-cache"))
+                    m_bRefresh = true;
+            }
+
+            if (m_req->firstHeader("Accept-Encoding", hdr) != CALL_RETURN_NULL)
+            {
+                str = hdr.string();
+                if (qstristr(str.c_str(), "gzip"))
+                    m_gzip = true;
+            }
+        }
+
+        set(lookup);
+    }
+
+    ~asyncInvoke()
+    {
+        if (m_bLeader)
+            m_pThis->finish(m_key);
+    }
+
+public:
+    static int32_t lookup(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+        HttpCacheHandler *hdlr = pThis->m_pThis;
+        std::map<std::string, Entry *>::iterator it;
+        std::map<std::string, std::list<asyncInvoke *> >::iterator fit;
+
+        pThis->set(invoke);
+        if (!pThis->m_bCache)
+            return 0;
+
+        hdlr->m_lock.lock();
+
+        it = hdlr->m_entries.find(pThis->m_key);
+        if (it != hdlr->m_entries.end())
+        {
+            Entry *e = it->second;
+            date_t d;
+
+            d.now();
+            if (d.diff(e->m_time) < e->m_ttl)
+            {
+                if (!pThis->m_bRefresh)
+                {
+                    hdlr->unlink(e);
+                    hdlr->link(e);
+
+                    pThis->m_status = e->m_status;
+                    pThis->m_names = e->m_names;
+                    pThis->m_values = e->m_values;
+                    pThis->m_etag = e->m_etag;
+                    pThis->m_body = (pThis->m_gzip && e->m_gzip) ? e->m_gzip : e->m_body;
+                    pThis->m_gzip = pThis->m_gzip && e->m_gzip;
+
+                    hdlr->m_stats->inc(CACHE_HIT);
+                    hdlr->m_lock.unlock();
+
+                    pThis->set(serve);
+                    return 0;
+                }
+            }
+            else
+                hdlr->remove(e);
+        }
+
+        if (pThis->m_bWaited || pThis->m_bHead)
+        {
+            // the request we waited for did not produce a cacheable response,
+            // or this is a HEAD request whose response has no body to store
+            hdlr->m_lock.unlock();
+            return 0;
+        }
+
+        fit = hdlr->m_flights.find(pThis->m_key);
+        if (fit != hdlr->m_flights.end())
+        {
+            hdlr->m_stats->inc(CACHE_COALESCED);
+
+            pThis->m_bWaited = true;
+            pThis->set(lookup);
+            fit->second.push_back(pThis);
+
+            hdlr->m_lock.unlock();
+            return CALL_E_PENDDING;
+        }
+
+        hdlr->m_flights[pThis->m_key];
+        pThis->m_bLeader = true;
+
+        hdlr->m_stats->inc(CACHE_MISS);
+        hdlr->m_lock.unlock();
+
+        return 0;
+    }
+
+    static int32_t serve(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+        Variant hdr;
+        size_t i;
+
+        if (pThis->m_req->firstHeader("If-None-Match", hdr) != CALL_RETURN_NULL)
+        {
+            std::string str = hdr.string();
+
+            if (str == "*" || qstrstr(str.c_str(), pThis->m_etag.c_str()))
+            {
+                pThis->m_pThis->m_stats->inc(CACHE_NOT_MODIFIED);
+                pThis->m_rep->set_status(304);
+                pThis->m_rep->addHeader("ETag", pThis->m_etag);
+                return pThis->done(CALL_RETURN_NULL);
+            }
+        }
+
+        pThis->m_rep->set_status(pThis->m_status);
+        for (i = 0; i < pThis->m_names.size(); i ++)
+            pThis->m_rep->addHeader(pThis->m_names[i].c_str(), pThis->m_values[i]);
+
+        if (pThis->m_gzip)
+            pThis->m_rep->addHeader("Content-Encoding", "gzip");
+
+        obj_ptr<MemoryStream> body = new MemoryStream();
+
+        body->write(pThis->m_body, NULL);
+        body->rewind();
+        pThis->m_rep->set_body(body);
+
+        return pThis->done(CALL_RETURN_NULL);
+    }
+
+    static int32_t invoke(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+
+        pThis->set(check);
+        return mq_base::invoke(pThis->m_pThis->m_hdlr, pThis->m_req, pThis);
+    }
+
+    static int32_t check(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+        obj_ptr<List_base> cookies;
+        int32_t status;
+        int32_t len;
+        int64_t sz;
+        Variant hdr;
+
+        if (!pThis->m_bLeader)
+            return pThis->done(CALL_RETURN_NULL);
+
+        pThis->m_rep->get_status(status);
+        if (status != 200)
+            return pThis->done(CALL_RETURN_NULL);
+
+        pThis->m_rep->get_cookies(cookies);
+        cookies->get_length(len);
+        if (len > 0)
+            return pThis->done(CALL_RETURN_NULL);
+
+        // a response that differs by a header outside the key would be
+        // served to clients that sent something else
+        if (pThis->m_rep->firstHeader("Vary", hdr) != CALL_RETURN_NULL
+                && !pThis->m_pThis->keyed(hdr.string()))
+            return pThis->done(CALL_RETURN_NULL);
+
+        bool bShared = false;
+
+        pThis->m_ttl = pThis->m_pThis->m_ttl;
+        if (pThis->m_rep->firstHeader("Cache-Control", hdr) != CALL_RETURN_NULL)
+        {
+            std::string str = hdr.string();
+            const char *p;
+
+            if (qstristr(str.c_str(), "no-store") || qstristr(str.c_str(), "no-cache")
+                    || qstristr(str.c_str(), "private"))
+                return pThis->done(CALL_RETURN_NULL);
+
+            if (qstristr(str.c_str(), "public"))
+                bShared = true;
+
+            if ((p = qstristr(str.c_str(), "s-maxage=")) != NULL)
+            {
+                pThis->m_ttl = max_age(p + 9);
+                bShared = true;
+            }
+            else if ((p = qstristr(str.c_str(), "max-age=")) != NULL)
+                pThis->m_ttl = max_age(p + 8);
+        }
+
+        // an authorized response belongs to one user unless it says otherwise
+        bool bAuth;
+
+        pThis->m_req->hasHeader("Authorization", bAuth);
+        if (bAuth && !bShared)
+            return pThis->done(CALL_RETURN_NULL);
+
+        if (pThis->m_ttl <= 0)
+            return pThis->done(CALL_RETURN_NULL);
+
+        pThis->m_rep->get_length(sz);
+        if (sz > (int64_t)pThis->m_pThis->m_maxSize / 4)
+            return pThis->done(CALL_RETURN_NULL);
+
+        pThis->m_rep->get_body(pThis->m_stm);
+        if (!pThis->m_stm)
+            return save(pThis, CALL_RETURN_NULL);
+
+        pThis->m_stm->rewind();
+
+        pThis->set(read);
+        return pThis->m_stm->readAll(pThis->m_body, pThis);
+    }
+
+    static int32_t read(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+        int32_t len;
+        Variant hdr;
+
+        pThis->m_stm->rewind();
+
+        if (n == CALL_RETURN_NULL)
+            return save(pThis, n);
+
+        pThis->m_body->get_length(len);
+        if (len <= 128)
+            return save(pThis, 0);
+
+        if (pThis->m_rep->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL)
+            return save(pThis, 0);
+
+        if (pThis->m_rep->firstHeader("Content-Type", hdr) == CALL_RETURN_NULL)
+            return save(pThis, 0);
+
+        std::string str = hdr.string();
+
+        if (qstricmp(str.c_str(), "text/", 5)
+                && qstricmp(str.c_str(), "application/x-javascript")
+                && qstricmp(str.c_str(), "application/json"))
+            return save(pThis, 0);
+
+        pThis->set(save);
+        return zlib_base::gzip(pThis->m_body, pThis->m_zip, pThis);
+    }
+
+    static int32_t save(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+        obj_ptr<HttpCollection_base> headers;
+        HttpCollection *hc;
+        Entry *e = new Entry();
+        int32_t i, len;
+
+        if (!pThis->m_body)
+            pThis->m_body = new Buffer();
+
+        e->m_key = pThis->m_key;
+        e->m_body = pThis->m_body;
+        e->m_gzip = pThis->m_zip;
+        e->m_ttl = pThis->m_ttl;
+        e->m_time.now();
+
+        // the gzip copy is served by Accept-Encoding, shared caches
+        // downstream must key on it too
+        if (e->m_gzip)
+            vary(pThis->m_rep);
+
+        pThis->m_rep->get_headers(headers);
+        hc = (HttpCollection *)(HttpCollection_base *)headers;
+
+        e->m_size = sizeof(Entry) + e->m_key.length();
+        for (i = 0; i < hc->count(); i ++)
+        {
+            const std::string &name = hc->name(i);
+
+            if (!qstricmp(name.c_str(), "ETag"))
+                e->m_etag = hc->value(i);
+
+            e->m_names.push_back(name);
+            e->m_values.push_back(hc->value(i));
+            e->m_size += name.length() + hc->value(i).length();
+        }
+
+        if (e->m_etag.empty())
+        {
+            const std::string &strData = ((Buffer *)(Buffer_base *)e->m_body)->data();
+            const unsigned char *p = (const unsigned char *)strData.c_str();
+            const unsigned char *end = p + strData.length();
+            uint64_t h = 14695981039346656037ull;
+            char buf[32];
+
+            while (p < end)
+            {
+                h ^= *p++;
+                h *= 1099511628211ull;
+            }
+
+            sprintf(buf, "\"%016llx\"", (unsigned long long)h);
+            e->m_etag = buf;
+
+            e->m_names.push_back("ETag");
+            e->m_values.push_back(e->m_etag);
+            e->m_size += e->m_etag.length() + 4;
+        }
+
+        e->m_body->get_length(len);
+        e->m_size += len;
+        if (e->m_gzip)
+        {
+            e->m_gzip->get_length(len);
+            e->m_size += len;
+        }
+
+        pThis->m_pThis->store(e);
+
+        return pThis->done(CALL_RETURN_NULL);
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        if (is(save))
+        {
+            m_zip.Release();
+            return 0;
+        }
+
+        if (is(read))
+            return done(CALL_RETURN_NULL);
+
+        return v;
+    }
+
+private:
+    static int32_t max_age(const char *p)
+    {
+        int64_t age = strtoll(p, NULL, 10);
+
+        if (age <= 0)
+            return 0;
+        if (age > 2147483647ll / 1000)
+            return 2147483647;
+        return (int32_t)(age * 1000);
+    }
+
+private:
+    obj_ptr<HttpCacheHandler> m_pThis;
+    obj_ptr<HttpRequest_base> m_req;
+    obj_ptr<HttpResponse_base> m_rep;
+    obj_ptr<SeekableStream_base> m_stm;
+    obj_ptr<Buffer_base> m_body;
+    obj_ptr<Buffer_base> m_zip;
+    std::string m_key;
+    std::vector<std::string> m_names;
+    std::vector<std::string> m_values;
+    std::string m_etag;
+    int32_t m_status;
+    int32_t m_ttl;
+    bool m_bCache;
+    bool m_bRefresh;
+    bool m_bWaited;
+    bool m_bLeader;
+    bool m_bHead;
+    bool m_gzip;
+};
+
+void HttpCacheHandler::finish(const std::string &key)
+{
+    std::map<std::string, std::list<asyncInvoke *> >::iterator it;
+    std::list<asyncInvoke *> waiters;
+
+    m_lock.lock();
+    it = m_flights.find(key);
+    if (it != m_flights.end())
+    {
+        waiters.swap(it->second);
+        m_flights.erase(it);
+    }
+    m_lock.unlock();
+
+    while (!waiters.empty())
+    {
+        waiters.front()->apost(0);
+        waiters.pop_front();
+    }
+}
+
+result_t HttpCacheHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
+                                  AsyncEvent *ac)
+{
+    if (!ac)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    obj_ptr<HttpRequest_base> req = HttpRequest_base::getInstance(v);
+
+    if (req == NULL)
+        return CHECK_ERROR(CALL_E_BADVARTYPE);
+
+    return (new asyncInvoke(this, req, ac))->post(0);
+}
+
+result_t HttpCacheHandler::get_handler(obj_ptr<Handler_base> &retVal)
+{
+    retVal = m_hdlr;
+    return 0;
+}
+
+result_t HttpCacheHandler::clear()
+{
+    m_lock.lock();
+    while (m_head)
+        remove(m_head);
+    m_lock.unlock();
+
+    return 0;
+}
+
+result_t HttpCacheHandler::get_stats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = m_stats;
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -12,6 +12,8 @@
 #include "ifs/mq.h"
 #include "Buffer.h"
 #include "MemoryStream.h"
+#include "Socket.h"
+#include "SslSocket.h"
 #include "ifs/zlib.h"
 #include "ifs/console.h"
 
@@ -22,6 +24,8 @@ static const char *s_staticCounter[] =
 { "total", "pendding" };
 static const char *s_Counter[] =
 { "request", "response", "error", "error_400", "error_404", "error_500", "totalTime" };
+static const char *s_Histogram[] =
+{ "latency" };
 
 enum
 {
@@ -36,6 +40,11 @@ enum
     HTTP_TOTAL_TIME
 };
 
+enum
+{
+    HTTP_LATENCY = 0
+};
+
 result_t HttpHandler_base::_new(v8::Local<v8::Value> hdlr,
                                 obj_ptr<HttpHandler_base> &retVal,
                                 v8::Local<v8::Object> This)
@@ -56,10 +65,13 @@ result_t HttpHandler_base::_new(v8::Local<v8::Value> hdlr,
 
 HttpHandler::HttpHandler() :
     m_crossDomain(false), m_forceGZIP(false), m_maxHeadersCount(
-        128), m_maxUploadSize(67108864)
+        128), m_maxUploadSize(67108864), m_maxPartSize(67108864),
+    m_streamUpload(false), m_timeout(0), m_idleTimeout(0)
 {
     m_stats = new Stats();
     m_stats->init(s_staticCounter, 2, s_Counter, 7);
+    m_stats->init_histograms(s_Histogram, 1);
+    m_stats->set_name("http");
 }
 
 static std::string s_crossdomain;
@@ -71,8 +83,14 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
     {
     public:
         asyncInvoke(HttpHandler *pThis, Stream_base *stm, AsyncEvent *ac) :
-            AsyncState(ac), m_pThis(pThis), m_stm(stm)
+            AsyncState(ac), m_pThis(pThis), m_stm(stm), m_idle(false)
         {
+            obj_ptr<Stream_base> raw = stm;
+            obj_ptr<SslSocket_base> ss = SslSocket_base::getInstance(stm);
+            if (ss)
+                raw = ((SslSocket *)(SslSocket_base *)ss)->stream();
+            m_sock = (Socket *)Socket_base::getInstance(raw);
+
             m_stmBuffered = new BufferedStream(stm);
             m_stmBuffered->set_EOL("\r\n");
 
@@ -84,10 +102,21 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
 
             m_req->set_maxHeadersCount(pThis->m_maxHeadersCount);
             m_req->set_maxUploadSize(pThis->m_maxUploadSize);
+            m_req->set_maxPartSize(pThis->m_maxPartSize);
+            m_req->set_streamUpload(pThis->m_streamUpload);
 
             set(read);
         }
 
+        ~asyncInvoke()
+        {
+            if (m_sock && m_idle)
+            {
+                m_sock->set_deadline(0);
+                m_sock->set_timeout(0);
+            }
+        }
+
         static int32_t read(AsyncState *pState, int32_t n)
         {
             asyncInvoke *pThis = (asyncInvoke *) pState;
@@ -100,6 +129,59 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
             pThis->m_zip.Release();
             pThis->m_body.Release();
 
+            if (pThis->m_sock)
+            {
+                HttpHandler *hdlr = pThis->m_pThis;
+                BufferedStream *bs = pThis->m_stmBuffered;
+
+                // a keep-alive connection waits for the first byte of the
+                // next request under idleTimeout, the request itself is
+                // bounded by timeout as a whole in wait()
+                if (pThis->m_idle && (hdlr->m_timeout || hdlr->m_idleTimeout)
+                        && bs->m_pos >= (int32_t)bs->m_buf.length())
+                {
+                    pThis->m_sock->set_timeout(hdlr->m_idleTimeout ?
+                                               hdlr->m_idleTimeout : hdlr->m_timeout);
+                    pThis->set(idle);
+                    return pThis->m_stm->read(-1, pThis->m_first, pThis);
+                }
+            }
+
+            return wait(pThis, 0);
+        }
+
+        static int32_t idle(AsyncState *pState, int32_t n)
+        {
+            asyncInvoke *pThis = (asyncInvoke *) pState;
+
+            if (n == CALL_RETURN_NULL)
+                return pThis->done(CALL_RETURN_NULL);
+
+            BufferedStream *bs = pThis->m_stmBuffered;
+
+            pThis->m_first->toString(bs->m_buf);
+            bs->m_pos = 0;
+            pThis->m_first.Release();
+
+            return wait(pThis, 0);
+        }
+
+        static int32_t wait(AsyncState *pState, int32_t n)
+        {
+            asyncInvoke *pThis = (asyncInvoke *) pState;
+
+            if (pThis->m_sock)
+            {
+                HttpHandler *hdlr = pThis->m_pThis;
+
+                if (hdlr->m_timeout || hdlr->m_idleTimeout)
+                {
+                    pThis->m_sock->set_timeout(0);
+                    pThis->m_sock->set_deadline(hdlr->m_timeout);
+                    pThis->m_idle = true;
+                }
+            }
+
             pThis->set(invoke);
             return pThis->m_req->readFrom(pThis->m_stmBuffered, pThis);
         }
@@ -108,6 +190,9 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
         {
             asyncInvoke *pThis = (asyncInvoke *) pState;
 
+            if (pThis->m_sock)
+                pThis->m_sock->set_deadline(0);
+
             if (n == CALL_RETURN_NULL)
                 return pThis->done(CALL_RETURN_NULL);
 
@@ -200,6 +285,7 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
 
             d.now();
             pThis->m_pThis->m_stats->add(HTTP_TOTAL_TIME, (int32_t)d.diff(pThis->m_d));
+            pThis->m_pThis->m_stats->record(HTTP_LATENCY, (int64_t)(d.diff(pThis->m_d) * 1000));
 
             pThis->m_rep->get_status(s);
             if (s == 200)
@@ -280,6 +366,15 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
                         pThis->m_rep->addHeader("Content-Encoding",
                                                 type == 1 ? "gzip" : "deflate");
 
+                        if (pThis->m_rep->firstHeader("Vary", hdr) == CALL_RETURN_NULL)
+                            pThis->m_rep->setHeader("Vary", "Accept-Encoding");
+                        else
+                        {
+                            str = hdr.string();
+                            if (str != "*" && !qstristr(str.c_str(), "Accept-Encoding"))
+                                pThis->m_rep->setHeader("Vary", str + ", Accept-Encoding");
+                        }
+
                         pThis->m_rep->get_body(pThis->m_body);
                         pThis->m_body->rewind();
 
@@ -330,6 +425,12 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
 
         virtual int32_t error(int32_t v)
         {
+            if (m_sock && is(invoke))
+                m_sock->set_deadline(0);
+
+            if (v == SOCKET_E_TIMEOUT && (is(idle) || is(invoke)))
+                return done(CALL_RETURN_NULL);
+
             m_pThis->m_stats->inc(HTTP_ERROR);
 
             if (is(send))
@@ -359,12 +460,15 @@ result_t HttpHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
     private:
         obj_ptr<HttpHandler> m_pThis;
         obj_ptr<Stream_base> m_stm;
-        obj_ptr<BufferedStream_base> m_stmBuffered;
+        obj_ptr<Socket> m_sock;
+        obj_ptr<BufferedStream> m_stmBuffered;
         obj_ptr<HttpRequest_base> m_req;
         obj_ptr<HttpResponse_base> m_rep;
         obj_ptr<MemoryStream> m_zip;
         obj_ptr<SeekableStream_base> m_body;
+        obj_ptr<Buffer_base> m_first;
         date_t m_d;
+        bool m_idle;
     };
 
     if (!ac)
@@ -439,6 +543,63 @@ result_t HttpHandler::set_maxUploadSize(int32_t newVal)
     return 0;
 }
 
+result_t HttpHandler::get_maxPartSize(int32_t &retVal)
+{
+    retVal = m_maxPartSize;
+    return 0;
+}
+
+result_t HttpHandler::set_maxPartSize(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxPartSize = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_streamUpload(bool &retVal)
+{
+    retVal = m_streamUpload;
+    return 0;
+}
+
+result_t HttpHandler::set_streamUpload(bool newVal)
+{
+    m_streamUpload = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_timeout(int32_t &retVal)
+{
+    retVal = m_timeout;
+    return 0;
+}
+
+result_t HttpHandler::set_timeout(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_timeout = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_idleTimeout(int32_t &retVal)
+{
+    retVal = m_idleTimeout;
+    return 0;
+}
+
+result_t HttpHandler::set_idleTimeout(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_idleTimeout = newVal;
+    return 0;
+}
+
 result_t HttpHandler::get_handler(obj_ptr<Handler_base> &retVal)
 {
     retVal = m_hdlr;
@@ -209,16 +209,16 @@ result_t HttpMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
                 if (pThis->m_contentLength)
                     return CHECK_ERROR(CALL_E_INVALID_DATA);
 
-                pThis->m_pThis->get_body(pThis->m_body);
+                pThis->open_body();
                 return chunk_head(pState, n);
             }
 
             if (pThis->m_contentLength > 0)
             {
-                pThis->m_pThis->get_body(pThis->m_body);
+                pThis->open_body();
 
                 pThis->set(body);
-                return pThis->m_stm->copyTo(pThis->m_body,
+                return pThis->m_stm->copyTo(pThis->m_out,
                                             pThis->m_contentLength, pThis->m_copySize, pThis);
             }
 
@@ -232,9 +232,7 @@ result_t HttpMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
             if (pThis->m_contentLength != pThis->m_copySize)
                 return CHECK_ERROR(Runtime::setError("HttpMessage: body is not complate."));
 
-            pThis->m_body->rewind();
-
-            return pThis->done();
+            return pThis->done(pThis->close_body());
         }
 
         static int32_t chunk_head(AsyncState *pState, int32_t n)
@@ -267,7 +265,7 @@ result_t HttpMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
                 }
 
                 pThis->set(chunk_body_end);
-                return pThis->m_stm->copyTo(pThis->m_body, sz,
+                return pThis->m_stm->copyTo(pThis->m_out, sz,
                                             pThis->m_copySize, pThis);
             }
 
@@ -288,16 +286,56 @@ result_t HttpMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
         static int32_t chunk_end(AsyncState *pState, int32_t n)
         {
             asyncReadFrom *pThis = (asyncReadFrom *) pState;
+            return pThis->done(pThis->close_body());
+        }
 
-            pThis->m_body->rewind();
+    private:
+        void open_body()
+        {
+            if (!m_pThis->m_bResponse && m_pThis->m_streamUpload)
+            {
+                Variant v;
 
-            return pThis->done();
+                if (m_pThis->firstHeader("Content-Type", v) != CALL_RETURN_NULL)
+                {
+                    std::string strType = v.string();
+
+                    if (!qstricmp(strType.c_str(), "multipart/form-data;", 20))
+                    {
+                        obj_ptr<HttpUploadCollection> col = new HttpUploadCollection();
+                        obj_ptr<HttpUploadCollection::UploadStream> stm =
+                            new HttpUploadCollection::UploadStream(col, m_pThis->m_maxPartSize);
+
+                        if (stm->init(strType.c_str()))
+                        {
+                            m_pThis->m_upload = col;
+                            m_upload = stm;
+                            m_out = stm;
+                            return;
+                        }
+                    }
+                }
+            }
+
+            m_pThis->get_body(m_body);
+            m_out = m_body;
+        }
+
+        result_t close_body()
+        {
+            if (m_upload)
+                return m_upload->end();
+
+            m_body->rewind();
+            return 0;
         }
 
     public:
         HttpMessage *m_pThis;
         obj_ptr<BufferedStream_base> m_stm;
         obj_ptr<SeekableStream_base> m_body;
+        obj_ptr<HttpUploadCollection::UploadStream> m_upload;
+        obj_ptr<Stream_base> m_out;
         std::string m_strLine;
         int64_t m_contentLength;
         bool m_bChunked;
@@ -512,6 +550,33 @@ result_t HttpMessage::set_maxUploadSize(int32_t newVal)
     return 0;
 }
 
+result_t HttpMessage::get_maxPartSize(int32_t &retVal)
+{
+    retVal = m_maxPartSize;
+    return 0;
+}
+
+result_t HttpMessage::set_maxPartSize(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxPartSize = newVal;
+    return 0;
+}
+
+result_t HttpMessage::get_streamUpload(bool &retVal)
+{
+    retVal = m_streamUpload;
+    return 0;
+}
+
+result_t HttpMessage::set_streamUpload(bool newVal)
+{
+    m_streamUpload = newVal;
+    return 0;
+}
+
 result_t HttpMessage::hasHeader(const char *name, bool &retVal)
 {
     return m_headers->has(name, retVal);
@@ -575,6 +640,7 @@ result_t HttpMessage::clear()
     m_headers->clear();
 
     m_stm.Release();
+    m_upload.Release();
 
     return 0;
 }
@@ -0,0 +1,67 @@
+/*
+ * HttpMetricsHandler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/http.h"
+#include "HttpMetricsHandler.h"
+#include "HttpRequest.h"
+#include "MemoryStream.h"
+#include "Buffer.h"
+#include "Metrics.h"
+
+namespace fibjs
+{
+
+result_t http_base::metricsHandler(obj_ptr<Handler_base> &retVal)
+{
+    retVal = new HttpMetricsHandler();
+    return 0;
+}
+
+result_t HttpMetricsHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
+                                    AsyncEvent *ac)
+{
+    obj_ptr<HttpRequest_base> req = HttpRequest_base::getInstance(v);
+    obj_ptr<Message_base> m;
+    obj_ptr<HttpResponse_base> rep;
+    bool bOpenMetrics = false;
+    std::string strBuf;
+    Variant hdr;
+
+    if (req == NULL)
+        return CHECK_ERROR(CALL_E_BADVARTYPE);
+
+    req->get_response(m);
+    rep = (HttpResponse_base *)(Message_base *)m;
+
+    if (req->firstHeader("Accept", hdr) != CALL_RETURN_NULL)
+    {
+        std::string str = hdr.string();
+
+        if (qstristr(str.c_str(), "application/openmetrics-text"))
+            bOpenMetrics = true;
+    }
+
+    strBuf.reserve(m_size + m_size / 4);
+    Metrics::render(strBuf, bOpenMetrics);
+    m_size = strBuf.length();
+
+    obj_ptr<MemoryStream> body = new MemoryStream();
+    obj_ptr<Buffer> buf = new Buffer(strBuf);
+
+    rep->set_body(body);
+    body->write(buf, NULL);
+
+    if (bOpenMetrics)
+        rep->setHeader("Content-Type",
+                       "application/openmetrics-text; version=1.0.0; charset=utf-8");
+    else
+        rep->setHeader("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+
+    return CALL_RETURN_NULL;
+}
+
+} /* namespace fibjs */
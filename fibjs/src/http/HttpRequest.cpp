@@ -102,7 +102,27 @@ result_t HttpRequest::get_maxUploadSize(int32_t &retVal)
 
 result_t HttpRequest::set_maxUploadSize(int32_t newVal)
 {
-    return m_message.get_maxUploadSize(newVal);
+    return m_message.set_maxUploadSize(newVal);
+}
+
+result_t HttpRequest::get_maxPartSize(int32_t &retVal)
+{
+    return m_message.get_maxPartSize(retVal);
+}
+
+result_t HttpRequest::set_maxPartSize(int32_t newVal)
+{
+    return m_message.set_maxPartSize(newVal);
+}
+
+result_t HttpRequest::get_streamUpload(bool &retVal)
+{
+    return m_message.get_streamUpload(retVal);
+}
+
+result_t HttpRequest::set_streamUpload(bool newVal)
+{
+    return m_message.set_streamUpload(newVal);
 }
 
 result_t HttpRequest::hasHeader(const char *name, bool &retVal)
@@ -428,6 +448,9 @@ result_t HttpRequest::get_cookies(obj_ptr<HttpCollection_base> &retVal)
 
 result_t HttpRequest::get_form(obj_ptr<HttpCollection_base> &retVal)
 {
+    if (m_form == NULL && m_message.m_upload)
+        m_form = m_message.m_upload;
+
     if (m_form == NULL)
     {
         int64_t len = 0;
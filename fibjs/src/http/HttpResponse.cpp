@@ -102,7 +102,27 @@ result_t HttpResponse::get_maxUploadSize(int32_t &retVal)
 
 result_t HttpResponse::set_maxUploadSize(int32_t newVal)
 {
-    return m_message.get_maxUploadSize(newVal);
+    return m_message.set_maxUploadSize(newVal);
+}
+
+result_t HttpResponse::get_maxPartSize(int32_t &retVal)
+{
+    return m_message.get_maxPartSize(retVal);
+}
+
+result_t HttpResponse::set_maxPartSize(int32_t newVal)
+{
+    return m_message.set_maxPartSize(newVal);
+}
+
+result_t HttpResponse::get_streamUpload(bool &retVal)
+{
+    return m_message.get_streamUpload(retVal);
+}
+
+result_t HttpResponse::set_streamUpload(bool newVal)
+{
+    return m_message.set_streamUpload(newVal);
 }
 
 result_t HttpResponse::hasHeader(const char *name, bool &retVal)
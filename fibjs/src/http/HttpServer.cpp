@@ -8,6 +8,7 @@
 #include "HttpServer.h"
 #include "ifs/http.h"
 #include "JSHandler.h"
+#include "LimitHandler.h"
 
 namespace fibjs
 {
@@ -91,6 +92,11 @@ result_t HttpServer::set_handler(Handler_base *newVal)
     return m_handler->set_handler(newVal);
 }
 
+result_t HttpServer::limit(v8::Local<v8::Object> opts, obj_ptr<LimitHandler_base> &retVal)
+{
+    return LimitHandler::limit(this, opts, retVal);
+}
+
 result_t HttpServer::get_crossDomain(bool &retVal)
 {
     return m_handler->get_crossDomain(retVal);
@@ -131,6 +137,46 @@ result_t HttpServer::set_maxUploadSize(int32_t newVal)
     return m_handler->set_maxUploadSize(newVal);;
 }
 
+result_t HttpServer::get_maxPartSize(int32_t &retVal)
+{
+    return m_handler->get_maxPartSize(retVal);
+}
+
+result_t HttpServer::set_maxPartSize(int32_t newVal)
+{
+    return m_handler->set_maxPartSize(newVal);
+}
+
+result_t HttpServer::get_streamUpload(bool &retVal)
+{
+    return m_handler->get_streamUpload(retVal);
+}
+
+result_t HttpServer::set_streamUpload(bool newVal)
+{
+    return m_handler->set_streamUpload(newVal);
+}
+
+result_t HttpServer::get_timeout(int32_t &retVal)
+{
+    return m_handler->get_timeout(retVal);
+}
+
+result_t HttpServer::set_timeout(int32_t newVal)
+{
+    return m_handler->set_timeout(newVal);
+}
+
+result_t HttpServer::get_idleTimeout(int32_t &retVal)
+{
+    return m_handler->get_idleTimeout(retVal);
+}
+
+result_t HttpServer::set_idleTimeout(int32_t newVal)
+{
+    return m_handler->set_idleTimeout(newVal);
+}
+
 result_t HttpServer::get_httpStats(obj_ptr<Stats_base> &retVal)
 {
     return m_handler->get_stats(retVal);
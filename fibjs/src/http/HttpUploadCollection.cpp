@@ -7,6 +7,7 @@
 
 #include "HttpUploadCollection.h"
 #include "HttpUploadData.h"
+#include "HttpMessage.h"
 #include "MemoryStream.h"
 #include "List.h"
 #include "Map.h"
@@ -15,215 +16,362 @@
 namespace fibjs
 {
 
-void HttpUploadCollection::parse(std::string &str, const char *boundary)
+#define UPLOAD_SPOOL_SIZE   65536
+
+enum
 {
-    const char *pstr = str.c_str();
-    int32_t nSize = (int32_t) str.length();
-    std::string strName;
-    std::string strFileName;
-    std::string strContentType;
-    std::string strContentTransferEncoding;
-    const char *p, *p1, *p2, *szQueryString;
-    const char *pstrSplit;
-    int32_t uiSplitSize;
-    char ch;
+    UPLOAD_START = 0, UPLOAD_BOUNDARY, UPLOAD_HEADER, UPLOAD_BODY, UPLOAD_END
+};
 
+bool HttpUploadCollection::UploadStream::init(const char *boundary)
+{
     boundary += 20;
     while (*boundary && *boundary == ' ')
         boundary++;
 
     if (qstricmp(boundary, "boundary=", 9))
-        return;
+        return false;
 
     boundary += 9;
-    uiSplitSize = (int32_t) qstrlen(boundary);
+    if (!*boundary)
+        return false;
 
-    pstrSplit = szQueryString = pstr;
+    m_boundary.assign("\n--", 3);
+    m_boundary.append(boundary);
 
-    if (nSize < uiSplitSize + 2 || szQueryString[0] != '-'
-            || szQueryString[1] != '-'
-            || qstrcmp(szQueryString + 2, boundary, uiSplitSize))
-        return;
+    return true;
+}
 
-    uiSplitSize += 2;
-    szQueryString += uiSplitSize;
-    nSize -= uiSplitSize;
+result_t HttpUploadCollection::UploadStream::feed(const char *data, int32_t sz)
+{
+    if (m_state == UPLOAD_END)
+        return 0;
+
+    m_buf.append(data, sz);
+    return parse();
+}
 
-    while (nSize)
+result_t HttpUploadCollection::UploadStream::end()
+{
+    m_state = UPLOAD_END;
+    m_buf.clear();
+    m_value.clear();
+    m_file.Release();
+
+    return 0;
+}
+
+bool HttpUploadCollection::UploadStream::header(const char *p1, const char *p)
+{
+    const char *p2;
+    char ch;
+
+    if (p1 + 20 < p && !qstricmp(p1, "Content-Disposition:", 20))
     {
-        strFileName.clear();
-        strContentType.clear();
-        strContentTransferEncoding.clear();
+        p1 += 20;
+        while (p1 < p && *p1 == ' ')
+            p1++;
+        if (p1 + 10 >= p || qstricmp(p1, "form-data;", 10))
+            return false;
+
+        p1 += 10;
+        while (p1 < p && *p1 == ' ')
+            p1++;
+        if (p1 + 5 >= p || qstricmp(p1, "name=", 5))
+            return false;
 
-        while (nSize > 0)
+        p1 += 5;
+
+        while (p1 < p && *p1 == ' ')
+            p1++;
+
+        ch = ';';
+        if (*p1 == '\"')
         {
-            ch = *szQueryString++;
-            nSize--;
-            if (ch != '\r')
-                return;
-            if (nSize > 0 && *szQueryString == '\n')
+            p1++;
+            ch = '\"';
+        }
+
+        p2 = p1;
+        while (p1 < p && *p1 != ch)
+            p1++;
+
+        m_name.assign(p2, (int32_t) (p1 - p2));
+
+        if (p1 < p && *p1 == '\"')
+            p1++;
+
+        if (p1 < p && *p1 == ';')
+            p1++;
+
+        while (p1 < p && *p1 == ' ')
+            p1++;
+
+        if (p1 + 9 < p && !qstricmp(p1, "filename=", 9))
+        {
+            p1 += 9;
+
+            while (p1 < p && *p1 == ' ')
+                p1++;
+
+            ch = ';';
+            if (*p1 == '\"')
             {
-                nSize--;
-                szQueryString++;
+                p1++;
+                ch = '\"';
             }
 
-            p = szQueryString;
-            while (nSize > 0 && *p != '\r')
+            p2 = p1;
+            while (p1 < p && *p1 != ch)
             {
-                nSize--;
-                p++;
+                if (*p1 == '/' || *p1 == '\\')
+                    p2 = p1 + 1;
+                p1++;
             }
 
-            if (nSize == 0)
-                break;
+            m_fileName.assign(p2, (int32_t) (p1 - p2));
+        }
+    }
+    else if (p1 + 13 < p && !qstricmp(p1, "Content-Type:", 13))
+    {
+        p1 += 13;
+        while (p1 < p && *p1 == ' ')
+            p1++;
+        m_contentType.assign(p1, (int32_t) (p - p1));
+    }
+    else if (p1 + 26 < p && !qstricmp(p1, "Content-Transfer-Encoding:", 26))
+    {
+        p1 += 26;
+        while (p1 < p && *p1 == ' ')
+            p1++;
+        m_contentTransferEncoding.assign(p1, (int32_t) (p - p1));
+    }
+
+    return true;
+}
+
+result_t HttpUploadCollection::UploadStream::append(const char *p, int32_t sz)
+{
+    result_t hr;
+
+    m_size += sz;
+    if (m_size > m_maxPartSize)
+        return CHECK_ERROR(Runtime::setError("HttpUploadCollection: part is too huge."));
+
+    if (m_name.empty() || !sz)
+        return 0;
+
+    if (m_file)
+        return m_file->Write(p, sz);
+
+    m_value.append(p, sz);
+
+    if (!m_fileName.empty() && m_value.length() > UPLOAD_SPOOL_SIZE)
+    {
+        m_file = new File();
+
+        hr = m_file->tmpFile();
+        if (hr < 0)
+            return hr;
+
+        hr = m_file->Write(m_value.c_str(), (int32_t) m_value.length());
+        if (hr < 0)
+            return hr;
+
+        m_value.clear();
+    }
+
+    return 0;
+}
+
+result_t HttpUploadCollection::UploadStream::endPart()
+{
+    result_t hr;
+    Variant varTemp;
+
+    if (m_name.empty())
+        return 0;
+
+    if (m_fileName.empty())
+        varTemp = m_value;
+    else
+    {
+        obj_ptr<HttpUploadData> objTemp = new HttpUploadData();
+
+        objTemp->m_name = m_fileName;
+        objTemp->m_type = m_contentType;
+        objTemp->m_encoding = m_contentTransferEncoding;
+
+        if (m_file)
+        {
+            hr = m_file->rewind();
+            if (hr < 0)
+                return hr;
+
+            objTemp->m_body = m_file;
+            m_file.Release();
+        }
+        else
+        {
+            date_t tm;
+            objTemp->m_body = new MemoryStream::CloneStream(m_value, tm);
+        }
 
-            p1 = szQueryString;
-            szQueryString = p;
+        varTemp = objTemp;
+    }
+
+    m_value.clear();
 
-            if (p != p1)
+    return m_col->add(m_name.c_str(), varTemp);
+}
+
+result_t HttpUploadCollection::UploadStream::parse()
+{
+    const char *pstr = m_buf.c_str();
+    size_t nSize = m_buf.length();
+    size_t nSplit = m_boundary.length();
+    size_t pos = 0;
+    result_t hr;
+
+    while (pos < nSize && m_state != UPLOAD_END)
+    {
+        if (m_state == UPLOAD_START)
+        {
+            if (nSize - pos < nSplit - 1)
+                break;
+
+            if (memcmp(pstr + pos, m_boundary.c_str() + 1, nSplit - 1))
             {
-                if (p1 + 20 < p && !qstricmp(p1, "Content-Disposition:", 20))
-                {
-                    p1 += 20;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    if (p1 + 10 >= p || qstricmp(p1, "form-data;", 10))
-                        return;
-
-                    p1 += 10;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    if (p1 + 5 >= p || qstricmp(p1, "name=", 5))
-                        return;
-
-                    p1 += 5;
-
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-
-                    ch = ';';
-                    if (*p1 == '\"')
-                    {
-                        p1++;
-                        ch = '\"';
-                    }
-
-                    p2 = p1;
-                    while (p1 < p && *p1 != ch)
-                        p1++;
-
-                    strName.assign(p2, (int32_t) (p1 - p2));
-
-                    if (p1 < p && *p1 == '\"')
-                        p1++;
-
-                    if (p1 < p && *p1 == ';')
-                        p1++;
-
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-
-                    if (p1 + 9 < p && !qstricmp(p1, "filename=", 9))
-                    {
-                        p1 += 9;
-
-                        while (p1 < p && *p1 == ' ')
-                            p1++;
-
-                        ch = ';';
-                        if (*p1 == '\"')
-                        {
-                            p1++;
-                            ch = '\"';
-                        }
-
-                        p2 = p1;
-                        while (p1 < p && *p1 != ch)
-                        {
-                            if (*p1 == '/' || *p1 == '\\')
-                                p2 = p1 + 1;
-                            p1++;
-                        }
-
-                        strFileName.assign(p2, (int32_t) (p1 - p2));
-                    }
-                }
-                else if (p1 + 13 < p && !qstricmp(p1, "Content-Type:", 13))
-                {
-                    p1 += 13;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    strContentType.assign(p1, (int32_t) (p - p1));
-                }
-                else if (p1 + 26 < p && !qstricmp(p1, "Content-Transfer-Encoding:", 26))
-                {
-                    p1 += 26;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    strContentTransferEncoding.assign(p1, (int32_t) (p - p1));
-                }
+                m_state = UPLOAD_END;
+                break;
             }
-            else
+
+            pos += nSplit - 1;
+            m_state = UPLOAD_BOUNDARY;
+        }
+        else if (m_state == UPLOAD_BOUNDARY)
+        {
+            if (nSize - pos < 2)
+                break;
+
+            if (pstr[pos] != '\r')
             {
-                ch = *szQueryString++;
-                nSize--;
-                if (ch != '\r')
-                    return;
-                if (nSize > 0 && *szQueryString == '\n')
-                {
-                    nSize--;
-                    szQueryString++;
-                }
+                m_state = UPLOAD_END;
                 break;
             }
-        }
 
-        p = szQueryString;
-        p1 = p + nSize;
-        while (p1 > p && (p = (char *) memchr(p, '-', p1 - p))
-                && p1 > p + uiSplitSize && memcmp(p, pstrSplit, uiSplitSize))
-            p++;
+            pos++;
+            if (pstr[pos] == '\n')
+                pos++;
 
-        if (!p || p1 <= p + uiSplitSize)
-            break;
+            m_name.clear();
+            m_fileName.clear();
+            m_contentType.clear();
+            m_contentTransferEncoding.clear();
 
-        nSize = (int32_t) (p1 - p - uiSplitSize);
-        p1 = szQueryString;
-        szQueryString = p + uiSplitSize;
+            m_state = UPLOAD_HEADER;
+        }
+        else if (m_state == UPLOAD_HEADER)
+        {
+            const char *p = (const char *) memchr(pstr + pos, '\n', nSize - pos);
+            const char *p1 = pstr + pos;
 
-        p--;
-        ch = *p;
-        if (ch != '\n')
-            return;
-        if (*(p - 1) == '\r')
-            p--;
+            if (!p)
+            {
+                if (nSize - pos > HTTP_MAX_LINE)
+                    return CHECK_ERROR(Runtime::setError("HttpUploadCollection: header is too long."));
+                break;
+            }
 
-        if (!strName.empty())
-        {
-            int32_t uiSize = (int32_t) (p - p1);
-            std::string strTemp;
-            Variant varTemp;
+            pos = p - pstr + 1;
 
-            strTemp.assign(p1, uiSize);
+            if (p > p1 && p[-1] == '\r')
+                p--;
 
-            if (strFileName.empty())
-                varTemp = strTemp;
-            else
+            if (p == p1)
             {
-                obj_ptr<HttpUploadData> objTemp = new HttpUploadData();
-                date_t tm;
+                m_size = 0;
+                m_state = UPLOAD_BODY;
+            }
+            else if (!header(p1, p))
+                m_state = UPLOAD_END;
+        }
+        else
+        {
+            size_t n = m_buf.find(m_boundary, pos);
 
-                objTemp->m_name = strFileName;
-                objTemp->m_type = strContentType;
-                objTemp->m_encoding = strContentTransferEncoding;
-                objTemp->m_body = new MemoryStream::CloneStream(strTemp, tm);
+            if (n == std::string::npos)
+            {
+                if (nSize - pos > nSplit)
+                {
+                    hr = append(pstr + pos, (int32_t) (nSize - pos - nSplit));
+                    if (hr < 0)
+                        return hr;
 
-                varTemp = objTemp;
+                    pos = nSize - nSplit;
+                }
+                break;
             }
 
-            add(strName.c_str(), varTemp);
+            size_t n1 = n;
+            if (n1 > pos && pstr[n1 - 1] == '\r')
+                n1--;
+
+            hr = append(pstr + pos, (int32_t) (n1 - pos));
+            if (hr < 0)
+                return hr;
+
+            hr = endPart();
+            if (hr < 0)
+                return hr;
+
+            pos = n + nSplit;
+            m_state = UPLOAD_BOUNDARY;
         }
     }
+
+    if (m_state == UPLOAD_END)
+        m_buf.clear();
+    else
+        m_buf.erase(0, pos);
+
+    return 0;
+}
+
+result_t HttpUploadCollection::UploadStream::read(int32_t bytes, obj_ptr<Buffer_base> &retVal,
+        AsyncEvent *ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t HttpUploadCollection::UploadStream::write(Buffer_base *data, AsyncEvent *ac)
+{
+    std::string strBuf;
+
+    data->toString(strBuf);
+    return feed(strBuf.c_str(), (int32_t) strBuf.length());
+}
+
+result_t HttpUploadCollection::UploadStream::close(AsyncEvent *ac)
+{
+    return end();
+}
+
+result_t HttpUploadCollection::UploadStream::copyTo(Stream_base *stm, int64_t bytes,
+        int64_t &retVal, AsyncEvent *ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+void HttpUploadCollection::parse(std::string &str, const char *boundary)
+{
+    obj_ptr<UploadStream> stm = new UploadStream(this, (int32_t) str.length());
+
+    if (stm->init(boundary))
+    {
+        stm->feed(str.c_str(), (int32_t) str.length());
+        stm->end();
+    }
 }
 
 result_t HttpUploadCollection::clear()
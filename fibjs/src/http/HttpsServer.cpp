@@ -8,6 +8,7 @@
 #include "HttpsServer.h"
 #include "ifs/http.h"
 #include "JSHandler.h"
+#include "LimitHandler.h"
 
 namespace fibjs
 {
@@ -142,6 +143,11 @@ result_t HttpsServer::set_handler(Handler_base *newVal)
     return m_handler->set_handler(newVal);
 }
 
+result_t HttpsServer::limit(v8::Local<v8::Object> opts, obj_ptr<LimitHandler_base> &retVal)
+{
+    return LimitHandler::limit(this, opts, retVal);
+}
+
 result_t HttpsServer::get_crossDomain(bool &retVal)
 {
     return m_handler->get_crossDomain(retVal);
@@ -182,6 +188,26 @@ result_t HttpsServer::set_maxUploadSize(int32_t newVal)
     return m_handler->set_maxUploadSize(newVal);;
 }
 
+result_t HttpsServer::get_maxPartSize(int32_t &retVal)
+{
+    return m_handler->get_maxPartSize(retVal);
+}
+
+result_t HttpsServer::set_maxPartSize(int32_t newVal)
+{
+    return m_handler->set_maxPartSize(newVal);
+}
+
+result_t HttpsServer::get_streamUpload(bool &retVal)
+{
+    return m_handler->get_streamUpload(retVal);
+}
+
+result_t HttpsServer::set_streamUpload(bool newVal)
+{
+    return m_handler->set_streamUpload(newVal);
+}
+
 result_t HttpsServer::get_verification(int32_t &retVal)
 {
     return m_server->get_verification(retVal);
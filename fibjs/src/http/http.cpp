@@ -12,6 +12,7 @@
 #include "Map.h"
 #include "HttpRequest.h"
 #include "BufferedStream.h"
+#include "HttpAgent.h"
 #include "map"
 #include "ifs/zlib.h"
 
@@ -121,7 +122,8 @@ result_t http_base::request(const char* method, const char* url,
                      SeekableStream_base* body, Map_base* headers,
                      obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac) :
             AsyncState(ac), m_method(method), m_url(url), m_body(body),
-            m_headers(headers), m_retVal(retVal)
+            m_headers(headers), m_retVal(retVal), m_uses(0),
+            m_acquired(false), m_reused(false), m_retried(false)
         {
             set(prepare);
         }
@@ -179,7 +181,26 @@ result_t http_base::request(const char* method, const char* url,
             if (pThis->m_body)
                 pThis->m_req->set_body(pThis->m_body);
 
+            pThis->set(acquired);
+            return HttpAgent::acquire(pThis->m_connUrl, pThis->m_conn,
+                                      pThis->m_uses, pThis);
+        }
+
+        static int32_t acquired(AsyncState *pState, int32_t n)
+        {
+            asyncRequest *pThis = (asyncRequest *) pState;
+
+            pThis->m_acquired = true;
             pThis->set(connected);
+
+            if (pThis->m_conn)
+            {
+                pThis->m_reused = true;
+                return 0;
+            }
+
+            pThis->m_reused = false;
+            pThis->m_uses = 0;
             return net_base::connect(pThis->m_connUrl.c_str(), pThis->m_conn, pThis);
         }
 
@@ -187,6 +208,8 @@ result_t http_base::request(const char* method, const char* url,
         {
             asyncRequest *pThis = (asyncRequest *) pState;
 
+            pThis->m_uses ++;
+
             pThis->set(requested);
             return request(pThis->m_conn, pThis->m_req, pThis->m_retVal, pThis);
         }
@@ -194,12 +217,25 @@ result_t http_base::request(const char* method, const char* url,
         static int32_t requested(AsyncState *pState, int32_t n)
         {
             asyncRequest *pThis = (asyncRequest *) pState;
+            bool upgrade, keepAlive = false;
 
             pThis->set(closed);
+            pThis->m_acquired = false;
 
-            bool upgrade;
             pThis->m_retVal->get_upgrade(upgrade);
             if (upgrade)
+            {
+                HttpAgent::release(pThis->m_connUrl, NULL, 0);
+                return 0;
+            }
+
+            pThis->m_retVal->get_keepAlive(keepAlive);
+            if (keepAlive)
+                pThis->m_req->get_keepAlive(keepAlive);
+
+            if (HttpAgent::release(pThis->m_connUrl,
+                                   keepAlive ? (Stream_base *)pThis->m_conn : NULL,
+                                   pThis->m_uses))
                 return 0;
 
             return pThis->m_conn->close(pThis);
@@ -231,11 +267,46 @@ result_t http_base::request(const char* method, const char* url,
                 return CHECK_ERROR(Runtime::setError("http: redirect cycle"));
 
             pThis->m_url = location;
+            pThis->m_conn.Release();
+            pThis->m_retried = false;
 
             pThis->set(prepare);
             return 0;
         }
 
+        virtual int32_t error(int32_t v)
+        {
+            if (!m_acquired)
+                return v;
+
+            // the server may have closed a pooled connection while it was
+            // idle, try once more on a new connection. a request that is not
+            // idempotent may already have taken effect, so it is not resent
+            if (m_reused && !m_retried && is(requested) && idempotent())
+            {
+                m_retried = true;
+                m_conn.Release();
+
+                set(acquired);
+                return 0;
+            }
+
+            m_acquired = false;
+            HttpAgent::release(m_connUrl, NULL, 0);
+
+            return v;
+        }
+
+    private:
+        bool idempotent()
+        {
+            const char *s = m_method.c_str();
+
+            return !qstricmp(s, "GET") || !qstricmp(s, "HEAD") ||
+                   !qstricmp(s, "PUT") || !qstricmp(s, "DELETE") ||
+                   !qstricmp(s, "OPTIONS") || !qstricmp(s, "TRACE");
+        }
+
     private:
         std::string m_method;
         std::string m_url;
@@ -246,6 +317,10 @@ result_t http_base::request(const char* method, const char* url,
         obj_ptr<Stream_base> m_conn;
         obj_ptr<HttpRequest> m_req;
         std::string m_connUrl;
+        int32_t m_uses;
+        bool m_acquired;
+        bool m_reused;
+        bool m_retried;
     };
 
     if (!ac)
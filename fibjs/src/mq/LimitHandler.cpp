@@ -0,0 +1,470 @@
+/*
+ * LimitHandler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/mq.h"
+#include "ifs/HttpRequest.h"
+#include "ifs/HttpResponse.h"
+#include "ifs/BufferedStream.h"
+#include "ifs/Socket.h"
+#include "SslSocket.h"
+#include "LimitHandler.h"
+#include "JSHandler.h"
+
+namespace fibjs
+{
+
+#define LIMIT_MAX_KEYS  10000
+
+static const char *s_staticCounter[] =
+{ "active", "queued" };
+static const char *s_Counter[] =
+{ "accepted", "rate_limited", "rejected", "timeout" };
+static const char *s_Histogram[] =
+{ "wait" };
+
+enum
+{
+    LIMIT_ACTIVE = 0,
+    LIMIT_QUEUED,
+    LIMIT_ACCEPTED,
+    LIMIT_RATE_LIMITED,
+    LIMIT_REJECTED,
+    LIMIT_TIMEOUT
+};
+
+enum
+{
+    LIMIT_WAIT = 0
+};
+
+result_t LimitHandler_base::_new(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts,
+                                 obj_ptr<LimitHandler_base> &retVal,
+                                 v8::Local<v8::Object> This)
+{
+    obj_ptr<LimitHandler> limit_hdlr = new LimitHandler();
+    limit_hdlr->wrap(This);
+
+    result_t hr = limit_hdlr->init(hdlr, opts);
+    if (hr < 0)
+        return hr;
+
+    retVal = limit_hdlr;
+
+    return 0;
+}
+
+result_t LimitHandler::limit(TcpServer_base *svr, v8::Local<v8::Object> opts,
+                             obj_ptr<LimitHandler_base> &retVal)
+{
+    obj_ptr<Handler_base> hdlr;
+    result_t hr;
+
+    hr = svr->get_handler(hdlr);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<LimitHandler> limit_hdlr = new LimitHandler();
+
+    hr = limit_hdlr->init(hdlr->wrap(), opts);
+    if (hr < 0)
+        return hr;
+
+    hr = svr->set_handler(limit_hdlr);
+    if (hr < 0)
+        return hr;
+
+    retVal = limit_hdlr;
+
+    return 0;
+}
+
+LimitHandler::LimitHandler() :
+    m_rate(0), m_burst(0), m_concurrency(0), m_queueSize(0),
+    m_queueTimeout(0), m_active(0)
+{
+    m_stats = new Stats();
+    m_stats->init(s_staticCounter, 2, s_Counter, 4);
+    m_stats->init_histograms(s_Histogram, 1);
+    m_stats->set_name("limit");
+}
+
+result_t LimitHandler::init(v8::Local<v8::Value> hdlr, v8::Local<v8::Object> opts)
+{
+    obj_ptr<Handler_base> hdlr1;
+    result_t hr = JSHandler::New(hdlr, hdlr1);
+    if (hr < 0)
+        return hr;
+
+    wrap()->SetHiddenValue(v8::String::NewFromUtf8(Isolate::now()->m_isolate, "handler"),
+                           hdlr1->wrap());
+    m_hdlr = hdlr1;
+
+    hr = GetConfigValue(opts, "rate", m_rate);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        m_rate = 0;
+    else if (hr < 0)
+        return hr;
+    else if (m_rate < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    hr = GetConfigValue(opts, "burst", m_burst);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        m_burst = m_rate;
+    else if (hr < 0)
+        return hr;
+    else if (m_burst < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    if (m_rate > 0 && m_burst < 1)
+        m_burst = 1;
+
+    hr = GetConfigValue(opts, "keyHeader", m_keyHeader);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+    {
+    }
+    else if (hr < 0)
+        return hr;
+
+    hr = GetConfigValue(opts, "concurrency", m_concurrency);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        m_concurrency = 0;
+    else if (hr < 0)
+        return hr;
+    else if (m_concurrency < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    hr = GetConfigValue(opts, "queueSize", m_queueSize);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        m_queueSize = 0;
+    else if (hr < 0)
+        return hr;
+    else if (m_queueSize < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    hr = GetConfigValue(opts, "queueTimeout", m_queueTimeout);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        m_queueTimeout = 0;
+    else if (hr < 0)
+        return hr;
+    else if (m_queueTimeout < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    return 0;
+}
+
+void LimitHandler::key(object_base *v, std::string &retVal)
+{
+    obj_ptr<Message_base> msg = Message_base::getInstance(v);
+    obj_ptr<Stream_base> stm;
+
+    if (!m_keyHeader.empty())
+    {
+        obj_ptr<HttpRequest_base> req = HttpRequest_base::getInstance(v);
+        Variant hdr;
+
+        if (req && req->firstHeader(m_keyHeader.c_str(), hdr) != CALL_RETURN_NULL)
+        {
+            retVal = hdr.string();
+            return;
+        }
+    }
+
+    if (msg)
+        msg->get_stream(stm);
+    else
+        stm = Stream_base::getInstance(v);
+
+    obj_ptr<BufferedStream_base> bs = BufferedStream_base::getInstance((Stream_base *)stm);
+    if (bs)
+        bs->get_stream(stm);
+
+    obj_ptr<SslSocket_base> ss = SslSocket_base::getInstance((Stream_base *)stm);
+    if (ss)
+        stm = ((SslSocket *)(SslSocket_base *)ss)->stream();
+
+    obj_ptr<Socket_base> sock = Socket_base::getInstance((Stream_base *)stm);
+    if (sock)
+        sock->get_remoteAddress(retVal);
+}
+
+bool LimitHandler::acquire(const std::string &key)
+{
+    std::map<std::string, Bucket>::iterator it;
+    bool bOk = false;
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+
+    it = m_buckets.find(key);
+    if (it == m_buckets.end())
+    {
+        // the least recently seen key has had the longest to refill, so it
+        // is the cheapest one to forget
+        if (m_buckets.size() >= LIMIT_MAX_KEYS)
+        {
+            m_buckets.erase(m_lru.front());
+            m_lru.pop_front();
+        }
+
+        it = m_buckets.insert(std::pair<std::string, Bucket>(key, Bucket())).first;
+
+        Bucket &b = it->second;
+
+        b.m_tokens = m_burst;
+        b.m_time = d;
+        b.m_lru = m_lru.insert(m_lru.end(), key);
+    }
+    else
+    {
+        Bucket &b = it->second;
+
+        b.m_tokens += d.diff(b.m_time) * m_rate / 1000;
+        if (b.m_tokens > m_burst)
+            b.m_tokens = m_burst;
+        b.m_time = d;
+        m_lru.splice(m_lru.end(), m_lru, b.m_lru);
+    }
+
+    if (it->second.m_tokens >= 1)
+    {
+        it->second.m_tokens -= 1;
+        bOk = true;
+    }
+
+    m_lock.unlock();
+
+    return bOk;
+}
+
+void LimitHandler::release()
+{
+    Waiter *w;
+    bool bFree;
+
+    m_lock.lock();
+
+    if (m_queue.empty())
+    {
+        m_active --;
+        m_stats->dec(LIMIT_ACTIVE);
+        m_lock.unlock();
+        return;
+    }
+
+    // hand the slot over to the oldest waiter, active count is unchanged
+    w = m_queue.front();
+    m_queue.pop_front();
+    m_stats->dec(LIMIT_QUEUED);
+
+    bFree = !w->m_timed || TimerWheel::cancel(w);
+    if (!bFree)
+        w->m_done = true;
+
+    AsyncState *pState = w->m_state;
+
+    m_lock.unlock();
+
+    if (bFree)
+        delete w;
+
+    pState->apost(0);
+}
+
+void LimitHandler::Waiter::timeout()
+{
+    obj_ptr<LimitHandler> pThis = m_pThis;
+
+    pThis->m_lock.lock();
+
+    if (m_done)
+    {
+        pThis->m_lock.unlock();
+        delete this;
+        return;
+    }
+
+    pThis->m_queue.erase(m_it);
+    pThis->m_stats->dec(LIMIT_QUEUED);
+
+    AsyncState *pState = m_state;
+
+    pThis->m_lock.unlock();
+
+    delete this;
+    pState->apost(1);
+}
+
+class LimitHandler::asyncInvoke: public AsyncState
+{
+public:
+    asyncInvoke(LimitHandler *pThis, object_base *v, AsyncEvent *ac) :
+        AsyncState(ac), m_pThis(pThis), m_v(v), m_bActive(false)
+    {
+        set(admit);
+    }
+
+    ~asyncInvoke()
+    {
+        if (m_bActive)
+            m_pThis->release();
+    }
+
+public:
+    static int32_t admit(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+        LimitHandler *hdlr = pThis->m_pThis;
+
+        if (hdlr->m_rate > 0)
+        {
+            std::string strKey;
+
+            hdlr->key(pThis->m_v, strKey);
+            if (!hdlr->acquire(strKey))
+            {
+                hdlr->m_stats->inc(LIMIT_RATE_LIMITED);
+                return pThis->reject(429);
+            }
+        }
+
+        pThis->set(invoke);
+        if (hdlr->m_concurrency == 0)
+            return 0;
+
+        hdlr->m_lock.lock();
+
+        if (hdlr->m_active < hdlr->m_concurrency)
+        {
+            hdlr->m_active ++;
+            hdlr->m_stats->inc(LIMIT_ACTIVE);
+            hdlr->m_lock.unlock();
+
+            pThis->m_bActive = true;
+            return 0;
+        }
+
+        if ((int32_t)hdlr->m_queue.size() >= hdlr->m_queueSize)
+        {
+            hdlr->m_lock.unlock();
+
+            hdlr->m_stats->inc(LIMIT_REJECTED);
+            return pThis->reject(503);
+        }
+
+        Waiter *w = new Waiter(hdlr, pThis);
+
+        w->m_it = hdlr->m_queue.insert(hdlr->m_queue.end(), w);
+        hdlr->m_stats->inc(LIMIT_QUEUED);
+
+        pThis->m_d.now();
+        pThis->set(queued);
+
+        if (hdlr->m_queueTimeout > 0)
+        {
+            w->m_timed = true;
+            TimerWheel::start(w, hdlr->m_queueTimeout);
+        }
+
+        hdlr->m_lock.unlock();
+
+        return CALL_E_PENDDING;
+    }
+
+    static int32_t queued(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+        date_t d;
+
+        d.now();
+        pThis->m_pThis->m_stats->record(LIMIT_WAIT, (int64_t)(d.diff(pThis->m_d) * 1000));
+
+        if (n == 1)
+        {
+            pThis->m_pThis->m_stats->inc(LIMIT_TIMEOUT);
+            return pThis->reject(503);
+        }
+
+        pThis->m_bActive = true;
+        pThis->set(invoke);
+        return 0;
+    }
+
+    static int32_t invoke(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+
+        pThis->m_pThis->m_stats->inc(LIMIT_ACCEPTED);
+
+        pThis->set(end);
+        return mq_base::invoke(pThis->m_pThis->m_hdlr, pThis->m_v, pThis);
+    }
+
+    static int32_t end(AsyncState *pState, int32_t n)
+    {
+        asyncInvoke *pThis = (asyncInvoke *) pState;
+
+        if (pThis->m_bActive)
+        {
+            pThis->m_bActive = false;
+            pThis->m_pThis->release();
+        }
+
+        return pThis->done(CALL_RETURN_NULL);
+    }
+
+private:
+    int32_t reject(int32_t status)
+    {
+        obj_ptr<HttpRequest_base> req = HttpRequest_base::getInstance(m_v);
+
+        // tcp connections are simply handed back, the server closes them
+        if (req)
+        {
+            obj_ptr<Message_base> m;
+
+            req->get_response(m);
+
+            HttpResponse_base *rep = (HttpResponse_base *)(Message_base *)m;
+
+            rep->set_status(status);
+            rep->addHeader("Retry-After", "1");
+        }
+
+        return done(CALL_RETURN_NULL);
+    }
+
+private:
+    obj_ptr<LimitHandler> m_pThis;
+    obj_ptr<object_base> m_v;
+    bool m_bActive;
+    date_t m_d;
+};
+
+result_t LimitHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
+                              AsyncEvent *ac)
+{
+    if (!ac)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncInvoke(this, v, ac))->post(0);
+}
+
+result_t LimitHandler::get_handler(obj_ptr<Handler_base> &retVal)
+{
+    retVal = m_hdlr;
+    return 0;
+}
+
+result_t LimitHandler::get_stats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = m_stats;
+    return 0;
+}
+
+}
@@ -0,0 +1,319 @@
+/*
+ * DnsCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/net.h"
+#include "DnsCache.h"
+#include "inetAddr.h"
+#include <map>
+#include <list>
+
+namespace fibjs
+{
+
+int32_t DnsCache::s_ttl = 60000;
+int32_t DnsCache::s_negativeTtl = 5000;
+
+#define DNS_CACHE_SIZE  4096
+
+enum
+{
+    DNS_ENTRIES = 0,
+    DNS_INFLIGHT,
+    DNS_HITS,
+    DNS_MISSES,
+    DNS_COALESCED,
+    DNS_FAILURES
+};
+
+class _waiter
+{
+public:
+    _waiter(AsyncEvent *ac, std::string *retVal) :
+        m_ac(ac), m_retVal(retVal)
+    {
+    }
+
+public:
+    AsyncEvent *m_ac;
+    std::string *m_retVal;
+};
+
+class _entry
+{
+public:
+    _entry() : m_hr(0), m_pending(false)
+    {
+    }
+
+public:
+    bool expired(date_t &now)
+    {
+        return now.diff(m_time) >=
+               (m_hr < 0 ? DnsCache::s_negativeTtl : DnsCache::s_ttl);
+    }
+
+public:
+    std::string m_addr;
+    result_t m_hr;
+    date_t m_time;
+    bool m_pending;
+    std::list<_waiter> m_waiters;
+};
+
+static exlib::spinlock s_lock;
+static std::map<std::string, _entry> s_cache;
+
+static Stats *create_stats()
+{
+    static const char *s_staticCounter[] =
+    { "entries", "inflight" };
+    static const char *s_Counter[] =
+    { "hits", "misses", "coalesced", "failures" };
+
+    Stats *stats = new Stats();
+
+    stats->Ref();
+    stats->init(s_staticCounter, 2, s_Counter, 4);
+    stats->set_name("net_dns");
+
+    return stats;
+}
+
+Stats *DnsCache::stats()
+{
+    static Stats *s_stats = create_stats();
+    return s_stats;
+}
+
+static result_t lookup(const char *name, int32_t family, std::string &retVal)
+{
+    inetAddr addr_info;
+
+    addr_info.init(family);
+
+    addrinfo hints =
+    { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
+    addrinfo *result = NULL;
+    addrinfo *ptr = NULL;
+
+    if (getaddrinfo(name, NULL, &hints, &result))
+        return CHECK_ERROR(SocketError());
+
+    for (ptr = result; ptr != NULL; ptr = ptr->ai_next)
+        if (ptr->ai_family == addr_info.addr4.sin_family)
+        {
+            memcpy(&addr_info, ptr->ai_addr, addr_info.size());
+            break;
+        }
+
+    freeaddrinfo(result);
+
+    if (ptr == NULL)
+    {
+#ifdef _WIN32
+        return -WSAHOST_NOT_FOUND;
+#else
+        return -ETIME;
+#endif
+    }
+
+    retVal = addr_info.str();
+
+    return 0;
+}
+
+static void purge(Stats *stats, date_t &now)
+{
+    std::map<std::string, _entry>::iterator it = s_cache.begin();
+
+    while (it != s_cache.end())
+    {
+        if (!it->second.m_pending && it->second.expired(now))
+        {
+            s_cache.erase(it++);
+            stats->dec(DNS_ENTRIES);
+        }
+        else
+            ++it;
+    }
+}
+
+result_t DnsCache::resolve(const char *name, int32_t family,
+                           std::string &retVal, AsyncEvent *ac)
+{
+    Stats *stats = DnsCache::stats();
+    std::list<_waiter> waiters;
+    std::string key;
+    date_t now;
+    result_t hr;
+
+    key.append(family == net_base::_AF_INET6 ? "6:" : "4:", 2);
+    key.append(name);
+
+    now.now();
+
+    s_lock.lock();
+
+    std::map<std::string, _entry>::iterator it = s_cache.find(key);
+
+    if (it != s_cache.end())
+    {
+        _entry &e = it->second;
+
+        if (e.m_pending)
+        {
+            if (!ac)
+            {
+                s_lock.unlock();
+                return CHECK_ERROR(CALL_E_NOSYNC);
+            }
+
+            e.m_waiters.push_back(_waiter(ac, &retVal));
+            stats->inc(DNS_COALESCED);
+
+            s_lock.unlock();
+            return CHECK_ERROR(CALL_E_PENDDING);
+        }
+
+        if (!e.expired(now))
+        {
+            hr = e.m_hr;
+            if (hr >= 0)
+                retVal = e.m_addr;
+            stats->inc(DNS_HITS);
+
+            s_lock.unlock();
+            return hr;
+        }
+    }
+
+    if (!ac)
+    {
+        s_lock.unlock();
+        return CHECK_ERROR(CALL_E_NOSYNC);
+    }
+
+    if (it == s_cache.end())
+    {
+        if (s_cache.size() >= DNS_CACHE_SIZE)
+            purge(stats, now);
+
+        it = s_cache.insert(std::pair<std::string, _entry>(key, _entry())).first;
+        stats->inc(DNS_ENTRIES);
+    }
+
+    it->second.m_pending = true;
+    stats->inc(DNS_MISSES);
+    stats->inc(DNS_INFLIGHT);
+
+    s_lock.unlock();
+
+    hr = lookup(name, family, retVal);
+
+    now.now();
+
+    s_lock.lock();
+
+    _entry &e = it->second;
+
+    e.m_pending = false;
+    e.m_hr = hr;
+    e.m_addr = hr < 0 ? "" : retVal;
+    e.m_time = now;
+    waiters.swap(e.m_waiters);
+
+    if ((hr < 0 ? s_negativeTtl : s_ttl) <= 0)
+    {
+        s_cache.erase(it);
+        stats->dec(DNS_ENTRIES);
+    }
+
+    stats->dec(DNS_INFLIGHT);
+    if (hr < 0)
+        stats->inc(DNS_FAILURES);
+
+    s_lock.unlock();
+
+    while (!waiters.empty())
+    {
+        _waiter &w = waiters.front();
+
+        if (hr >= 0)
+            *w.m_retVal = retVal;
+        w.m_ac->apost(hr);
+
+        waiters.pop_front();
+    }
+
+    return hr;
+}
+
+void DnsCache::clear()
+{
+    Stats *stats = DnsCache::stats();
+    std::map<std::string, _entry>::iterator it;
+
+    s_lock.lock();
+
+    it = s_cache.begin();
+    while (it != s_cache.end())
+    {
+        if (!it->second.m_pending)
+        {
+            s_cache.erase(it++);
+            stats->dec(DNS_ENTRIES);
+        }
+        else
+            ++it;
+    }
+
+    s_lock.unlock();
+}
+
+result_t net_base::get_dnsCacheTTL(int32_t &retVal)
+{
+    retVal = DnsCache::s_ttl;
+    return 0;
+}
+
+result_t net_base::set_dnsCacheTTL(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    DnsCache::s_ttl = newVal;
+    return 0;
+}
+
+result_t net_base::get_dnsNegativeTTL(int32_t &retVal)
+{
+    retVal = DnsCache::s_negativeTtl;
+    return 0;
+}
+
+result_t net_base::set_dnsNegativeTTL(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    DnsCache::s_negativeTtl = newVal;
+    return 0;
+}
+
+result_t net_base::get_dnsStats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = DnsCache::stats();
+    return 0;
+}
+
+result_t net_base::clearDnsCache()
+{
+    DnsCache::clear();
+    return 0;
+}
+
+} /* namespace fibjs */
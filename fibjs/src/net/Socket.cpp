@@ -5,6 +5,7 @@
  *      Author: lion
  */
 
+#include "ifs/net.h"
 #include "Socket.h"
 #include "Buffer.h"
 #include "Stat.h"
@@ -135,6 +136,7 @@ result_t Socket::close(AsyncEvent *ac)
         ::closesocket(m_sock);
 
     m_sock = INVALID_SOCKET;
+    stop_timer();
 
 #ifndef _WIN32
     if (m_inRecv || m_inSend)
@@ -231,6 +233,160 @@ result_t Socket::get_localPort(int32_t &retVal)
     return 0;
 }
 
+result_t Socket::get_timeout(int32_t &retVal)
+{
+    retVal = m_timeout;
+    return 0;
+}
+
+result_t Socket::set_timeout(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_timeout = newVal;
+    if (m_timeout == 0 && !m_deadline)
+        stop_timer();
+
+    return 0;
+}
+
+// one arm of the socket timer, an expiry already dispatched when the socket
+// re-arms or cancels keeps its own generation and is recognized as stale
+class Socket::_timer: public TimerWheel::Entry
+{
+public:
+    _timer(Socket *pThis) : m_pThis(pThis), m_gen(0), m_seq(0)
+    {
+        m_pThis->Ref();
+    }
+
+    ~_timer()
+    {
+        m_pThis->Unref();
+    }
+
+public:
+    // TimerWheel::Entry
+    virtual void timeout()
+    {
+        m_pThis->timeout(this);
+        delete this;
+    }
+
+public:
+    Socket *m_pThis;
+    intptr_t m_gen;
+    intptr_t m_seq;
+};
+
+void Socket::arm_timer(int32_t ms)
+{
+    m_timerGen++;
+
+    if (!m_timer || !TimerWheel::cancel(m_timer))
+        m_timer = new _timer(this);
+
+    m_timer->m_gen = m_timerGen;
+    m_timer->m_seq = m_recvSeq;
+    TimerWheel::start(m_timer, ms);
+}
+
+void Socket::start_timer()
+{
+    m_recvSeq++;
+
+    if (m_timeout > 0 && !m_deadline)
+        arm_timer(m_timeout);
+}
+
+void Socket::stop_timer()
+{
+    m_timerGen++;
+
+    if (m_timer)
+    {
+        if (TimerWheel::cancel(m_timer))
+            delete m_timer;
+        m_timer = NULL;
+    }
+}
+
+void Socket::set_deadline(int32_t ms)
+{
+    stop_timer();
+
+    m_deadline = ms > 0;
+    m_timedOut = false;
+
+    if (m_deadline)
+        arm_timer(ms);
+}
+
+void Socket::timeout(_timer *t)
+{
+    // superseded by a later arm or a cancel, the entry only drops its ref
+    if (t->m_gen != m_timerGen)
+        return;
+
+    m_timer = NULL;
+
+    if (m_deadline)
+    {
+        // a deadline covers every recv until it is cleared, so cancel
+        // whatever is in flight and fail the ones that follow
+        m_timedOut = true;
+        if (m_inRecv && m_sock != INVALID_SOCKET)
+            cancel_recv(m_recvSeq);
+    }
+    else if (m_inRecv && t->m_seq == m_recvSeq && m_sock != INVALID_SOCKET)
+        cancel_recv(t->m_seq);
+}
+
+result_t Socket::resolve_connect(const char *host, int32_t port, AsyncEvent *ac)
+{
+    class asyncConnect: public AsyncState
+    {
+    public:
+        asyncConnect(Socket *pThis, const char *host, int32_t port,
+                     AsyncEvent *ac) :
+            AsyncState(ac), m_pThis(pThis), m_host(host), m_port(port)
+        {
+            set(resolve);
+        }
+
+        static int32_t resolve(AsyncState *pState, int32_t n)
+        {
+            asyncConnect *pThis = (asyncConnect *) pState;
+
+            pThis->set(connect);
+            return net_base::resolve(pThis->m_host.c_str(), pThis->m_pThis->m_family,
+                                     pThis->m_addr, pThis);
+        }
+
+        static int32_t connect(AsyncState *pState, int32_t n)
+        {
+            asyncConnect *pThis = (asyncConnect *) pState;
+            inetAddr addr_info;
+
+            addr_info.init(pThis->m_pThis->m_family);
+            if (addr_info.addr(pThis->m_addr.c_str()) < 0)
+                return CHECK_ERROR(CALL_E_INVALIDARG);
+
+            pThis->done();
+            return pThis->m_pThis->connect(pThis->m_addr.c_str(), pThis->m_port, pThis);
+        }
+
+    private:
+        obj_ptr<Socket> m_pThis;
+        std::string m_host;
+        int32_t m_port;
+        std::string m_addr;
+    };
+
+    return (new asyncConnect(this, host, port, ac))->post(0);
+}
+
 result_t Socket::bind(const char *addr, int32_t port, bool allowIPv4)
 {
     if (m_sock == INVALID_SOCKET)
@@ -75,6 +75,8 @@ class asyncEv;
 
 static ev_async s_asEvent;
 static exlib::LockedList<asyncEv> s_evWait;
+static exlib::atomic s_pending;
+static int64_t s_events;
 
 class asyncEv: public ev_io,
     public exlib::linkitem
@@ -99,12 +101,25 @@ class asyncProc: public asyncEv
 {
 public:
     asyncProc(SOCKET s, int32_t op, AsyncEvent *ac, intptr_t &guard, void *&opt) :
-        m_s(s), m_op(op), m_ac(ac), m_guard(guard), m_opt(opt)
+        m_s(s), m_op(op), m_ac(ac), m_guard(guard), m_opt(opt), m_seq(0),
+        m_expired(false)
     {
+        s_pending.inc();
+    }
+
+    ~asyncProc()
+    {
+        s_pending.dec();
     }
 
     virtual void start()
     {
+        if (m_expired)
+        {
+            ready(SOCKET_E_TIMEOUT);
+            return;
+        }
+
         m_opt = this;
         ev_io *io = (ev_io *) this;
         ev_io_init(io, io_cb, m_s, m_op);
@@ -149,16 +164,30 @@ public:
         proc();
     }
 
+    void expire()
+    {
+        if (ev_is_active(this))
+        {
+            ev_io_stop(s_loop, this);
+            ready(SOCKET_E_TIMEOUT);
+        }
+        else
+            m_expired = true;
+    }
+
 public:
     SOCKET m_s;
     int32_t m_op;
     AsyncEvent *m_ac;
     intptr_t &m_guard;
     void *&m_opt;
+    intptr_t m_seq;
+    bool m_expired;
 
 private:
     static void io_cb(struct ev_loop *loop, struct ev_io *watcher, int32_t revents)
     {
+        s_events++;
         ((asyncProc *) watcher)->onready();
     }
 };
@@ -221,6 +250,12 @@ void init_net()
     s_acSock.start();
 }
 
+void reactor_status(int32_t &pending, int64_t &events)
+{
+    pending = (int32_t)s_pending;
+    events = s_events;
+}
+
 void Socket::cancel_socket(AsyncEvent *ac)
 {
     class asyncCancel: public asyncEv
@@ -252,6 +287,34 @@ void Socket::cancel_socket(AsyncEvent *ac)
     (new asyncCancel(m_RecvOpt, m_SendOpt, ac))->post();
 }
 
+void Socket::cancel_recv(intptr_t seq)
+{
+    class asyncTimeout: public asyncEv
+    {
+    public:
+        asyncTimeout(Socket *pThis, intptr_t seq) :
+            m_pThis(pThis), m_seq(seq)
+        {
+        }
+
+        virtual void start()
+        {
+            asyncProc *p = (asyncProc *) m_pThis->m_RecvOpt;
+
+            if (p && p->m_seq == m_seq)
+                p->expire();
+
+            delete this;
+        }
+
+    public:
+        obj_ptr<Socket> m_pThis;
+        intptr_t m_seq;
+    };
+
+    (new asyncTimeout(this, seq))->post();
+}
+
 result_t Socket::connect(const char *host, int32_t port, AsyncEvent *ac)
 {
     class asyncConnect: public asyncProc
@@ -303,15 +366,7 @@ result_t Socket::connect(const char *host, int32_t port, AsyncEvent *ac)
     addr_info.init(m_family);
     addr_info.setPort(port);
     if (addr_info.addr(host) < 0)
-    {
-        std::string strAddr;
-        result_t hr = net_base::resolve(host, m_family, strAddr, ac);
-        if (hr < 0)
-            return hr;
-
-        if (addr_info.addr(strAddr.c_str()) < 0)
-            return CHECK_ERROR(CALL_E_INVALIDARG);
-    }
+        return resolve_connect(host, port, ac);
 
     if (exlib::CompareAndSwap(&m_inRecv, 0, 1))
         return CHECK_ERROR(CALL_E_REENTRANT);
@@ -451,10 +506,18 @@ result_t Socket::recv(int32_t bytes, obj_ptr<Buffer_base> &retVal,
     if (!ac)
         return CHECK_ERROR(CALL_E_NOSYNC);
 
+    if (m_timedOut)
+        return CHECK_ERROR(SOCKET_E_TIMEOUT);
+
     if (exlib::CompareAndSwap(&m_inRecv, 0, 1))
         return CHECK_ERROR(CALL_E_REENTRANT);
 
-    return (new asyncRecv(m_sock, bytes, retVal, ac, bRead, m_inRecv, m_RecvOpt))->call();
+    start_timer();
+
+    asyncRecv *pa = new asyncRecv(m_sock, bytes, retVal, ac, bRead, m_inRecv, m_RecvOpt);
+    pa->m_seq = m_recvSeq;
+
+    return pa->call();
 }
 
 result_t Socket::send(Buffer_base *data, AsyncEvent *ac)
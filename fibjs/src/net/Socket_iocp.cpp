@@ -38,6 +38,8 @@ void setOption(SOCKET s)
 }
 
 HANDLE s_hIocp;
+static exlib::atomic s_pending;
+static int64_t s_events;
 
 class asyncProc: public OVERLAPPED
 {
@@ -46,10 +48,12 @@ public:
         m_s(s), m_ac(ac), m_guard(guard), m_next(NULL)
     {
         memset((OVERLAPPED *) this, 0, sizeof(OVERLAPPED));
+        s_pending.inc();
     }
 
     virtual ~asyncProc()
     {
+        s_pending.dec();
     }
 
     void proc()
@@ -122,7 +126,10 @@ public:
                 dwError = 0;
 
             if (bRet || (dwError != WAIT_TIMEOUT))
+            {
+                s_events++;
                 ((asyncProc *) pOverlap)->ready(dwBytes, -(int32_t) dwError);
+            }
         }
     }
 
@@ -133,6 +140,12 @@ void init_net()
     s_acSock.start();
 }
 
+void reactor_status(int32_t &pending, int64_t &events)
+{
+    pending = (int32_t)s_pending;
+    events = s_events;
+}
+
 result_t net_base::backend(std::string &retVal)
 {
     retVal = "IOCP";
@@ -201,15 +214,7 @@ result_t Socket::connect(const char *host, int32_t port, AsyncEvent *ac)
     addr_info.init(m_family);
     addr_info.setPort(port);
     if (addr_info.addr(host) < 0)
-    {
-        std::string strAddr;
-        result_t hr = net_base::resolve(host, m_family, strAddr, ac);
-        if (hr < 0)
-            return hr;
-
-        if (addr_info.addr(strAddr.c_str()) < 0)
-            return CHECK_ERROR(CALL_E_INVALIDARG);
-    }
+        return resolve_connect(host, port, ac);
 
     if (!m_bBind)
     {
@@ -311,10 +316,13 @@ result_t Socket::recv(int32_t bytes, obj_ptr<Buffer_base> &retVal,
     {
     public:
         asyncRecv(SOCKET s, int32_t bytes, obj_ptr<Buffer_base> &retVal,
-                  AsyncEvent *ac, bool bRead, intptr_t &guard) :
-            asyncProc(s, ac, guard), m_retVal(retVal), m_pos(0), m_bRead(bRead)
+                  AsyncEvent *ac, bool bRead, intptr_t &guard, void *&opt,
+                  bool &expired) :
+            asyncProc(s, ac, guard), m_retVal(retVal), m_pos(0), m_bRead(bRead),
+            m_opt(opt), m_expired(expired)
         {
             m_buf.resize(bytes > 0 ? bytes : SOCKET_BUFF_SIZE);
+            m_opt = this;
         }
 
         virtual result_t process()
@@ -341,6 +349,9 @@ result_t Socket::recv(int32_t bytes, obj_ptr<Buffer_base> &retVal,
                 dwBytes = 0;
             }
 
+            if (nError == -ERROR_OPERATION_ABORTED && m_expired)
+                nError = SOCKET_E_TIMEOUT;
+
             if (dwBytes == 0)
                 m_bRead = false;
 
@@ -363,6 +374,7 @@ result_t Socket::recv(int32_t bytes, obj_ptr<Buffer_base> &retVal,
                     nError = CALL_RETURN_NULL;
             }
 
+            m_opt = NULL;
             asyncProc::ready(dwBytes, nError);
         }
 
@@ -371,6 +383,8 @@ result_t Socket::recv(int32_t bytes, obj_ptr<Buffer_base> &retVal,
         int32_t m_pos;
         bool m_bRead;
         std::string m_buf;
+        void *&m_opt;
+        bool &m_expired;
     };
 
     if (m_sock == INVALID_SOCKET)
@@ -379,13 +393,31 @@ result_t Socket::recv(int32_t bytes, obj_ptr<Buffer_base> &retVal,
     if (!ac)
         return CHECK_ERROR(CALL_E_NOSYNC);
 
+    if (m_timedOut)
+        return CHECK_ERROR(SOCKET_E_TIMEOUT);
+
     if (exlib::CompareAndSwap(&m_inRecv, 0, 1))
         return CHECK_ERROR(CALL_E_REENTRANT);
 
-    (new asyncRecv(m_sock, bytes, retVal, ac, bRead, m_inRecv))->proc();
+    m_expired = false;
+    start_timer();
+
+    (new asyncRecv(m_sock, bytes, retVal, ac, bRead, m_inRecv, m_RecvOpt,
+                   m_expired))->proc();
     return CHECK_ERROR(CALL_E_PENDDING);
 }
 
+void Socket::cancel_recv(intptr_t seq)
+{
+    void *opt = m_RecvOpt;
+
+    if (opt)
+    {
+        m_expired = true;
+        CancelIoEx((HANDLE) m_sock, (LPOVERLAPPED)(asyncProc *) opt);
+    }
+}
+
 result_t Socket::send(Buffer_base *data, AsyncEvent *ac)
 {
     class asyncSend: public asyncProc
@@ -6,6 +6,7 @@
  */
 
 #include "TcpServer.h"
+#include "LimitHandler.h"
 #include "ifs/mq.h"
 #include "JSHandler.h"
 #include "ifs/console.h"
@@ -52,16 +53,25 @@ static const char *s_staticCounter[] =
 { "total", "connections" };
 static const char *s_Counter[] =
 { "accept", "close" };
+static const char *s_Histogram[] =
+{ "duration" };
 
 enum
 {
     TCPS_TOTAL = 0, TCPS_CONNECTIONS, TCPS_ACCEPT, TCPS_CLOSE
 };
 
+enum
+{
+    TCPS_DURATION = 0
+};
+
 TcpServer::TcpServer()
 {
     m_stats = new Stats();
     m_stats->init(s_staticCounter, 2, s_Counter, 2);
+    m_stats->init_histograms(s_Histogram, 1);
+    m_stats->set_name("tcp_server");
     m_running = false;
 }
 
@@ -96,6 +106,7 @@ result_t TcpServer::run(AsyncEvent *ac)
         asyncInvoke(TcpServer *pThis, Socket_base *pSock) :
             AsyncState(NULL), m_pThis(pThis), m_sock(pSock), m_obj(pSock)
         {
+            m_d.now();
             set(invoke);
         }
 
@@ -111,10 +122,14 @@ result_t TcpServer::run(AsyncEvent *ac)
         static int32_t close(AsyncState *pState, int32_t n)
         {
             asyncInvoke *pThis = (asyncInvoke *) pState;
+            date_t d;
+
+            d.now();
 
             pThis->done();
             pThis->m_pThis->m_stats->inc(TCPS_CLOSE);
             pThis->m_pThis->m_stats->dec(TCPS_CONNECTIONS);
+            pThis->m_pThis->m_stats->record(TCPS_DURATION, (int64_t)(d.diff(pThis->m_d) * 1000));
             return pThis->m_sock->close(pThis);
         }
 
@@ -129,6 +144,7 @@ result_t TcpServer::run(AsyncEvent *ac)
         obj_ptr<TcpServer> m_pThis;
         obj_ptr<Socket_base> m_sock;
         obj_ptr<object_base> m_obj;
+        date_t m_d;
     };
 
     class asyncAccept: public AsyncState
@@ -247,6 +263,11 @@ result_t TcpServer::set_handler(Handler_base *newVal)
     return 0;
 }
 
+result_t TcpServer::limit(v8::Local<v8::Object> opts, obj_ptr<LimitHandler_base> &retVal)
+{
+    return LimitHandler::limit(this, opts, retVal);
+}
+
 result_t TcpServer::get_stats(obj_ptr<Stats_base> &retVal)
 {
     retVal = m_stats;
@@ -9,6 +9,7 @@
 #include "Socket.h"
 #include "Smtp.h"
 #include "Url.h"
+#include "DnsCache.h"
 
 namespace fibjs
 {
@@ -19,42 +20,7 @@ result_t net_base::resolve(const char *name, int32_t family,
     if (family != net_base::_AF_INET && family != net_base::_AF_INET6)
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
-    if (!ac)
-        return CHECK_ERROR(CALL_E_NOSYNC);
-
-    inetAddr addr_info;
-
-    addr_info.init(family);
-
-    addrinfo hints =
-    { 0, AF_UNSPEC, SOCK_STREAM, IPPROTO_TCP, 0, 0, 0, 0 };
-    addrinfo *result = NULL;
-    addrinfo *ptr = NULL;
-
-    if (getaddrinfo(name, NULL, &hints, &result))
-        return CHECK_ERROR(SocketError());
-
-    for (ptr = result; ptr != NULL; ptr = ptr->ai_next)
-        if (ptr->ai_family == addr_info.addr4.sin_family)
-        {
-            memcpy(&addr_info, ptr->ai_addr, addr_info.size());
-            break;
-        }
-
-    freeaddrinfo(result);
-
-    if (ptr == NULL)
-    {
-#ifdef _WIN32
-        return -WSAHOST_NOT_FOUND;
-#else
-        return -ETIME;
-#endif
-    }
-
-    retVal = addr_info.str();
-
-    return 0;
+    return DnsCache::resolve(name, family, retVal, ac);
 }
 
 result_t net_base::ip(const char *name, std::string &retVal,
@@ -0,0 +1,510 @@
+/*
+ * CpuProfiler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "CpuProfiler.h"
+#include "ifs/profiler.h"
+#include "ifs/fs.h"
+#include "Buffer.h"
+#include "StringBuffer.h"
+#include "Ticks.h"
+#include <stdio.h>
+
+namespace fibjs
+{
+
+#define PROFILE_TITLE "fibjs"
+#define PROFILE_MAX_SWITCHES	(1024 * 1024)
+
+result_t profiler_base::startCPUProfile(int32_t interval)
+{
+	return CpuProfiler::start(interval);
+}
+
+result_t profiler_base::stopCPUProfile(const char* fname, const char* format)
+{
+	return CpuProfiler::stop(fname, NULL, format);
+}
+
+result_t profiler_base::stopCPUProfile(Stream_base* stm, const char* format)
+{
+	return CpuProfiler::stop(NULL, stm, format);
+}
+
+CpuProfiler::CpuProfiler(int32_t interval) :
+	m_start(0), m_interval(interval), m_startTime(0), m_endTime(0)
+{
+	m_labels.push_back("(no fiber)");
+}
+
+result_t CpuProfiler::start(int32_t interval)
+{
+	Isolate* isolate = Isolate::now();
+
+	if (interval < 1)
+		return CHECK_ERROR(CALL_E_OUTRANGE);
+
+	if (isolate->m_profiler)
+		return CHECK_ERROR(Runtime::setError("profiler: cpu profile already started."));
+
+	v8::CpuProfiler* cpu = isolate->m_isolate->GetCpuProfiler();
+	cpu->SetSamplingInterval(interval);
+	cpu->StartProfiling(v8::String::NewFromUtf8(isolate->m_isolate, PROFILE_TITLE), true);
+
+	CpuProfiler* p = new CpuProfiler(interval);
+	p->m_start = Ticks() / 1000;
+	isolate->m_profiler = p;
+
+	p->_enter(NULL);
+
+	return 0;
+}
+
+result_t CpuProfiler::stop(const char* fname, Stream_base* stm, const char* format)
+{
+	Isolate* isolate = Isolate::now();
+	bool bCollapsed;
+
+	if (!qstrcmp(format, "cpuprofile"))
+		bCollapsed = false;
+	else if (!qstrcmp(format, "collapsed"))
+		bCollapsed = true;
+	else
+		return CHECK_ERROR(CALL_E_INVALIDARG);
+
+	CpuProfiler* p = isolate->m_profiler;
+	if (!p)
+		return CHECK_ERROR(Runtime::setError("profiler: cpu profile not started."));
+
+	isolate->m_profiler = NULL;
+
+	v8::CpuProfiler* cpu = isolate->m_isolate->GetCpuProfiler();
+	v8::CpuProfile* profile = cpu->StopProfiling(
+	                              v8::String::NewFromUtf8(isolate->m_isolate, PROFILE_TITLE));
+
+	std::string out;
+
+	if (profile)
+	{
+		p->load(profile);
+
+		if (bCollapsed)
+			p->collapsed(out);
+		else
+			p->cpuprofile(out);
+
+		profile->Delete();
+	}
+
+	delete p;
+
+	if (fname)
+		return fs_base::ac_writeFile(fname, out.c_str());
+
+	obj_ptr<Buffer_base> buf = new Buffer(out);
+	return stm->ac_write(buf);
+}
+
+void CpuProfiler::_enter(JSFiber* fb)
+{
+	std::map<JSFiber*, int32_t>::iterator it;
+	int32_t fid;
+
+	if (!fb)
+		fb = JSFiber::current();
+
+	it = m_ids.find(fb);
+	if (it == m_ids.end())
+	{
+		char buf[64];
+
+		fid = (int32_t)m_labels.size();
+		sprintf(buf, "Fiber %d", fid);
+		m_labels.push_back(buf);
+		m_ids.insert(std::pair<JSFiber*, int32_t>(fb, fid));
+	}
+	else
+		fid = it->second;
+
+	push(fid);
+}
+
+void CpuProfiler::_leave(JSFiber* fb, bool bEnd)
+{
+	std::map<JSFiber*, int32_t>::iterator it;
+
+	if (!fb)
+		fb = JSFiber::current();
+
+	push(0);
+
+	it = m_ids.find(fb);
+	if (it == m_ids.end())
+		return;
+
+	if (!fb->m_traceInfo.empty())
+	{
+		std::string& label = m_labels[it->second];
+		const char* s = fb->m_traceInfo.c_str();
+		const char* e;
+
+		while (*s == '\n' || *s == ' ')
+			s ++;
+		if (!qstrcmp(s, "at ", 3))
+			s += 3;
+
+		e = s;
+		while (*e && *e != '\n')
+			e ++;
+
+		if (e > s && label.find(' ', 6) == std::string::npos)
+		{
+			label.append(" ");
+			label.append(s, e - s);
+		}
+	}
+
+	if (bEnd)
+		m_ids.erase(it);
+}
+
+void CpuProfiler::push(int32_t fid)
+{
+	int64_t t = Ticks() / 1000;
+
+	if (!m_switches.empty())
+	{
+		_switch& last = m_switches.back();
+
+		if (last.m_fid == fid)
+			return;
+
+		if (last.m_time == t)
+		{
+			last.m_fid = fid;
+			return;
+		}
+	}
+
+	if (m_switches.size() >= PROFILE_MAX_SWITCHES)
+		compact();
+
+	m_switches.push_back(_switch(t, fid));
+}
+
+void CpuProfiler::compact()
+{
+	int64_t span = m_interval;
+
+	// drop the runs too short to be sampled reliably, doubling the
+	// threshold until the buffer is half empty again
+	while (m_switches.size() >= PROFILE_MAX_SWITCHES / 2)
+	{
+		size_t i, n = 0;
+
+		for (i = 0; i < m_switches.size(); i ++)
+		{
+			if (i + 1 < m_switches.size()
+			        && m_switches[i + 1].m_time - m_switches[i].m_time < span)
+				continue;
+
+			if (n > 0 && m_switches[n - 1].m_fid == m_switches[i].m_fid)
+				continue;
+
+			m_switches[n ++] = m_switches[i];
+		}
+
+		m_switches.resize(n);
+		span *= 2;
+	}
+}
+
+int32_t CpuProfiler::fiber(int64_t t)
+{
+	int32_t lo = 0, hi = (int32_t)m_switches.size();
+
+	if (hi == 0 || t < m_switches[0].m_time)
+		return hi ? m_switches[0].m_fid : 0;
+
+	while (hi - lo > 1)
+	{
+		int32_t mid = (lo + hi) / 2;
+
+		if (m_switches[mid].m_time <= t)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	return m_switches[lo].m_fid;
+}
+
+int32_t CpuProfiler::node(int32_t fid, const v8::CpuProfileNode* frame)
+{
+	std::map<std::pair<int32_t, const v8::CpuProfileNode*>, int32_t>::iterator it;
+	std::map<const v8::CpuProfileNode*, const v8::CpuProfileNode*>::iterator itp;
+	int32_t parent;
+	int32_t id;
+
+	it = m_index.find(std::pair<int32_t, const v8::CpuProfileNode*>(fid, frame));
+	if (it != m_index.end())
+		return it->second;
+
+	itp = m_parents.find(frame);
+	if (itp != m_parents.end())
+		parent = node(fid, itp->second);
+	else if (frame)
+		parent = node(fid, NULL);
+	else
+		parent = 0;
+
+	id = (int32_t)m_nodes.size();
+	m_nodes.push_back(_node(fid, frame));
+	m_nodes[parent].m_childs.push_back(id);
+	m_index.insert(std::pair<std::pair<int32_t, const v8::CpuProfileNode*>, int32_t>(
+	                   std::pair<int32_t, const v8::CpuProfileNode*>(fid, frame), id));
+
+	return id;
+}
+
+void CpuProfiler::load(const v8::CpuProfile* profile)
+{
+	std::vector<const v8::CpuProfileNode*> stack;
+	const v8::CpuProfileNode* root = profile->GetTopDownRoot();
+	int32_t cnt, i;
+
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const v8::CpuProfileNode* p = stack.back();
+		stack.pop_back();
+
+		cnt = p->GetChildrenCount();
+		for (i = 0; i < cnt; i ++)
+		{
+			const v8::CpuProfileNode* c = p->GetChild(i);
+
+			if (p != root)
+				m_parents.insert(std::pair<const v8::CpuProfileNode*,
+				                 const v8::CpuProfileNode*>(c, p));
+			stack.push_back(c);
+		}
+	}
+
+	m_startTime = profile->GetStartTime();
+	m_endTime = profile->GetEndTime();
+
+	m_nodes.push_back(_node(-1, root));
+
+	cnt = profile->GetSamplesCount();
+	for (i = 0; i < cnt; i ++)
+	{
+		const v8::CpuProfileNode* frame = profile->GetSample(i);
+		int64_t ts = profile->GetSampleTimestamp(i);
+		int32_t id;
+
+		if (frame == root)
+			frame = NULL;
+
+		id = node(fiber(m_start + ts - m_startTime), frame);
+		m_nodes[id].m_hit ++;
+
+		m_samples.push_back(id);
+		m_times.push_back(ts);
+	}
+}
+
+static void json_string(StringBuffer& buf, const char* s)
+{
+	buf.append('\"');
+
+	while (*s)
+	{
+		char ch = *s ++;
+
+		switch (ch)
+		{
+		case '\"':
+			buf.append("\\\"");
+			break;
+		case '\\':
+			buf.append("\\\\");
+			break;
+		case '\n':
+			buf.append("\\n");
+			break;
+		case '\r':
+			buf.append("\\r");
+			break;
+		case '\t':
+			buf.append("\\t");
+			break;
+		default:
+			if ((unsigned char)ch < 0x20)
+			{
+				char tmp[8];
+
+				sprintf(tmp, "\\u%04x", ch);
+				buf.append(tmp);
+			}
+			else
+				buf.append(ch);
+		}
+	}
+
+	buf.append('\"');
+}
+
+void CpuProfiler::cpuprofile(std::string& retVal)
+{
+	StringBuffer buf;
+	char tmp[128];
+	size_t i, j;
+
+	buf.append("{\"nodes\":[");
+
+	for (i = 0; i < m_nodes.size(); i ++)
+	{
+		_node& n = m_nodes[i];
+		std::string name, url;
+		int32_t scriptId = 0, line = 0, column = 0;
+
+		if (i == 0)
+			name = "(root)";
+		else if (n.m_frame == NULL)
+			name = "(" + m_labels[n.m_fid] + ")";
+		else
+		{
+			v8::String::Utf8Value fname(n.m_frame->GetFunctionName());
+			v8::String::Utf8Value rname(n.m_frame->GetScriptResourceName());
+
+			name.assign(*fname ? *fname : "", fname.length());
+			url.assign(*rname ? *rname : "", rname.length());
+			scriptId = n.m_frame->GetScriptId();
+			line = n.m_frame->GetLineNumber();
+			column = n.m_frame->GetColumnNumber();
+		}
+
+		if (i > 0)
+			buf.append(',');
+
+		sprintf(tmp, "{\"id\":%d,\"callFrame\":{\"functionName\":", (int32_t)i + 1);
+		buf.append(tmp);
+		json_string(buf, name.c_str());
+
+		sprintf(tmp, ",\"scriptId\":\"%d\",\"url\":", scriptId);
+		buf.append(tmp);
+		json_string(buf, url.c_str());
+
+		sprintf(tmp, ",\"lineNumber\":%d,\"columnNumber\":%d},\"hitCount\":%d,\"children\":[",
+		        line - 1, column - 1, n.m_hit);
+		buf.append(tmp);
+
+		for (j = 0; j < n.m_childs.size(); j ++)
+		{
+			sprintf(tmp, j ? ",%d" : "%d", n.m_childs[j] + 1);
+			buf.append(tmp);
+		}
+
+		buf.append("]}");
+	}
+
+	sprintf(tmp, "],\"startTime\":%lld,\"endTime\":%lld,\"samples\":[",
+	        (long long)m_startTime, (long long)m_endTime);
+	buf.append(tmp);
+
+	for (i = 0; i < m_samples.size(); i ++)
+	{
+		sprintf(tmp, i ? ",%d" : "%d", m_samples[i] + 1);
+		buf.append(tmp);
+	}
+
+	buf.append("],\"timeDeltas\":[");
+
+	int64_t last = m_startTime;
+	for (i = 0; i < m_times.size(); i ++)
+	{
+		sprintf(tmp, i ? ",%lld" : "%lld", (long long)(m_times[i] - last));
+		buf.append(tmp);
+		last = m_times[i];
+	}
+
+	buf.append("]}");
+
+	retVal = buf.str();
+}
+
+void CpuProfiler::collapsed(std::string& retVal)
+{
+	StringBuffer buf;
+	std::vector<std::string> names(m_nodes.size());
+	std::vector<int32_t> parents(m_nodes.size(), -1);
+	char tmp[64];
+	size_t i, j;
+
+	for (i = 0; i < m_nodes.size(); i ++)
+	{
+		_node& n = m_nodes[i];
+		std::string& name = names[i];
+
+		for (j = 0; j < n.m_childs.size(); j ++)
+			parents[n.m_childs[j]] = (int32_t)i;
+
+		if (i == 0)
+			continue;
+
+		if (n.m_frame == NULL)
+			name = m_labels[n.m_fid];
+		else
+		{
+			v8::String::Utf8Value fname(n.m_frame->GetFunctionName());
+			v8::String::Utf8Value rname(n.m_frame->GetScriptResourceName());
+
+			if (fname.length() > 0)
+				name.assign(*fname, fname.length());
+			else
+				name = "(anonymous)";
+
+			if (rname.length() > 0)
+			{
+				name.append(" (");
+				name.append(*rname, rname.length());
+				sprintf(tmp, ":%d)", n.m_frame->GetLineNumber());
+				name.append(tmp);
+			}
+		}
+
+		for (j = 0; j < name.length(); j ++)
+			if (name[j] == ';')
+				name[j] = ',';
+	}
+
+	for (i = 1; i < m_nodes.size(); i ++)
+	{
+		std::vector<int32_t> path;
+		int32_t p;
+
+		if (m_nodes[i].m_hit == 0)
+			continue;
+
+		for (p = (int32_t)i; p > 0; p = parents[p])
+			path.push_back(p);
+
+		for (j = path.size(); j > 0; j --)
+		{
+			if (j < path.size())
+				buf.append(';');
+			buf.append(names[path[j - 1]]);
+		}
+
+		sprintf(tmp, " %d\n", m_nodes[i].m_hit);
+		buf.append(tmp);
+	}
+
+	retVal = buf.str();
+}
+
+} /* namespace fibjs */
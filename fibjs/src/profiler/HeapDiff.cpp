@@ -8,13 +8,15 @@
 #include "HeapSnapshot.h"
 #include "ifs/HeapGraphEdge.h"
 #include "ifs/profiler.h"
-#include <set>
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <iterator>
 
 namespace fibjs
 {
 
-typedef std::set<int32_t> idset;
+typedef std::vector<int32_t> idset;
 
 inline void buildIDSet(idset* seen, HeapSnapshot_base* snapshot, intptr_t& s)
 {
@@ -23,6 +25,7 @@ inline void buildIDSet(idset* seen, HeapSnapshot_base* snapshot, intptr_t& s)
 
 	snapshot->get_nodes(nodes);
 	nodes->get_length(_count);
+	seen->reserve(_count);
 
 	for (int32_t i = 0; i < _count; i++)
 	{
@@ -39,15 +42,16 @@ inline void buildIDSet(idset* seen, HeapSnapshot_base* snapshot, intptr_t& s)
 		cur->get_shallowSize(_size);
 
 		s += _size;
-		seen->insert(_id);
+		seen->push_back(_id);
 	}
+
+	std::sort(seen->begin(), seen->end());
 }
 
-void setDiff(idset a, idset b, std::vector<int32_t> &c)
+void setDiff(const idset& a, const idset& b, std::vector<int32_t> &c)
 {
-	for (idset::iterator i = a.begin(); i != a.end(); i++)
-		if (b.find(*i) == b.end())
-			c.push_back(*i);
+	std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+	                    std::back_inserter(c));
 }
 
 class example
@@ -9,8 +9,7 @@
 #include "HeapSnapshot.h"
 #include "HeapGraphNode.h"
 #include "HeapGraphEdge.h"
-#include "StringBuffer.h"
-#include "ifs/fs.h"
+#include "File.h"
 
 namespace fibjs
 {
@@ -28,15 +27,17 @@ void HeapSnapshotProxy::fill_nodes()
 		m_nodes = new List();
 		int32_t cnt = m_snapshot->GetNodesCount();
 
+		_nodes.reserve(cnt);
 		for (int32_t i = 0; i < cnt; i ++)
 		{
 			const v8::HeapGraphNode* _node;
 
 			_node = m_snapshot->GetNode(i);
-			_nodes.insert(std::pair<int32_t, int32_t>(_node->GetId(), i));
+			_nodes.add(_node->GetId(), i);
 			m_nodes->append(new HeapGraphNodeProxy(this, _node));
 		}
 
+		_nodes.sort();
 		m_nodes->freeze();
 	}
 }
@@ -45,15 +46,13 @@ result_t HeapSnapshotProxy::getNodeById(int32_t id, obj_ptr<HeapGraphNode_base>&
 {
 	fill_nodes();
 
-	std::map<int32_t, int32_t>::iterator it;
-
-	it = _nodes.find(id);
-	if (it == _nodes.end())
+	int32_t pos = _nodes.find(id);
+	if (pos < 0)
 		return CALL_RETURN_NULL;
 
 	Variant v;
 
-	m_nodes->_indexed_getter(it->second, v);
+	m_nodes->_indexed_getter(pos, v);
 	retVal = (HeapGraphNode_base*)v.object();
 
 	return 0;
@@ -61,30 +60,52 @@ result_t HeapSnapshotProxy::getNodeById(int32_t id, obj_ptr<HeapGraphNode_base>&
 
 result_t HeapSnapshotProxy::save(const char* fname, AsyncEvent* ac)
 {
-	class BufferStream : public v8::OutputStream {
+	class FileStream : public v8::OutputStream {
+	public:
+		FileStream() : m_file(new File()), m_hr(0)
+		{}
+
+	public:
+		result_t open(const char* fname)
+		{
+			return m_file->open(fname, "w");
+		}
+
+		result_t result()
+		{
+			return m_hr;
+		}
+
 	public:
 		virtual void EndOfStream()
 		{}
 
-		virtual WriteResult WriteAsciiChunk(char* data, int size)
+		virtual int GetChunkSize()
 		{
-			m_buf.append(data, size);
-			return kContinue;
+			return 64 * 1024;
 		}
 
-		std::string result()
+		virtual WriteResult WriteAsciiChunk(char* data, int size)
 		{
-			return m_buf.str();
+			m_hr = m_file->Write(data, size);
+			return m_hr < 0 ? kAbort : kContinue;
 		}
 
 	private:
-		StringBuffer m_buf;
+		obj_ptr<File> m_file;
+		result_t m_hr;
 	};
 
-	BufferStream bs;
-	m_snapshot->Serialize(&bs);
+	FileStream fs;
+	result_t hr;
+
+	hr = fs.open(fname);
+	if (hr < 0)
+		return hr;
+
+	m_snapshot->Serialize(&fs);
 
-	return fs_base::ac_writeFile(fname, bs.result().c_str());
+	return fs.result();
 }
 
 result_t HeapSnapshotProxy::get_time(date_t& retVal)
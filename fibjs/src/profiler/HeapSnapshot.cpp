@@ -15,6 +15,7 @@
 #include "ifs/global.h"
 #include "ifs/encoding.h"
 #include "StringBuffer.h"
+#include <map>
 
 namespace fibjs
 {
@@ -87,14 +88,13 @@ result_t profiler_base::loadSnapshot(const char* fname, obj_ptr<HeapSnapshot_bas
 
 result_t HeapSnapshot::getNodeById(int32_t id, obj_ptr<HeapGraphNode_base>& retVal)
 {
-	std::map<int32_t, int32_t>::iterator it;
+	int32_t pos = _nodes.find(id);
 
-	it = _nodes.find(id);
-	if (it != _nodes.end())
+	if (pos >= 0)
 	{
 		Variant v;
 
-		m_nodes->_indexed_getter(it->second, v);
+		m_nodes->_indexed_getter(pos, v);
 		retVal = (HeapGraphNode*)v.object();
 	}
 	else
@@ -253,6 +253,7 @@ result_t HeapSnapshot::load(const char* fname)
 	int32_t node_pos = 0, edge_pos = 0;
 
 	m_nodes = new List();
+	_nodes.reserve(node_count);
 	while (node_pos < node_count)
 	{
 		int32_t _base = node_pos * (int32_t)node_fields.size();
@@ -304,12 +305,13 @@ result_t HeapSnapshot::load(const char* fname)
 		obj_ptr<HeapGraphNode> _node = new HeapGraphNode(_node_type,
 		        _node_name, _node_id, _node_size, _edges);
 
-		_nodes.insert(std::pair<int32_t, int32_t>(_node_id, node_pos));
+		_nodes.add(_node_id, node_pos);
 		m_nodes->append(_node);
 
 		node_pos ++;
 	}
 
+	_nodes.sort();
 	m_nodes->freeze();
 
 	return 0;
@@ -522,7 +524,7 @@ result_t HeapSnapshot::save(const char* fname, AsyncEvent* ac)
 				_name_id = _ids.id(_name);
 
 			_toid = edge->toid();
-			_toindex = _nodes.find(_toid)->second * 6;
+			_toindex = _nodes.find(_toid) * 6;
 
 			if (i == 0 && j == 0)
 				n = sprintf(buf, "%d,%d,%d\n", _type, _name_id, _toindex);
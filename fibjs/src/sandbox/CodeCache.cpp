@@ -0,0 +1,198 @@
+/*
+ * CodeCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/vm.h"
+#include "ifs/fs.h"
+#include "CodeCache.h"
+#include "Buffer.h"
+#include "path.h"
+#include <stdio.h>
+
+namespace fibjs
+{
+
+std::string CodeCache::s_dir;
+
+enum
+{
+    CACHE_HITS = 0,
+    CACHE_MISSES,
+    CACHE_REJECTED,
+    CACHE_WRITES
+};
+
+static Stats *create_stats()
+{
+    static const char *s_Counter[] =
+    { "hits", "misses", "rejected", "writes" };
+
+    Stats *stats = new Stats();
+
+    stats->Ref();
+    stats->init(s_Counter, 4);
+    stats->set_name("vm_code_cache");
+
+    return stats;
+}
+
+Stats *CodeCache::stats()
+{
+    static Stats *s_stats = create_stats();
+    return s_stats;
+}
+
+inline uint64_t fnv_hash(const char *p, size_t sz)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    while (sz --)
+    {
+        h ^= (uint8_t) * p++;
+        h *= 1099511628211ull;
+    }
+
+    return h;
+}
+
+static void cache_file(const char *fname, std::string &retVal)
+{
+    char buf[32];
+
+    sprintf(buf, "%016llx.cache", (unsigned long long)fnv_hash(fname, qstrlen(fname)));
+
+    retVal = CodeCache::s_dir;
+    pathAdd(retVal, buf);
+}
+
+static bool cache_header(const char *fname, const std::string &src, std::string &retVal)
+{
+    obj_ptr<Stat_base> st;
+    date_t mtime;
+    char buf[128];
+    result_t hr;
+
+    hr = fs_base::ac_stat(fname, st);
+    if (hr < 0)
+        return false;
+
+    st->get_mtime(mtime);
+
+    sprintf(buf, "%.0f:%d:%016llx\n", mtime.diff(date_t(0.0)), (int32_t)src.length(),
+            (unsigned long long)fnv_hash(src.c_str(), src.length()));
+
+    retVal = "fibjs code cache:";
+    retVal.append(v8::V8::GetVersion());
+    retVal += ':';
+    retVal.append(fname);
+    retVal += ':';
+    retVal.append(buf);
+
+    return true;
+}
+
+bool CodeCache::load(const char *fname, const std::string &src, std::string &data)
+{
+    std::string strFile;
+    std::string strHeader;
+    result_t hr;
+
+    if (!enabled())
+        return false;
+
+    if (!cache_header(fname, src, strHeader))
+        return false;
+
+    cache_file(fname, strFile);
+    hr = fs_base::ac_readFile(strFile.c_str(), data);
+    if (hr < 0 || data.length() <= strHeader.length() ||
+            data.compare(0, strHeader.length(), strHeader))
+    {
+        data.clear();
+        stats()->inc(CACHE_MISSES);
+        return false;
+    }
+
+    data.erase(0, strHeader.length());
+    stats()->inc(CACHE_HITS);
+
+    return true;
+}
+
+void CodeCache::save(const char *fname, const std::string &src,
+                     const uint8_t *data, int32_t length)
+{
+    std::string strFile;
+    std::string strTemp;
+    std::string strHeader;
+    obj_ptr<File_base> f;
+    result_t hr;
+
+    if (!enabled())
+        return;
+
+    if (!cache_header(fname, src, strHeader))
+        return;
+
+    cache_file(fname, strFile);
+    strTemp = strFile + ".tmp";
+
+    hr = fs_base::ac_open(strTemp.c_str(), "w", f);
+    if (hr < 0)
+    {
+        fs_base::ac_mkdir(s_dir.c_str(), 0755);
+
+        hr = fs_base::ac_open(strTemp.c_str(), "w", f);
+        if (hr < 0)
+            return;
+    }
+
+    strHeader.append((const char *)data, length);
+
+    obj_ptr<Buffer_base> buf = new Buffer(strHeader);
+
+    hr = f->ac_write(buf);
+    f->ac_close();
+
+    if (hr < 0 || fs_base::ac_rename(strTemp.c_str(), strFile.c_str()) < 0)
+    {
+        fs_base::ac_unlink(strTemp.c_str());
+        return;
+    }
+
+    stats()->inc(CACHE_WRITES);
+}
+
+void CodeCache::reject(const char *fname)
+{
+    std::string strFile;
+
+    cache_file(fname, strFile);
+    fs_base::ac_unlink(strFile.c_str());
+
+    stats()->dec(CACHE_HITS);
+    stats()->inc(CACHE_REJECTED);
+}
+
+result_t vm_base::get_codeCacheDir(std::string &retVal)
+{
+    retVal = CodeCache::s_dir;
+    return 0;
+}
+
+result_t vm_base::set_codeCacheDir(const char *newVal)
+{
+    CodeCache::s_dir = newVal;
+    return 0;
+}
+
+result_t vm_base::get_codeCacheStats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = CodeCache::stats();
+    return 0;
+}
+
+} /* namespace fibjs */
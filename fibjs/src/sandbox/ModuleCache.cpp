@@ -0,0 +1,212 @@
+/*
+ * ModuleCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "ifs/vm.h"
+#include "ifs/fs.h"
+#include "ModuleCache.h"
+#include "date.h"
+#include <map>
+
+namespace fibjs
+{
+
+bool ModuleCache::s_enabled = true;
+
+enum
+{
+    MODULE_ENTRIES = 0,
+    MODULE_PROBES,
+    MODULE_HITS
+};
+
+// a module may be added while the process runs, so a failed lookup is only
+// trusted for a short while. found modules are kept until cleared.
+#define MODULE_MISS_TTL 1000
+
+class _result
+{
+public:
+    _result(result_t hr) :
+        m_hr(hr)
+    {
+        m_time.now();
+    }
+
+    bool expired() const
+    {
+        date_t d;
+
+        d.now();
+        return d.diff(m_time) > MODULE_MISS_TTL;
+    }
+
+public:
+    result_t m_hr;
+    date_t m_time;
+};
+
+class _resolved: public _result
+{
+public:
+    _resolved(const std::string &fname, result_t hr) :
+        _result(hr), m_fname(fname)
+    {
+    }
+
+public:
+    std::string m_fname;
+};
+
+static std::map<std::string, _result> s_result;
+static std::map<std::string, _resolved> s_resolved;
+
+static Stats *create_stats()
+{
+    static const char *s_staticCounter[] =
+    { "entries" };
+    static const char *s_Counter[] =
+    { "probes", "hits" };
+
+    Stats *stats = new Stats();
+
+    stats->Ref();
+    stats->init(s_staticCounter, 1, s_Counter, 2);
+    stats->set_name("vm_module_cache");
+
+    return stats;
+}
+
+Stats *ModuleCache::stats()
+{
+    static Stats *s_stats = create_stats();
+    return s_stats;
+}
+
+result_t ModuleCache::readFile(const std::string &fname, std::string &retVal)
+{
+    Stats *stats = ModuleCache::stats();
+    result_t hr;
+
+    if (s_enabled)
+    {
+        std::map<std::string, _result>::iterator it = s_result.find(fname);
+
+        if (it != s_result.end())
+        {
+            if (!it->second.expired())
+            {
+                stats->inc(MODULE_HITS);
+                return it->second.m_hr;
+            }
+
+            s_result.erase(it);
+            stats->dec(MODULE_ENTRIES);
+        }
+    }
+
+    stats->inc(MODULE_PROBES);
+
+    hr = fs_base::ac_readFile(fname.c_str(), retVal);
+    if (s_enabled && (hr == CALL_E_FILE_NOT_FOUND || hr == CALL_E_PATH_NOT_FOUND))
+    {
+        if (s_result.insert(std::pair<std::string, _result>(fname, _result(hr))).second)
+            stats->inc(MODULE_ENTRIES);
+    }
+
+    return hr;
+}
+
+inline std::string resolve_key(const std::string &dir, const std::string &id)
+{
+    std::string key(dir);
+
+    key += '\0';
+    key.append(id);
+
+    return key;
+}
+
+bool ModuleCache::lookup(const std::string &dir, const std::string &id,
+                         std::string &fname, result_t &hr)
+{
+    if (!s_enabled)
+        return false;
+
+    std::map<std::string, _resolved>::iterator it = s_resolved.find(resolve_key(dir, id));
+
+    if (it == s_resolved.end())
+        return false;
+
+    if (it->second.m_hr < 0 && it->second.expired())
+    {
+        s_resolved.erase(it);
+        stats()->dec(MODULE_ENTRIES);
+        return false;
+    }
+
+    fname = it->second.m_fname;
+    hr = it->second.m_hr;
+    stats()->inc(MODULE_HITS);
+
+    return true;
+}
+
+void ModuleCache::save(const std::string &dir, const std::string &id,
+                       const std::string &fname, result_t hr)
+{
+    if (!s_enabled)
+        return;
+
+    std::string key = resolve_key(dir, id);
+    std::map<std::string, _resolved>::iterator it = s_resolved.find(key);
+
+    if (it != s_resolved.end())
+    {
+        it->second = _resolved(fname, hr);
+        return;
+    }
+
+    s_resolved.insert(std::pair<std::string, _resolved>(key, _resolved(fname, hr)));
+    stats()->inc(MODULE_ENTRIES);
+}
+
+void ModuleCache::clear()
+{
+    stats()->add(MODULE_ENTRIES, -(int32_t)(s_result.size() + s_resolved.size()));
+
+    s_result.clear();
+    s_resolved.clear();
+}
+
+result_t vm_base::get_moduleCache(bool &retVal)
+{
+    retVal = ModuleCache::s_enabled;
+    return 0;
+}
+
+result_t vm_base::set_moduleCache(bool newVal)
+{
+    ModuleCache::s_enabled = newVal;
+    if (!newVal)
+        ModuleCache::clear();
+
+    return 0;
+}
+
+result_t vm_base::get_moduleCacheStats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = ModuleCache::stats();
+    return 0;
+}
+
+result_t vm_base::clearModuleCache()
+{
+    ModuleCache::clear();
+    return 0;
+}
+
+} /* namespace fibjs */
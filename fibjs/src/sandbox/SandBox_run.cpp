@@ -6,6 +6,8 @@
  */
 
 #include "SandBox.h"
+#include "CodeCache.h"
+#include "ModuleCache.h"
 
 #include "ifs/vm.h"
 #include "ifs/fs.h"
@@ -192,10 +194,26 @@ result_t SandBox::Context::run(std::string src, const char *name, const char **a
     std::string pname;
     path_base::dirname(name, pname);
 
+    std::string str("(function(");
+    int32_t i;
+
+    for (i = 0; i < argCount; i ++)
+    {
+        str += argNames[i];
+        if (i < argCount - 1)
+            str += ',';
+    }
+
+    str = str + ",__filename,__dirname,__sbname){" + src + "\n});";
+
+    std::string cache;
+    bool bCache = CodeCache::load(name, str, cache);
+
     v8::Local<v8::Script> script;
     {
         TryCatch try_catch;
 
+        if (!bCache)
         {
             v8::ScriptCompiler::Source script_source(
                 v8::String::NewFromUtf8(isolate->m_isolate, src.c_str(),
@@ -207,24 +225,28 @@ result_t SandBox::Context::run(std::string src, const char *name, const char **a
                 return throwSyntaxError(try_catch);
         }
 
-        std::string str("(function(");
-        int32_t i;
+        v8::ScriptCompiler::Source script_source(
+            v8::String::NewFromUtf8(isolate->m_isolate, str.c_str(),
+                                    v8::String::kNormalString, (int32_t) str.length()),
+            v8::ScriptOrigin(soname),
+            bCache ? new v8::ScriptCompiler::CachedData((const uint8_t *)cache.c_str(),
+                    (int32_t)cache.length()) : NULL);
+
+        script = v8::ScriptCompiler::Compile(isolate->m_isolate, &script_source,
+                                             bCache ? v8::ScriptCompiler::kConsumeCodeCache :
+                                             CodeCache::enabled() ? v8::ScriptCompiler::kProduceCodeCache :
+                                             v8::ScriptCompiler::kNoCompileOptions);
+        if (script.IsEmpty())
+            return throwSyntaxError(try_catch);
 
-        for (i = 0; i < argCount; i ++)
+        const v8::ScriptCompiler::CachedData *cd = script_source.GetCachedData();
+        if (bCache)
         {
-            str += argNames[i];
-            if (i < argCount - 1)
-                str += ',';
+            if (cd && cd->rejected)
+                CodeCache::reject(name);
         }
-
-        src = str + ",__filename,__dirname,__sbname){" + src + "\n});";
-
-        script = v8::Script::Compile(
-                     v8::String::NewFromUtf8(isolate->m_isolate, src.c_str(),
-                                             v8::String::kNormalString, (int32_t) src.length()),
-                     soname);
-        if (script.IsEmpty())
-            return throwSyntaxError(try_catch);
+        else if (cd)
+            CodeCache::save(name, str, cd->data, cd->length);
     }
 
     v8::Local<v8::Value> v = script->Run();
@@ -403,19 +425,19 @@ result_t SandBox::require(std::string base, std::string id,
         strId = m_root;
         pathAdd(strId, fname.c_str());
 
-        hr = fs_base::ac_readFile(strId.c_str(), buf);
+        hr = ModuleCache::readFile(strId, buf);
         if (hr >= 0)
             return addScript(strId.c_str(), buf.c_str(), retVal);
     }
     else
     {
         fname = fullname + ".js";
-        hr = fs_base::ac_readFile(fname.c_str(), buf);
+        hr = ModuleCache::readFile(fname, buf);
         if (hr >= 0)
             return addScript(fname.c_str(), buf.c_str(), retVal);
 
         fname = fullname + ".json";
-        hr = fs_base::ac_readFile(fname.c_str(), buf);
+        hr = ModuleCache::readFile(fname, buf);
         if (hr >= 0)
             return addScript(fname.c_str(), buf.c_str(), retVal);
 
@@ -423,7 +445,7 @@ result_t SandBox::require(std::string base, std::string id,
             return hr;
 
         fname = fullname + PATH_SLASH + "package.json";
-        hr = fs_base::ac_readFile(fname.c_str(), buf);
+        hr = ModuleCache::readFile(fname, buf);
         if (hr >= 0)
         {
             v8::Local<v8::Value> v;
@@ -479,6 +501,24 @@ result_t SandBox::require(std::string base, std::string id,
     if (!base.empty())
     {
         std::string str, str1;
+        std::string strDir;
+
+        path_base::dirname(base.c_str(), strDir);
+        if (ModuleCache::lookup(strDir, strId, fname, hr))
+        {
+            if (hr < 0)
+                return hr;
+
+            hr = require(base, fname, retVal, NO_SEARCH);
+            if (hr >= 0)
+            {
+                InstallModule(strId, retVal);
+                return 0;
+            }
+
+            if (hr != CALL_E_FILE_NOT_FOUND && hr != CALL_E_PATH_NOT_FOUND)
+                return hr;
+        }
 
         str = base;
         while (true)
@@ -499,6 +539,7 @@ result_t SandBox::require(std::string base, std::string id,
             hr = require(base, fname, retVal, NO_SEARCH);
             if (hr >= 0)
             {
+                ModuleCache::save(strDir, strId, fname, 0);
                 InstallModule(strId, retVal);
                 return 0;
             }
@@ -506,6 +547,8 @@ result_t SandBox::require(std::string base, std::string id,
             if (hr != CALL_E_FILE_NOT_FOUND && hr != CALL_E_PATH_NOT_FOUND)
                 return hr;
         }
+
+        ModuleCache::save(strDir, strId, "", hr);
     }
 
     return hr;
@@ -7,6 +7,7 @@
 
 #include "SslServer.h"
 #include "JSHandler.h"
+#include "LimitHandler.h"
 
 namespace fibjs
 {
@@ -141,6 +142,11 @@ result_t SslServer::set_handler(Handler_base *newVal)
     return m_handler->set_handler(newVal);
 }
 
+result_t SslServer::limit(v8::Local<v8::Object> opts, obj_ptr<LimitHandler_base> &retVal)
+{
+    return LimitHandler::limit(this, opts, retVal);
+}
+
 result_t SslServer::get_verification(int32_t &retVal)
 {
     return m_handler->get_verification(retVal);
@@ -89,6 +89,7 @@ SslSocket::SslSocket()
     mbedtls_ssl_conf_max_version(&m_ssl_conf, MBEDTLS_SSL_MAJOR_VERSION_3, g_ssl.m_max_version);
 
     m_recv_pos = 0;
+    m_resumed = false;
 }
 
 SslSocket::~SslSocket()
@@ -103,6 +104,9 @@ result_t SslSocket::setCert(X509Cert_base *crt, PKey_base *key)
     result_t hr;
     bool priv;
 
+    if (m_accept_conf)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
     hr = key->isPrivate(priv);
     if (hr < 0)
         return hr;
@@ -118,9 +122,118 @@ result_t SslSocket::setCert(X509Cert_base *crt, PKey_base *key)
     m_crts.push_back(crt);
     m_keys.push_back(key);
 
+    m_conf_lock.lock();
+    m_server_conf.Release();
+    m_conf_lock.unlock();
+
     return 0;
 }
 
+result_t SslSocket::_server_conf::init(SslSocket *pThis)
+{
+    int32_t sz = (int32_t)pThis->m_crts.size();
+    int32_t i;
+    int32_t ret;
+
+    mbedtls_ssl_config_defaults(&m_conf,
+                                MBEDTLS_SSL_IS_SERVER,
+                                MBEDTLS_SSL_TRANSPORT_STREAM,
+                                MBEDTLS_SSL_PRESET_DEFAULT);
+    mbedtls_ssl_conf_authmode(&m_conf, pThis->m_ssl_conf.authmode);
+    mbedtls_ssl_conf_rng(&m_conf, mbedtls_ctr_drbg_random, &g_ssl.ctr_drbg);
+
+    mbedtls_ssl_conf_min_version(&m_conf, MBEDTLS_SSL_MAJOR_VERSION_3, g_ssl.m_min_version);
+    mbedtls_ssl_conf_max_version(&m_conf, MBEDTLS_SSL_MAJOR_VERSION_3, g_ssl.m_max_version);
+
+    for (i = 0; i < sz; i ++)
+    {
+        ret = mbedtls_ssl_conf_own_cert(&m_conf, &((X509Cert *)(X509Cert_base *)pThis->m_crts[i])->m_crt,
+                                        &((PKey *)(PKey_base *)pThis->m_keys[i])->m_key);
+        if (ret != 0)
+            return CHECK_ERROR(_ssl::setError(ret));
+    }
+
+    m_crts = pThis->m_crts;
+    m_keys = pThis->m_keys;
+
+    ret = mbedtls_ssl_conf_dh_param(&m_conf,
+                                    MBEDTLS_DHM_RFC5114_MODP_2048_P,
+                                    MBEDTLS_DHM_RFC5114_MODP_2048_G);
+    if (ret != 0)
+        return CHECK_ERROR(_ssl::setError(ret));
+
+    // the chain is shared, certificates loaded into ca later are seen
+    if (!pThis->m_ca)
+        pThis->m_ca = new X509Cert();
+    m_ca = pThis->m_ca;
+    mbedtls_ssl_conf_ca_chain(&m_conf, &m_ca->m_crt, NULL);
+
+    mbedtls_ssl_conf_session_cache(&m_conf, &g_ssl.m_cache,
+                                   mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
+
+#ifdef MBEDTLS_SSL_TICKET_C
+    if (g_ssl.m_ticket_lifetime > 0)
+    {
+        ret = mbedtls_ssl_ticket_setup(&m_ticket, mbedtls_ctr_drbg_random, &g_ssl.ctr_drbg,
+                                       MBEDTLS_CIPHER_AES_256_GCM, g_ssl.m_ticket_lifetime);
+        if (ret != 0)
+            return CHECK_ERROR(_ssl::setError(ret));
+
+        mbedtls_ssl_conf_session_tickets_cb(&m_conf, ticket_write, ticket_parse, this);
+    }
+#endif
+
+    return 0;
+}
+
+#ifdef MBEDTLS_SSL_TICKET_C
+int32_t SslSocket::_server_conf::ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+        unsigned char *start, const unsigned char *end,
+        size_t *tlen, uint32_t *lifetime)
+{
+    _server_conf *pThis = (_server_conf *)p_ticket;
+    int32_t ret;
+
+    pThis->m_ticket_lock.lock();
+    ret = mbedtls_ssl_ticket_write(&pThis->m_ticket, session, start, end, tlen, lifetime);
+    pThis->m_ticket_lock.unlock();
+
+    return ret;
+}
+
+int32_t SslSocket::_server_conf::ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+        unsigned char *buf, size_t len)
+{
+    _server_conf *pThis = (_server_conf *)p_ticket;
+    int32_t ret;
+
+    pThis->m_ticket_lock.lock();
+    ret = mbedtls_ssl_ticket_parse(&pThis->m_ticket, session, buf, len);
+    pThis->m_ticket_lock.unlock();
+
+    return ret;
+}
+#endif
+
+result_t SslSocket::server_conf(obj_ptr<_server_conf> &retVal)
+{
+    result_t hr = 0;
+
+    m_conf_lock.lock();
+    if (!m_server_conf)
+    {
+        obj_ptr<_server_conf> conf = new _server_conf();
+
+        hr = conf->init(this);
+        if (hr >= 0)
+            m_server_conf = conf;
+    }
+    retVal = m_server_conf;
+    m_conf_lock.unlock();
+
+    return hr;
+}
+
 int32_t SslSocket::my_recv(unsigned char *buf, size_t len)
 {
     if (!len)
@@ -313,16 +426,26 @@ result_t SslSocket::set_verification(int32_t newVal)
     if (newVal < ssl_base::_VERIFY_NONE || newVal > ssl_base::_VERIFY_REQUIRED)
         return CHECK_ERROR(CALL_E_INVALIDARG);
 
+    if (m_accept_conf)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
     mbedtls_ssl_conf_authmode(&m_ssl_conf, newVal);
+
+    m_conf_lock.lock();
+    m_server_conf.Release();
+    m_conf_lock.unlock();
+
     return 0;
 }
 
 result_t SslSocket::get_ca(obj_ptr<X509Cert_base> &retVal)
 {
+    m_conf_lock.lock();
     if (!m_ca)
         m_ca = new X509Cert();
-
     retVal = m_ca;
+    m_conf_lock.unlock();
+
     return 0;
 }
 
@@ -344,6 +467,12 @@ result_t SslSocket::get_peerCert(obj_ptr<X509Cert_base> &retVal)
     return 0;
 }
 
+result_t SslSocket::get_resumed(bool &retVal)
+{
+    retVal = m_resumed;
+    return 0;
+}
+
 result_t SslSocket::handshake(int32_t *retVal, AsyncEvent *ac)
 {
     class asyncHandshake: public asyncSsl
@@ -357,7 +486,21 @@ result_t SslSocket::handshake(int32_t *retVal, AsyncEvent *ac)
     public:
         virtual int32_t process()
         {
-            return mbedtls_ssl_handshake(&m_pThis->m_ssl);
+            mbedtls_ssl_context *ssl = &m_pThis->m_ssl;
+            int32_t ret = 0;
+
+            // step by hand, handshake state is freed once it is over
+            while (ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER)
+            {
+                if (ssl->handshake)
+                    m_pThis->m_resumed = ssl->handshake->resume != 0;
+
+                ret = mbedtls_ssl_handshake_step(ssl);
+                if (ret != 0)
+                    break;
+            }
+
+            return ret;
         }
 
         virtual int32_t finally()
@@ -365,6 +508,14 @@ result_t SslSocket::handshake(int32_t *retVal, AsyncEvent *ac)
             if (m_retVal)
                 *m_retVal = mbedtls_ssl_get_verify_result(&m_pThis->m_ssl);
 
+            if (!m_pThis->m_session_key.empty())
+            {
+                if (mbedtls_ssl_get_verify_result(&m_pThis->m_ssl) == 0)
+                    g_ssl.m_sessions.put(m_pThis->m_session_key, &m_pThis->m_ssl);
+                else
+                    g_ssl.m_sessions.remove(m_pThis->m_session_key);
+            }
+
             return 0;
         }
 
@@ -401,6 +552,9 @@ result_t SslSocket::connect(Stream_base *s, const char *server_name,
     if (server_name && *server_name)
         mbedtls_ssl_set_hostname(&m_ssl, server_name);
 
+    if (!m_session_key.empty())
+        g_ssl.m_sessions.get(m_session_key, &m_ssl);
+
     return handshake(&retVal, ac);
 }
 
@@ -413,40 +567,23 @@ result_t SslSocket::accept(Stream_base *s, obj_ptr<SslSocket_base> &retVal,
     if (!ac)
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    obj_ptr<SslSocket> ss = new SslSocket();
-    retVal = ss;
-    int32_t sz = (int32_t)m_crts.size();
-    int32_t i;
+    obj_ptr<_server_conf> conf;
     result_t hr;
     int32_t ret;
 
-    for (i = 0; i < sz; i ++)
-    {
-        hr = ss->setCert(m_crts[i], m_keys[i]);
-        if (hr < 0)
-            return hr;
-    }
+    hr = server_conf(conf);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<SslSocket> ss = new SslSocket();
+    retVal = ss;
 
     ss->m_s = s;
+    ss->m_ca = m_ca;
+    ss->m_accept_conf = conf;
     mbedtls_ssl_conf_authmode(&ss->m_ssl_conf, m_ssl_conf.authmode);
-    mbedtls_ssl_conf_endpoint(&ss->m_ssl_conf, MBEDTLS_SSL_IS_SERVER);
-
-    ret = mbedtls_ssl_conf_dh_param( &ss->m_ssl_conf,
-                                     MBEDTLS_DHM_RFC5114_MODP_2048_P,
-                                     MBEDTLS_DHM_RFC5114_MODP_2048_G);
-    if (ret != 0)
-        return CHECK_ERROR(_ssl::setError(ret));
-
-    if (m_ca)
-    {
-        ss->m_ca = m_ca;
-        mbedtls_ssl_conf_ca_chain(&ss->m_ssl_conf, &m_ca->m_crt, NULL);
-    }
-
-    mbedtls_ssl_conf_session_cache(&ss->m_ssl_conf, &g_ssl.m_cache,
-                                   mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
 
-    ret = mbedtls_ssl_setup(&ss->m_ssl, &ss->m_ssl_conf);
+    ret = mbedtls_ssl_setup(&ss->m_ssl, &conf->m_conf);
     if (ret != 0)
         return CHECK_ERROR(_ssl::setError(ret));
 
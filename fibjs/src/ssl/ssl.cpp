@@ -33,8 +33,10 @@ result_t ssl_base::connect(const char *url, obj_ptr<Stream_base> &retVal,
     {
     public:
         asyncConnect(const std::string host, int32_t port, bool ipv6,
+                     const std::string session_key,
                      obj_ptr<Stream_base> &retVal, AsyncEvent *ac) :
-            AsyncState(ac), m_host(host), m_port(port), m_ipv6(ipv6), m_retVal(retVal)
+            AsyncState(ac), m_host(host), m_port(port), m_ipv6(ipv6),
+            m_session_key(session_key), m_retVal(retVal)
         {
             set(connect);
         }
@@ -58,6 +60,7 @@ result_t ssl_base::connect(const char *url, obj_ptr<Stream_base> &retVal,
             pThis->set(ok);
 
             pThis->m_ssl_sock = new SslSocket();
+            pThis->m_ssl_sock->m_session_key = pThis->m_session_key;
 
             if (g_ssl.m_crt && g_ssl.m_key)
             {
@@ -81,6 +84,7 @@ result_t ssl_base::connect(const char *url, obj_ptr<Stream_base> &retVal,
         const std::string m_host;
         int32_t m_port;
         bool m_ipv6;
+        const std::string m_session_key;
         obj_ptr<Stream_base> &m_retVal;
         obj_ptr<Socket> m_sock;
         obj_ptr<SslSocket> m_ssl_sock;
@@ -104,7 +108,7 @@ result_t ssl_base::connect(const char *url, obj_ptr<Stream_base> &retVal,
 
     int32_t nPort = atoi(u->m_port.c_str());
 
-    return (new asyncConnect(u->m_hostname, nPort, u->m_ipv6,
+    return (new asyncConnect(u->m_hostname, nPort, u->m_ipv6, u->m_host,
                              retVal, ac))->post(0);
 }
 
@@ -179,5 +183,20 @@ result_t ssl_base::set_max_version(int32_t newVal)
     return 0;
 }
 
+result_t ssl_base::get_ticket_lifetime(int32_t& retVal)
+{
+    retVal = g_ssl.m_ticket_lifetime;
+    return 0;
+}
+
+result_t ssl_base::set_ticket_lifetime(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    g_ssl.m_ticket_lifetime = newVal;
+    return 0;
+}
+
 
 }
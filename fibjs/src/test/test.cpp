@@ -11,6 +11,9 @@
 #include "Expect.h"
 #include "date.h"
 #include "console.h"
+#include "Ticks.h"
+#include <vector>
+#include <algorithm>
 
 namespace fibjs
 {
@@ -375,6 +378,217 @@ result_t test_base::run(int32_t loglevel, int32_t& retVal)
     return _case::run(loglevel, retVal);
 }
 
+#define BENCH_MAX_SAMPLES   100000
+
+inline double bench_percentile(std::vector<double> &samples, double p)
+{
+    return samples[(size_t)((samples.size() - 1) * p / 100 + 0.5)];
+}
+
+inline void bench_set(Isolate *isolate, v8::Local<v8::Object> o,
+                      const char *key, double v)
+{
+    o->Set(v8::String::NewFromUtf8(isolate->m_isolate, key),
+           v8::Number::New(isolate->m_isolate, v));
+}
+
+result_t test_base::bench(const char *name, v8::Local<v8::Function> fn,
+                          v8::Local<v8::Object> opts, v8::Local<v8::Object> &retVal)
+{
+    Isolate* isolate = Isolate::now();
+    v8::Local<v8::Value> v;
+    v8::Local<v8::Object> baseline;
+    int32_t warmup = 100;
+    int32_t time = 1000;
+    double threshold = 10;
+    double base_ops = 0;
+    result_t hr;
+
+    hr = GetConfigValue(opts, "warmup", warmup);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(opts, "time", time);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(opts, "threshold", threshold);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    if (warmup < 0 || time < 1 || threshold < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    hr = GetConfigValue(opts, "baseline", baseline);
+    if (hr >= 0)
+    {
+        v8::Local<v8::Object> o;
+
+        hr = GetConfigValue(baseline, name, o);
+        if (hr >= 0)
+            baseline = o;
+
+        hr = GetConfigValue(baseline, "ops", base_ops);
+        if (hr < 0 || base_ops <= 0)
+            return CHECK_ERROR(Runtime::setError("test: invalid baseline."));
+    }
+    else if (hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    std::vector<double> samples;
+    int64_t count = 0;
+    int64_t timed = 0;
+    int64_t t0, t1, t2;
+    int64_t cost = -1;
+    int64_t read;
+    int64_t batch;
+    int64_t elapsed;
+    uint64_t seed = 88172645463325252ull;
+    double min = 0, max = 0;
+    int32_t i;
+
+    // the cost of reading the clock is taken off every sample
+    t0 = Ticks();
+    for (i = 0; i < 100; i ++)
+    {
+        t1 = Ticks();
+        t2 = Ticks();
+        if (cost < 0 || t2 - t1 < cost)
+            cost = t2 - t1;
+    }
+    read = (Ticks() - t0) / 200 + 1;
+
+    t0 = Ticks();
+    do
+    {
+        v = fn->Call(v8::Undefined(isolate->m_isolate), 0, NULL);
+        if (v.IsEmpty())
+            return CALL_E_JAVASCRIPT;
+        count ++;
+    }
+    while ((t1 = Ticks()) - t0 < (int64_t)warmup * 1000000);
+
+    // calls run in batches of untimed calls followed by one timed call, the
+    // batch is sized from the warmup so reading the clock stays under 1%
+    // of the time. ops and mean come from the wall time of the whole phase,
+    // the single call samples only give min, max and the percentiles.
+    batch = read * 200 * count / (t1 - t0 + 1);
+    if (batch < 1)
+        batch = 1;
+    else if (batch > 10000)
+        batch = 10000;
+    count = 0;
+
+    samples.reserve(BENCH_MAX_SAMPLES);
+    t0 = Ticks();
+    do
+    {
+        double n;
+        int64_t k;
+
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        // a random length keeps the timed calls from locking onto a
+        // period of the function under test
+        k = batch > 1 ? (int64_t)(seed % (uint64_t)(batch * 2 - 1)) : 0;
+        while (k --)
+        {
+            v = fn->Call(v8::Undefined(isolate->m_isolate), 0, NULL);
+            if (v.IsEmpty())
+                return CALL_E_JAVASCRIPT;
+            count ++;
+        }
+
+        t1 = Ticks();
+        v = fn->Call(v8::Undefined(isolate->m_isolate), 0, NULL);
+        t2 = Ticks();
+        if (v.IsEmpty())
+            return CALL_E_JAVASCRIPT;
+        count ++;
+        timed ++;
+
+        n = (double)(t2 - t1 > cost ? t2 - t1 - cost : 0);
+
+        if (samples.empty() || n < min)
+            min = n;
+        if (samples.empty() || n > max)
+            max = n;
+
+        // past BENCH_MAX_SAMPLES the samples kept are a uniform reservoir
+        // of all timed calls
+        if (samples.size() < BENCH_MAX_SAMPLES)
+            samples.push_back(n);
+        else
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+
+            uint64_t j = seed % (uint64_t)timed;
+            if (j < BENCH_MAX_SAMPLES)
+                samples[(size_t)j] = n;
+        }
+    }
+    while ((elapsed = t2 - t0) < (int64_t)time * 1000000);
+
+    std::sort(samples.begin(), samples.end());
+
+    double ops = count * 1000000000.0 / elapsed;
+    double mean = (double)elapsed / count;
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+
+    o->Set(v8::String::NewFromUtf8(isolate->m_isolate, "name"),
+           v8::String::NewFromUtf8(isolate->m_isolate, name));
+    bench_set(isolate, o, "ops", ops);
+    bench_set(isolate, o, "count", (double)count);
+    bench_set(isolate, o, "samples", (double)samples.size());
+    bench_set(isolate, o, "mean", mean);
+    bench_set(isolate, o, "min", min);
+    bench_set(isolate, o, "max", max);
+    bench_set(isolate, o, "p50", bench_percentile(samples, 50));
+    bench_set(isolate, o, "p90", bench_percentile(samples, 90));
+    bench_set(isolate, o, "p99", bench_percentile(samples, 99));
+    bench_set(isolate, o, "p999", bench_percentile(samples, 99.9));
+
+    char buf[256];
+    std::string str("  ");
+
+    str.append(name);
+    sprintf(buf, ": %.0f ops/sec, p50 %.0fns, p99 %.0fns (%d samples)",
+            ops, bench_percentile(samples, 50), bench_percentile(samples, 99),
+            (int32_t)samples.size());
+    str.append(buf);
+
+    if (base_ops > 0)
+    {
+        double change = (ops - base_ops) * 100 / base_ops;
+
+        bench_set(isolate, o, "change", change);
+
+        sprintf(buf, " %+.1f%%", change);
+        if (change < -threshold)
+        {
+            str.append(logger::error());
+            str.append(buf);
+            str.append(COLOR_RESET);
+            asyncLog(console_base::_ERROR, str);
+
+            sprintf(buf, "test: bench '%.64s' regressed %.1f%%, threshold is %.1f%%.",
+                    name, -change, threshold);
+            return CHECK_ERROR(Runtime::setError(buf));
+        }
+
+        str.append(buf);
+    }
+
+    asyncLog(console_base::_INFO, str);
+
+    retVal = o;
+    return 0;
+}
+
 result_t test_base::expect(v8::Local<v8::Value> actual, const char *msg,
                            obj_ptr<Expect_base> &retVal)
 {
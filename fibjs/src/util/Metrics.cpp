@@ -0,0 +1,255 @@
+/*
+ * Metrics.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "Metrics.h"
+#include "Stats.h"
+#include <map>
+#include <stdio.h>
+
+namespace fibjs
+{
+
+void fiber_status(int32_t &fibers, int32_t &idle);
+void acpool_status(int32_t &threads, int32_t &idle, int32_t &queued);
+void reactor_status(int32_t &pending, int64_t &events);
+bool malloc_status(size_t &allocated, size_t &active, size_t &mapped);
+
+static exlib::spinlock s_lock;
+static std::map<int32_t, Stats *> s_stats;
+static int32_t s_id;
+
+enum
+{
+    GC_SCAVENGE = 0,
+    GC_MARK_SWEEP,
+    GC_OTHER
+};
+
+enum
+{
+    GC_PAUSE = 0
+};
+
+static Stats *s_gc;
+static date_t s_gcStart;
+static size_t s_heapTotal;
+static size_t s_heapUsed;
+static size_t s_heapLimit;
+
+int32_t Metrics::add(Stats *stats)
+{
+    int32_t id;
+
+    s_lock.lock();
+    id = ++s_id;
+    s_stats.insert(std::pair<int32_t, Stats *>(id, stats));
+    s_lock.unlock();
+
+    return id;
+}
+
+void Metrics::remove(int32_t id)
+{
+    s_lock.lock();
+    s_stats.erase(id);
+    s_lock.unlock();
+}
+
+void Metrics::lock()
+{
+    s_lock.lock();
+}
+
+void Metrics::unlock()
+{
+    s_lock.unlock();
+}
+
+void Metrics::label(std::string &retVal, const char *name, const std::string &value)
+{
+    const char *p = value.c_str();
+    const char *e = p + value.length();
+
+    retVal.append(name);
+    retVal.append("=\"", 2);
+
+    while (p < e)
+    {
+        char ch = *p++;
+
+        if (ch == '\\')
+            retVal.append("\\\\", 2);
+        else if (ch == '\"')
+            retVal.append("\\\"", 2);
+        else if (ch == '\n')
+            retVal.append("\\n", 2);
+        else
+            retVal += ch;
+    }
+
+    retVal += '\"';
+}
+
+void Metrics::value(std::string &retVal, int64_t v)
+{
+    char buf[32];
+    int32_t n = sprintf(buf, "%lld", (long long)v);
+
+    retVal.append(buf, n);
+}
+
+static void family(std::string &retVal, const char *name, const char *type,
+                   const char *help)
+{
+    retVal.append("# TYPE ", 7);
+    retVal.append(name);
+    retVal += ' ';
+    retVal.append(type);
+    retVal.append("\n# HELP ", 8);
+    retVal.append(name);
+    retVal += ' ';
+    retVal.append(help);
+    retVal += '\n';
+}
+
+static void gauge(std::string &retVal, const char *name, const char *help,
+                  int64_t v)
+{
+    family(retVal, name, "gauge", help);
+
+    retVal.append(name);
+    retVal += ' ';
+    Metrics::value(retVal, v);
+    retVal += '\n';
+}
+
+static void counter(std::string &retVal, const char *name, const char *help,
+                    int64_t v, bool bOpenMetrics)
+{
+    std::string strName(name);
+
+    strName.append("_total", 6);
+    family(retVal, bOpenMetrics ? name : strName.c_str(), "counter", help);
+
+    retVal.append(strName);
+    retVal += ' ';
+    Metrics::value(retVal, v);
+    retVal += '\n';
+}
+
+void Metrics::render(std::string &retVal, bool bOpenMetrics)
+{
+    std::map<int32_t, Stats *>::iterator it;
+    int32_t n1, n2, n3;
+    int64_t l1;
+    size_t s1, s2, s3;
+
+    fiber_status(n1, n2);
+    gauge(retVal, "fibjs_fibers", "Native fibers created by the fiber pool.", n1);
+    gauge(retVal, "fibjs_fibers_idle", "Native fibers waiting for a job.", n2);
+
+    acpool_status(n1, n2, n3);
+    gauge(retVal, "fibjs_async_threads", "Worker threads of the async call pool.", n1);
+    gauge(retVal, "fibjs_async_threads_idle", "Worker threads waiting for an async call.", n2);
+    gauge(retVal, "fibjs_async_queue", "Async calls waiting for a worker thread.", n3);
+
+    reactor_status(n1, l1);
+    gauge(retVal, "fibjs_reactor_pending", "Socket operations waiting on the reactor.", n1);
+    counter(retVal, "fibjs_reactor_events", "Socket events dispatched by the reactor.",
+            l1, bOpenMetrics);
+
+    gauge(retVal, "fibjs_v8_heap_total_bytes", "V8 heap size at the end of the last gc.",
+          (int64_t)s_heapTotal);
+    gauge(retVal, "fibjs_v8_heap_used_bytes", "V8 heap in use at the end of the last gc.",
+          (int64_t)s_heapUsed);
+    gauge(retVal, "fibjs_v8_heap_limit_bytes", "V8 heap size limit.",
+          (int64_t)s_heapLimit);
+
+    if (malloc_status(s1, s2, s3))
+    {
+        gauge(retVal, "fibjs_malloc_allocated_bytes", "Bytes allocated by the application.",
+              (int64_t)s1);
+        gauge(retVal, "fibjs_malloc_active_bytes", "Bytes in active pages of the allocator.",
+              (int64_t)s2);
+        gauge(retVal, "fibjs_malloc_mapped_bytes", "Bytes mapped by the allocator.",
+              (int64_t)s3);
+    }
+
+    s_lock.lock();
+
+    family(retVal, "fibjs_stats", "gauge", "Counters of Stats objects.");
+    for (it = s_stats.begin(); it != s_stats.end(); ++it)
+        it->second->render_counters(retVal);
+
+    family(retVal, "fibjs_stats_histogram", "histogram", "Histograms of Stats objects.");
+    for (it = s_stats.begin(); it != s_stats.end(); ++it)
+        it->second->render_histograms(retVal);
+
+    s_lock.unlock();
+
+    if (bOpenMetrics)
+        retVal.append("# EOF\n", 6);
+}
+
+static void heap_sample(v8::Isolate *isolate)
+{
+    v8::HeapStatistics v8_heap_stats;
+
+    isolate->GetHeapStatistics(&v8_heap_stats);
+
+    s_heapTotal = v8_heap_stats.total_heap_size();
+    s_heapUsed = v8_heap_stats.used_heap_size();
+    s_heapLimit = v8_heap_stats.heap_size_limit();
+}
+
+static void gc_prologue(v8::Isolate *isolate, v8::GCType type,
+                        v8::GCCallbackFlags flags)
+{
+    s_gcStart.now();
+}
+
+static void gc_epilogue(v8::Isolate *isolate, v8::GCType type,
+                        v8::GCCallbackFlags flags)
+{
+    date_t d;
+
+    d.now();
+
+    if (type == v8::kGCTypeScavenge)
+        s_gc->inc(GC_SCAVENGE);
+    else if (type == v8::kGCTypeMarkSweepCompact)
+        s_gc->inc(GC_MARK_SWEEP);
+    else
+        s_gc->inc(GC_OTHER);
+
+    s_gc->record(GC_PAUSE, (int64_t)(d.diff(s_gcStart) * 1000));
+
+    heap_sample(isolate);
+}
+
+void init_metrics()
+{
+    static const char *s_Counter[] =
+    { "scavenge", "mark_sweep", "other" };
+    static const char *s_Histogram[] =
+    { "pause" };
+
+    v8::Isolate *isolate = Isolate::now()->m_isolate;
+
+    s_gc = new Stats();
+    s_gc->Ref();
+    s_gc->init(s_Counter, 3);
+    s_gc->init_histograms(s_Histogram, 1);
+    s_gc->set_name("v8_gc");
+
+    heap_sample(isolate);
+
+    isolate->AddGCPrologueCallback(gc_prologue);
+    isolate->AddGCEpilogueCallback(gc_epilogue);
+}
+
+} /* namespace fibjs */
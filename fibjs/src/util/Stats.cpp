@@ -61,8 +61,110 @@ result_t Stats_base::_new(v8::Local<v8::Array> staticKeys,
     return 0;
 }
 
+result_t Stats_base::_new(v8::Local<v8::Array> staticKeys,
+                          v8::Local<v8::Array> keys, v8::Local<v8::Array> histograms,
+                          obj_ptr<Stats_base> &retVal, v8::Local<v8::Object> This)
+{
+    result_t hr = _new(staticKeys, keys, retVal, This);
+    if (hr < 0)
+        return hr;
+
+    Stats *pStats = (Stats *)(Stats_base *)retVal;
+    int32_t hn = histograms->Length();
+    int32_t i;
+
+    pStats->init_histograms(hn);
+
+    for (i = 0; i < hn; i++)
+    {
+        hr = pStats->set_histogram(i, histograms->Get(i));
+        if (hr < 0)
+            return hr;
+    }
+
+    return 0;
+}
+
+void Stats::_histogram::snapshot(std::vector<int64_t> &retVal, int64_t &count)
+{
+    int32_t i;
+
+    retVal.resize(BUCKETS);
+    count = 0;
+
+    for (i = 0; i < BUCKETS; i++)
+    {
+        retVal[i] = (int32_t)m_buckets[i];
+        count += retVal[i];
+    }
+}
+
+int32_t Stats::_histogram::index(int64_t value)
+{
+    int32_t shift = 0;
+
+    if (value < 0)
+        return 0;
+
+    if (value < SUB_COUNT * 2)
+        return (int32_t)value;
+
+    while ((value >> shift) >= SUB_COUNT * 2)
+        shift++;
+
+    if (shift > MAX_SHIFT)
+        return BUCKETS - 1;
+
+    return (shift + 1) * SUB_COUNT + (int32_t)(value >> shift) - SUB_COUNT;
+}
+
+int64_t Stats::_histogram::lower(int32_t idx)
+{
+    if (idx < SUB_COUNT * 2)
+        return idx;
+
+    int32_t shift = idx / SUB_COUNT - 1;
+    return (int64_t)(idx % SUB_COUNT + SUB_COUNT) << shift;
+}
+
+int64_t Stats::_histogram::upper(int32_t idx)
+{
+    if (idx < SUB_COUNT * 2)
+        return idx;
+
+    int32_t shift = idx / SUB_COUNT - 1;
+    return lower(idx) + ((int64_t)1 << shift) - 1;
+}
+
+int64_t Stats::_histogram::percentile(std::vector<int64_t> &buckets, int64_t count,
+                                      double p)
+{
+    int64_t target, total = 0;
+    int32_t i;
+
+    if (count == 0)
+        return 0;
+
+    target = (int64_t)(count * p / 100 + 0.5);
+    if (target < 1)
+        target = 1;
+
+    for (i = 0; i < BUCKETS; i++)
+    {
+        total += buckets[i];
+        if (total >= target)
+            return upper(i);
+    }
+
+    return upper(BUCKETS - 1);
+}
+
+// the object is already visible to Metrics::render, so the layout is
+// only changed under the metrics lock
 void Stats::init(int32_t sn, int32_t n)
 {
+    Metrics::lock();
+
     m_static = sn;
     m_size = n;
 
@@ -72,12 +174,16 @@ void Stats::init(int32_t sn, int32_t n)
     for (int32_t i = 0; i < m_size; i++)
         m_counters[i] = 0;
 
+    Metrics::unlock();
+
     m_date.now();
 }
 
 void Stats::set_key(int32_t n, const char *key)
 {
+    Metrics::lock();
     m_keys[n] = key;
+    Metrics::unlock();
 }
 
 result_t Stats::set_key(int32_t n, v8::Local<v8::Value> key)
@@ -92,6 +198,44 @@ result_t Stats::set_key(int32_t n, v8::Local<v8::Value> key)
     return 0;
 }
 
+void Stats::init_histograms(int32_t n)
+{
+    Metrics::lock();
+    m_hkeys.resize(n);
+    m_histograms.resize(n);
+    Metrics::unlock();
+}
+
+void Stats::set_histogram(int32_t n, const char *key)
+{
+    Metrics::lock();
+    m_hkeys[n] = key;
+    Metrics::unlock();
+}
+
+result_t Stats::set_histogram(int32_t n, v8::Local<v8::Value> key)
+{
+    v8::String::Utf8Value str(key);
+    const char *p = *str;
+    if (p == NULL)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    set_histogram(n, p);
+
+    return 0;
+}
+
+int32_t Stats::find_histogram(const char *key)
+{
+    int32_t i;
+
+    for (i = 0; i < (int32_t)m_hkeys.size(); i++)
+        if (!qstrcmp(key, m_hkeys[i].c_str()))
+            return i;
+
+    return -1;
+}
+
 int32_t Stats::find(const char *key)
 {
     int32_t i;
@@ -103,6 +247,24 @@ int32_t Stats::find(const char *key)
     return -1;
 }
 
+result_t Stats::get_name(std::string &retVal)
+{
+    Metrics::lock();
+    retVal = m_name;
+    Metrics::unlock();
+
+    return 0;
+}
+
+result_t Stats::set_name(const char *newVal)
+{
+    Metrics::lock();
+    m_name = newVal;
+    Metrics::unlock();
+
+    return 0;
+}
+
 result_t Stats::inc(const char *key)
 {
     int32_t i = find(key);
@@ -139,11 +301,98 @@ result_t Stats::add(const char *key, int32_t value)
     return 0;
 }
 
+result_t Stats::record(const char *key, double value)
+{
+    int32_t i = find_histogram(key);
+
+    if (i < 0)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    record(i, (int64_t)value);
+
+    return 0;
+}
+
+result_t Stats::percentile(const char *key, double p, double &retVal)
+{
+    int32_t i = find_histogram(key);
+    std::vector<int64_t> buckets;
+    int64_t count;
+
+    if (i < 0)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    if (p < 0 || p > 100)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_histograms[i].snapshot(buckets, count);
+    retVal = (double)_histogram::percentile(buckets, count, p);
+
+    return 0;
+}
+
+result_t Stats::histogram(const char *key, v8::Local<v8::Object> &retVal)
+{
+    int32_t i = find_histogram(key);
+    std::vector<int64_t> buckets;
+    int64_t count;
+    int64_t min = 0, max = 0;
+    bool bFirst = true;
+    double sum = 0;
+    int32_t j;
+
+    if (i < 0)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    m_histograms[i].snapshot(buckets, count);
+
+    for (j = 0; j < _histogram::BUCKETS; j++)
+        if (buckets[j])
+        {
+            if (bFirst)
+            {
+                min = _histogram::lower(j);
+                bFirst = false;
+            }
+            max = _histogram::upper(j);
+            sum += (double)buckets[j] * (_histogram::lower(j) + _histogram::upper(j)) / 2;
+        }
+
+    Isolate* isolate = Isolate::now();
+    retVal = v8::Object::New(isolate->m_isolate);
+
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "count"),
+                v8::Number::New(isolate->m_isolate, (double)count));
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "min"),
+                v8::Number::New(isolate->m_isolate, (double)min));
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "max"),
+                v8::Number::New(isolate->m_isolate, (double)max));
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "mean"),
+                v8::Number::New(isolate->m_isolate, count ? sum / count : 0));
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "p50"),
+                v8::Number::New(isolate->m_isolate,
+                                (double)_histogram::percentile(buckets, count, 50)));
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "p90"),
+                v8::Number::New(isolate->m_isolate,
+                                (double)_histogram::percentile(buckets, count, 90)));
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "p99"),
+                v8::Number::New(isolate->m_isolate,
+                                (double)_histogram::percentile(buckets, count, 99)));
+    retVal->Set(v8::String::NewFromUtf8(isolate->m_isolate, "p999"),
+                v8::Number::New(isolate->m_isolate,
+                                (double)_histogram::percentile(buckets, count, 99.9)));
+
+    return 0;
+}
+
 result_t Stats::reset()
 {
     for (int32_t i = m_static; i < m_size; i++)
         m_counters[i] = 0;
 
+    for (int32_t i = 0; i < (int32_t)m_histograms.size(); i++)
+        m_histograms[i].reset();
+
     m_date.now();
     return 0;
 }
@@ -186,4 +435,91 @@ result_t Stats::_named_enumerator(v8::Local<v8::Array> &retVal)
     return 0;
 }
 
+void Stats::render_counters(std::string &retVal)
+{
+    std::string strLabel;
+    int32_t i;
+
+    Metrics::label(strLabel, "name", m_name);
+    strLabel += ',';
+    strLabel.append("id=\"", 4);
+    Metrics::value(strLabel, m_id);
+    strLabel += '"';
+
+    for (i = 0; i < m_size; i++)
+    {
+        retVal.append("fibjs_stats{", 12);
+        retVal.append(strLabel);
+        retVal += ',';
+        Metrics::label(retVal, "key", m_keys[i]);
+        retVal.append("} ", 2);
+        Metrics::value(retVal, (int32_t)m_counters[i]);
+        retVal += '\n';
+    }
+}
+
+void Stats::render_histograms(std::string &retVal)
+{
+    std::string strLabel;
+    std::vector<int64_t> buckets;
+    int64_t count, total;
+    int32_t i, j, last;
+
+    if (m_histograms.size() == 0)
+        return;
+
+    Metrics::label(strLabel, "name", m_name);
+    strLabel += ',';
+    strLabel.append("id=\"", 4);
+    Metrics::value(strLabel, m_id);
+    strLabel += '"';
+
+    for (i = 0; i < (int32_t)m_histograms.size(); i++)
+    {
+        std::string strKey(strLabel);
+
+        strKey += ',';
+        Metrics::label(strKey, "key", m_hkeys[i]);
+
+        m_histograms[i].snapshot(buckets, count);
+
+        last = _histogram::SUB_COUNT - 1;
+        for (j = _histogram::BUCKETS - 1; j > last; j--)
+            if (buckets[j])
+            {
+                last = j | (_histogram::SUB_COUNT - 1);
+                break;
+            }
+
+        total = 0;
+        for (j = 0; j <= last; j++)
+        {
+            total += buckets[j];
+
+            if ((j & (_histogram::SUB_COUNT - 1)) == _histogram::SUB_COUNT - 1)
+            {
+                retVal.append("fibjs_stats_histogram_bucket{", 29);
+                retVal.append(strKey);
+                retVal.append(",le=\"", 5);
+                Metrics::value(retVal, _histogram::upper(j));
+                retVal.append("\"} ", 3);
+                Metrics::value(retVal, total);
+                retVal += '\n';
+            }
+        }
+
+        retVal.append("fibjs_stats_histogram_bucket{", 29);
+        retVal.append(strKey);
+        retVal.append(",le=\"+Inf\"} ", 11);
+        Metrics::value(retVal, count);
+        retVal += '\n';
+
+        retVal.append("fibjs_stats_histogram_count{", 28);
+        retVal.append(strKey);
+        retVal.append("} ", 2);
+        Metrics::value(retVal, count);
+        retVal += '\n';
+    }
+}
+
 } /* namespace fibjs */
@@ -8,6 +8,7 @@
 #include "ifs/mq.h"
 #include "WebSocketHandler.h"
 #include "WebSocketMessage.h"
+#include "WebSocketStream.h"
 #include "ifs/HttpRequest.h"
 #include "ifs/HttpResponse.h"
 #include "JSHandler.h"
@@ -50,10 +51,11 @@ result_t WebSocketHandler_base::_new(v8::Local<v8::Value> hdlr,
     return 0;
 }
 
-WebSocketHandler::WebSocketHandler() : m_maxSize(67108864)
+WebSocketHandler::WebSocketHandler() : m_maxSize(67108864), m_compress(false)
 {
     m_stats = new Stats();
     m_stats->init(s_staticCounter, 2, s_Counter, 3);
+    m_stats->set_name("websocket");
 }
 
 result_t WebSocketHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
@@ -63,7 +65,7 @@ result_t WebSocketHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
     {
     public:
         asyncInvoke(WebSocketHandler *pThis, HttpRequest_base *req, AsyncEvent *ac) :
-            AsyncState(ac), m_pThis(pThis), m_httpreq(req)
+            AsyncState(ac), m_pThis(pThis), m_httpreq(req), m_deflate(false)
         {
             obj_ptr<Message_base> rep;
 
@@ -132,10 +134,42 @@ result_t WebSocketHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
             pThis->m_httprep->addHeader("Upgrade", "websocket");
             pThis->m_httprep->set_upgrade(true);
 
-            pThis->set(read);
+            if (pThis->m_pThis->m_compress)
+            {
+                hr = pThis->m_httpreq->firstHeader("Sec-WebSocket-Extensions", v);
+                if (hr < 0)
+                    return hr;
+
+                if (hr != CALL_RETURN_NULL && pThis->m_param.parse(v.string().c_str()))
+                {
+                    pThis->m_deflate = true;
+                    pThis->m_httprep->addHeader("Sec-WebSocket-Extensions",
+                                                pThis->m_param.str().c_str());
+                }
+            }
+
+            pThis->set(upgrade);
             return pThis->m_httprep->sendTo(pThis->m_stm, pThis);
         }
 
+        static int32_t upgrade(AsyncState *pState, int32_t n)
+        {
+            asyncInvoke *pThis = (asyncInvoke *) pState;
+            obj_ptr<WebSocketStream> ws = new WebSocketStream(pThis->m_stm, true);
+
+            if (pThis->m_deflate)
+            {
+                result_t hr = ws->setDeflate(true, pThis->m_param);
+                if (hr < 0)
+                    return hr;
+            }
+
+            pThis->m_stm = ws;
+
+            pThis->set(read);
+            return 0;
+        }
+
         static int32_t read(AsyncState *pState, int32_t n)
         {
             asyncInvoke *pThis = (asyncInvoke *) pState;
@@ -231,6 +265,8 @@ result_t WebSocketHandler::invoke(object_base *v, obj_ptr<Handler_base> &retVal,
         obj_ptr<Stream_base> m_stm;
         obj_ptr<WebSocketMessage_base> m_msg;
         obj_ptr<Message_base> m_rep;
+        WebSocketStream::_deflate_param m_param;
+        bool m_deflate;
     };
 
     if (!ac)
@@ -258,6 +294,18 @@ result_t WebSocketHandler::set_maxSize(int32_t newVal)
     return 0;
 }
 
+result_t WebSocketHandler::get_compress(bool &retVal)
+{
+    retVal = m_compress;
+    return 0;
+}
+
+result_t WebSocketHandler::set_compress(bool newVal)
+{
+    m_compress = newVal;
+    return 0;
+}
+
 result_t WebSocketHandler::get_handler(obj_ptr<Handler_base> &retVal)
 {
     retVal = m_hdlr;
@@ -0,0 +1,247 @@
+/*
+ * WebSocketHub.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "WebSocketHub.h"
+#include "WebSocketMessage.h"
+#include "ifs/websocket.h"
+#include "Buffer.h"
+
+namespace fibjs
+{
+
+static const char *s_staticCounter[] =
+{ "members" };
+static const char *s_Counter[] =
+{ "send", "deliver", "evict" };
+
+enum
+{
+    HUB_MEMBERS = 0,
+    HUB_SEND,
+    HUB_DELIVER,
+    HUB_EVICT
+};
+
+result_t WebSocketHub_base::_new(int32_t maxPending,
+                                 obj_ptr<WebSocketHub_base> &retVal,
+                                 v8::Local<v8::Object> This)
+{
+    if (maxPending < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    retVal = new WebSocketHub(maxPending);
+    return 0;
+}
+
+WebSocketHub::WebSocketHub(int32_t maxPending) :
+    m_maxPending(maxPending), m_compress(false)
+{
+    m_stats = new Stats();
+    m_stats->init(s_staticCounter, 1, s_Counter, 3);
+    m_stats->set_name("websocket_hub");
+}
+
+result_t WebSocketHub::add(Stream_base *stm)
+{
+    WebSocketStream *ws = dynamic_cast<WebSocketStream *>(stm);
+    if (!ws)
+        return CHECK_ERROR(Runtime::setError("WebSocketHub: not a websocket stream."));
+
+    // frames are shared by all members and sent unmasked, which only a
+    // server may do
+    if (!ws->server())
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    if (m_members.find(ws) == m_members.end())
+    {
+        m_members.insert(std::pair<WebSocketStream *, obj_ptr<WebSocketStream> >(ws, ws));
+        m_stats->inc(HUB_MEMBERS);
+    }
+
+    return 0;
+}
+
+result_t WebSocketHub::remove(Stream_base *stm)
+{
+    WebSocketStream *ws = dynamic_cast<WebSocketStream *>(stm);
+    std::map<WebSocketStream *, obj_ptr<WebSocketStream> >::iterator it;
+
+    if (!ws)
+        return 0;
+
+    it = m_members.find(ws);
+    if (it != m_members.end())
+    {
+        m_members.erase(it);
+        m_stats->dec(HUB_MEMBERS);
+    }
+
+    return 0;
+}
+
+result_t WebSocketHub::send(const char *data, int32_t &retVal)
+{
+    std::string payload(data);
+    return broadcast(websocket_base::_TEXT, payload, retVal);
+}
+
+result_t WebSocketHub::send(Buffer_base *data, int32_t &retVal)
+{
+    std::string payload;
+
+    data->toString(payload);
+    return broadcast(websocket_base::_BINARY, payload, retVal);
+}
+
+result_t WebSocketHub::broadcast(int32_t type, std::string &payload, int32_t &retVal)
+{
+    std::map<WebSocketStream *, obj_ptr<WebSocketStream> >::iterator it;
+    obj_ptr<Buffer_base> plain;
+    obj_ptr<Buffer_base> packed;
+    std::string strFrame;
+    result_t hr;
+
+    m_stats->inc(HUB_SEND);
+    retVal = 0;
+
+    it = m_members.begin();
+    while (it != m_members.end())
+    {
+        WebSocketStream *ws = it->first;
+        Buffer_base *frame;
+
+        if (ws->pending() > m_maxPending)
+        {
+            evict(ws);
+            m_members.erase(it ++);
+            continue;
+        }
+
+        if (m_compress && ws->shared_deflate() && !payload.empty())
+        {
+            if (!packed)
+            {
+                std::string strData(payload);
+
+                hr = WebSocketStream::deflate_frame(strData);
+                if (hr < 0)
+                    return hr;
+
+                WebSocketMessage::frame(strFrame, type, true, false, strData);
+                packed = new Buffer(strFrame);
+            }
+
+            frame = packed;
+        }
+        else
+        {
+            if (!plain)
+            {
+                WebSocketMessage::frame(strFrame, type, false, false, payload);
+                plain = new Buffer(strFrame);
+            }
+
+            frame = plain;
+        }
+
+        if (ws->send(frame) < 0)
+        {
+            evict(ws);
+            m_members.erase(it ++);
+            continue;
+        }
+
+        retVal ++;
+        it ++;
+    }
+
+    m_stats->add(HUB_DELIVER, retVal);
+
+    return 0;
+}
+
+void WebSocketHub::evict(WebSocketStream *ws)
+{
+    class asyncClose: public AsyncState
+    {
+    public:
+        asyncClose(WebSocketStream *ws) :
+            AsyncState(NULL), m_ws(ws)
+        {
+            set(close);
+        }
+
+        static int32_t close(AsyncState *pState, int32_t n)
+        {
+            asyncClose *pThis = (asyncClose *) pState;
+
+            pThis->set(NULL);
+            return pThis->m_ws->close(pThis);
+        }
+
+    private:
+        obj_ptr<WebSocketStream> m_ws;
+    };
+
+    m_stats->dec(HUB_MEMBERS);
+    m_stats->inc(HUB_EVICT);
+
+    (new asyncClose(ws))->apost(0);
+}
+
+result_t WebSocketHub::close()
+{
+    std::map<WebSocketStream *, obj_ptr<WebSocketStream> >::iterator it;
+
+    for (it = m_members.begin(); it != m_members.end(); it ++)
+        evict(it->first);
+
+    m_members.clear();
+
+    return 0;
+}
+
+result_t WebSocketHub::get_compress(bool &retVal)
+{
+    retVal = m_compress;
+    return 0;
+}
+
+result_t WebSocketHub::set_compress(bool newVal)
+{
+    m_compress = newVal;
+    return 0;
+}
+
+result_t WebSocketHub::get_maxPending(int32_t &retVal)
+{
+    retVal = m_maxPending;
+    return 0;
+}
+
+result_t WebSocketHub::set_maxPending(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_maxPending = newVal;
+    return 0;
+}
+
+result_t WebSocketHub::get_size(int32_t &retVal)
+{
+    retVal = (int32_t)m_members.size();
+    return 0;
+}
+
+result_t WebSocketHub::get_stats(obj_ptr<Stats_base> &retVal)
+{
+    retVal = m_stats;
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -9,6 +9,7 @@
 #include "Buffer.h"
 #include "Stream.h"
 #include "MemoryStream.h"
+#include "WebSocketStream.h"
 
 namespace fibjs
 {
@@ -135,14 +136,10 @@ result_t WebSocketMessage::copy(Stream_base *from, Stream_base *to, int64_t byte
             if (pThis->m_mask != 0)
             {
                 std::string strBuffer;
-                int32_t i, n;
-                uint8_t* mask = (uint8_t*)&pThis->m_mask;
 
                 pThis->m_buf->toString(strBuffer);
-
-                n = (int32_t)strBuffer.length();
-                for (i = 0; i < n; i ++)
-                    strBuffer[i] ^= mask[(pThis->m_copyed + i) & 3];
+                WebSocketMessage::mask(&strBuffer[0], strBuffer.length(), pThis->m_mask,
+                                       pThis->m_copyed);
 
                 pThis->m_buf = new Buffer(strBuffer);
             }
@@ -171,107 +168,151 @@ result_t WebSocketMessage::copy(Stream_base *from, Stream_base *to, int64_t byte
     return (new asyncCopy(from, to, bytes, mask, ac))->post(0);
 }
 
-result_t WebSocketMessage::sendTo(Stream_base *stm, AsyncEvent *ac)
+void WebSocketMessage::mask(char *buf, size_t sz, uint32_t mask, int64_t pos)
 {
-    class asyncSendTo: public AsyncState
+    uint8_t *key = (uint8_t *)&mask;
+    size_t i = 0;
+
+    while (i < sz && ((intptr_t)(buf + i) & 7))
     {
-    public:
-        asyncSendTo(WebSocketMessage *pThis, Stream_base *stm,
-                    AsyncEvent *ac) :
-            AsyncState(ac), m_pThis(pThis), m_stm(stm), m_mask(0)
-        {
-            m_pThis->get_body(m_body);
-            m_body->rewind();
-            m_body->size(m_size);
+        buf[i] ^= key[(pos + i) & 3];
+        i ++;
+    }
 
-            m_ms = new MemoryStream();
+    if (sz - i >= 8)
+    {
+        uint8_t key8[8];
+        uint64_t key64;
+        uint64_t *p = (uint64_t *)(buf + i);
+        size_t n = (sz - i) >> 3;
+        size_t j;
 
-            set(head);
-        }
+        for (j = 0; j < 8; j ++)
+            key8[j] = key[(pos + i + j) & 3];
+        memcpy(&key64, key8, 8);
 
-        static int32_t head(AsyncState *pState, int32_t n)
-        {
-            asyncSendTo *pThis = (asyncSendTo *) pState;
+        for (j = 0; j < n; j ++)
+            p[j] ^= key64;
 
-            uint8_t buf[16];
-            int32_t pos = 0;
+        i += n << 3;
+    }
 
-            buf[0] = 0x80 | (pThis->m_pThis->m_type & 0x0f);
+    while (i < sz)
+    {
+        buf[i] ^= key[(pos + i) & 3];
+        i ++;
+    }
+}
 
-            int64_t size = pThis->m_size;
-            if (size < 126)
-            {
-                buf[1] = (uint8_t)size;
-                pos = 2;
-            }
-            else if (size < 65536)
-            {
-                buf[1] = 126;
-                buf[2] = (uint8_t)(size >> 8);
-                buf[3] = (uint8_t)(size & 0xff);
-                pos = 4;
-            } else
-            {
-                buf[1] = 127;
-                buf[2] = (uint8_t)((size >> 56) & 0xff);
-                buf[3] = (uint8_t)((size >> 48) & 0xff);
-                buf[4] = (uint8_t)((size >> 40) & 0xff);
-                buf[5] = (uint8_t)((size >> 32) & 0xff);
-                buf[6] = (uint8_t)((size >> 24) & 0xff);
-                buf[7] = (uint8_t)((size >> 16) & 0xff);
-                buf[8] = (uint8_t)((size >> 8) & 0xff);
-                buf[9] = (uint8_t)(size & 0xff);
-                pos = 10;
-            }
+void WebSocketMessage::frame(std::string &retVal, int32_t type, bool compressed,
+                             bool masked, const std::string &payload)
+{
+    uint8_t buf[16];
+    int32_t pos = 0;
+    uint32_t r = 0;
 
-            if (pThis->m_pThis->m_masked)
-            {
-                buf[1] |= 0x80;
+    buf[0] = 0x80 | (type & 0x0f);
+    if (compressed)
+        buf[0] |= 0x40;
 
-                uint32_t r = 0;
-                while (r == 0)
-                    r = rand();
+    int64_t size = payload.length();
+    if (size < 126)
+    {
+        buf[1] = (uint8_t)size;
+        pos = 2;
+    }
+    else if (size < 65536)
+    {
+        buf[1] = 126;
+        buf[2] = (uint8_t)(size >> 8);
+        buf[3] = (uint8_t)(size & 0xff);
+        pos = 4;
+    } else
+    {
+        buf[1] = 127;
+        buf[2] = (uint8_t)((size >> 56) & 0xff);
+        buf[3] = (uint8_t)((size >> 48) & 0xff);
+        buf[4] = (uint8_t)((size >> 40) & 0xff);
+        buf[5] = (uint8_t)((size >> 32) & 0xff);
+        buf[6] = (uint8_t)((size >> 24) & 0xff);
+        buf[7] = (uint8_t)((size >> 16) & 0xff);
+        buf[8] = (uint8_t)((size >> 8) & 0xff);
+        buf[9] = (uint8_t)(size & 0xff);
+        pos = 10;
+    }
 
-                pThis->m_mask = r;
+    if (masked)
+    {
+        buf[1] |= 0x80;
 
-                buf[pos ++] = (uint8_t)(r & 0xff);
-                buf[pos ++] = (uint8_t)((r >> 8) & 0xff);
-                buf[pos ++] = (uint8_t)((r >> 16) & 0xff);
-                buf[pos ++] = (uint8_t)((r >> 24) & 0xff);
-            }
+        while (r == 0)
+            r = rand();
 
-            std::string strBuffer((const char*)buf, pos);
-            pThis->m_buffer = new Buffer(strBuffer);
+        buf[pos ++] = (uint8_t)(r & 0xff);
+        buf[pos ++] = (uint8_t)((r >> 8) & 0xff);
+        buf[pos ++] = (uint8_t)((r >> 16) & 0xff);
+        buf[pos ++] = (uint8_t)((r >> 24) & 0xff);
+    }
+
+    retVal.reserve(pos + payload.length());
+    retVal.assign((const char*)buf, pos);
+    retVal.append(payload);
+
+    if (masked)
+        mask(&retVal[pos], payload.length(), r, 0);
+}
+
+result_t WebSocketMessage::sendTo(Stream_base *stm, AsyncEvent *ac)
+{
+    class asyncSendTo: public AsyncState
+    {
+    public:
+        asyncSendTo(WebSocketMessage *pThis, Stream_base *stm,
+                    AsyncEvent *ac) :
+            AsyncState(ac), m_pThis(pThis), m_stm(stm)
+        {
+            m_ws = dynamic_cast<WebSocketStream *>(stm);
+
+            m_pThis->get_body(m_body);
+            m_body->rewind();
 
-            pThis->set(sendData);
-            return pThis->m_ms->write(pThis->m_buffer, pThis);
+            set(read);
         }
 
-        static int32_t sendData(AsyncState *pState, int32_t n)
+        static int32_t read(AsyncState *pState, int32_t n)
         {
             asyncSendTo *pThis = (asyncSendTo *) pState;
 
-            pThis->set(sendToStream);
-            return copy(pThis->m_body, pThis->m_ms, pThis->m_size, pThis->m_mask, pThis);
+            pThis->set(send);
+            return pThis->m_body->readAll(pThis->m_buffer, pThis);
         }
 
-        static int32_t sendToStream(AsyncState *pState, int32_t n)
+        static int32_t send(AsyncState *pState, int32_t n)
         {
             asyncSendTo *pThis = (asyncSendTo *) pState;
+            std::string strBuffer;
 
-            pThis->m_ms->rewind();
+            if (n != CALL_RETURN_NULL)
+                pThis->m_buffer->toString(strBuffer);
 
             pThis->set(NULL);
-            return copyStream(pThis->m_ms, pThis->m_stm, -1, pThis->m_size, pThis);
+
+            if (pThis->m_ws)
+                return pThis->m_ws->send(pThis->m_pThis->m_type, pThis->m_pThis->m_masked,
+                                         strBuffer, pThis);
+
+            std::string strFrame;
+            frame(strFrame, pThis->m_pThis->m_type, false, pThis->m_pThis->m_masked, strBuffer);
+
+            pThis->m_buffer = new Buffer(strFrame);
+            return pThis->m_stm->write(pThis->m_buffer, pThis);
         }
 
     public:
-        obj_ptr<MemoryStream_base> m_ms;
         WebSocketMessage *m_pThis;
         obj_ptr<Stream_base> m_stm;
+        obj_ptr<WebSocketStream> m_ws;
         obj_ptr<SeekableStream_base> m_body;
-        int64_t m_size;
-        uint32_t m_mask;
         obj_ptr<Buffer_base> m_buffer;
     };
 
@@ -290,8 +331,10 @@ result_t WebSocketMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
         asyncReadFrom(WebSocketMessage *pThis, Stream_base *stm,
                       AsyncEvent *ac) :
             AsyncState(ac), m_pThis(pThis), m_stm(stm),
-            m_fin(false), m_masked(false), m_fragmented(false), m_size(0), m_fullsize(0), m_mask(0)
+            m_fin(false), m_masked(false), m_fragmented(false), m_compressed(false),
+            m_size(0), m_fullsize(0), m_mask(0)
         {
+            m_ws = dynamic_cast<WebSocketStream *>(stm);
             m_pThis->get_body(m_body);
             set(head);
         }
@@ -319,9 +362,19 @@ result_t WebSocketMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
             pThis->m_buffer.Release();
 
             ch = strBuffer[0];
-            if (ch & 0x70)
+            if (ch & 0x30)
                 return CHECK_ERROR(Runtime::setError("WebSocketMessage: non-zero RSV values."));
 
+            if (ch & 0x40)
+            {
+                // RSV1 marks a compressed message, control frames are never
+                // compressed (RFC 7692)
+                if (pThis->m_fragmented || (ch & 0x08) || !pThis->m_ws
+                        || !pThis->m_ws->deflated())
+                    return CHECK_ERROR(Runtime::setError("WebSocketMessage: non-zero RSV values."));
+                pThis->m_compressed = true;
+            }
+
             pThis->m_fin = (ch & 0x80) != 0;
 
             if (pThis->m_fragmented)
@@ -422,6 +475,43 @@ result_t WebSocketMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
                 return 0;
             }
 
+            pThis->m_body->rewind();
+            if (!pThis->m_compressed)
+                return pThis->done();
+
+            pThis->set(unzip);
+            return pThis->m_body->readAll(pThis->m_buffer, pThis);
+        }
+
+        static int32_t unzip(AsyncState *pState, int32_t n)
+        {
+            asyncReadFrom *pThis = (asyncReadFrom *) pState;
+            std::string strBuffer;
+            result_t hr;
+
+            if (n != CALL_RETURN_NULL)
+            {
+                pThis->m_buffer->toString(strBuffer);
+                pThis->m_buffer.Release();
+            }
+
+            hr = pThis->m_ws->decompress(strBuffer, pThis->m_pThis->m_maxSize);
+            if (hr < 0)
+                return hr;
+
+            pThis->m_body = new MemoryStream();
+            pThis->m_pThis->set_body(pThis->m_body);
+
+            pThis->m_buffer = new Buffer(strBuffer);
+
+            pThis->set(unzip_end);
+            return pThis->m_body->write(pThis->m_buffer, pThis);
+        }
+
+        static int32_t unzip_end(AsyncState *pState, int32_t n)
+        {
+            asyncReadFrom *pThis = (asyncReadFrom *) pState;
+
             pThis->m_body->rewind();
             return pThis->done();
         }
@@ -429,11 +519,13 @@ result_t WebSocketMessage::readFrom(Stream_base *stm, AsyncEvent *ac)
     public:
         WebSocketMessage *m_pThis;
         obj_ptr<Stream_base> m_stm;
+        obj_ptr<WebSocketStream> m_ws;
         obj_ptr<SeekableStream_base> m_body;
         obj_ptr<Buffer_base> m_buffer;
         bool m_fin;
         bool m_masked;
         bool m_fragmented;
+        bool m_compressed;
         int64_t m_size;
         int64_t m_fullsize;
         uint32_t m_mask;
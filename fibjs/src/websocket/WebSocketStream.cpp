@@ -0,0 +1,483 @@
+/*
+ * WebSocketStream.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: lion
+ */
+
+#include "WebSocketStream.h"
+#include "WebSocketMessage.h"
+#include "ifs/websocket.h"
+#include "Buffer.h"
+#include "parse.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CHUNK 32768
+
+namespace fibjs
+{
+
+class WebSocketStream::asyncFlush: public AsyncState
+{
+public:
+    asyncFlush(WebSocketStream *pThis) :
+        AsyncState(NULL), m_pThis(pThis), m_size(0)
+    {
+        set(write);
+    }
+
+    static int32_t write(AsyncState *pState, int32_t n)
+    {
+        asyncFlush *pThis = (asyncFlush *) pState;
+        WebSocketStream *ws = pThis->m_pThis;
+        std::list<obj_ptr<Buffer_base> > queue;
+        int32_t sz;
+
+        ws->m_lock.lock();
+        if (ws->m_queue.empty())
+        {
+            ws->m_writing = false;
+            ws->m_lock.unlock();
+            return pThis->done();
+        }
+
+        queue.swap(ws->m_queue);
+        pThis->m_acs.swap(ws->m_acs);
+        ws->m_lock.unlock();
+
+        if (queue.size() == 1)
+            pThis->m_buf = queue.front();
+        else
+        {
+            std::string strBuf;
+            std::string strFrame;
+
+            while (!queue.empty())
+            {
+                queue.front()->toString(strFrame);
+                strBuf.append(strFrame);
+                queue.pop_front();
+            }
+
+            pThis->m_buf = new Buffer(strBuf);
+        }
+
+        pThis->m_buf->get_length(sz);
+        pThis->m_size = sz;
+
+        pThis->set(written);
+        return ws->m_stm->write(pThis->m_buf, pThis);
+    }
+
+    static int32_t written(AsyncState *pState, int32_t n)
+    {
+        asyncFlush *pThis = (asyncFlush *) pState;
+        WebSocketStream *ws = pThis->m_pThis;
+
+        ws->m_lock.lock();
+        ws->m_pending -= pThis->m_size;
+        ws->m_lock.unlock();
+
+        pThis->m_buf.Release();
+        postAll(pThis->m_acs, 0);
+
+        pThis->set(write);
+        return 0;
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        std::list<AsyncEvent *> acs;
+
+        postAll(m_acs, v);
+
+        m_pThis->m_lock.lock();
+        acs.swap(m_pThis->m_acs);
+        m_pThis->m_queue.clear();
+        m_pThis->m_pending = 0;
+        m_pThis->m_writing = false;
+        m_pThis->m_error = v;
+        m_pThis->m_lock.unlock();
+
+        postAll(acs, v);
+
+        return v;
+    }
+
+private:
+    static void postAll(std::list<AsyncEvent *> &acs, int32_t v)
+    {
+        while (!acs.empty())
+        {
+            AsyncEvent *ac = acs.front();
+            acs.pop_front();
+            if (ac)
+                ac->post(v);
+        }
+    }
+
+private:
+    obj_ptr<WebSocketStream> m_pThis;
+    std::list<AsyncEvent *> m_acs;
+    obj_ptr<Buffer_base> m_buf;
+    int64_t m_size;
+};
+
+WebSocketStream::WebSocketStream(Stream_base *stm, bool bServer) :
+    m_stm(stm), m_pending(0), m_writing(false), m_error(0),
+    m_server(bServer), m_deflate(false), m_reset(false), m_shared(false)
+{
+}
+
+WebSocketStream::~WebSocketStream()
+{
+    if (m_deflate)
+    {
+        deflateEnd(&m_zdef);
+        inflateEnd(&m_zinf);
+    }
+}
+
+result_t WebSocketStream::read(int32_t bytes, obj_ptr<Buffer_base> &retVal,
+                               AsyncEvent *ac)
+{
+    return m_stm->read(bytes, retVal, ac);
+}
+
+result_t WebSocketStream::write(Buffer_base *data, AsyncEvent *ac)
+{
+    if (!ac)
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    m_lock.lock();
+    return push(data, ac);
+}
+
+result_t WebSocketStream::close(AsyncEvent *ac)
+{
+    return m_stm->close(ac);
+}
+
+result_t WebSocketStream::copyTo(Stream_base *stm, int64_t bytes,
+                                 int64_t &retVal, AsyncEvent *ac)
+{
+    return m_stm->copyTo(stm, bytes, retVal, ac);
+}
+
+result_t WebSocketStream::push(Buffer_base *frame, AsyncEvent *ac)
+{
+    int32_t sz;
+
+    if (m_error < 0)
+    {
+        result_t hr = m_error;
+        m_lock.unlock();
+        return hr;
+    }
+
+    frame->get_length(sz);
+    m_pending += sz;
+
+    m_queue.push_back(frame);
+    if (ac)
+        m_acs.push_back(ac);
+
+    if (m_writing)
+    {
+        m_lock.unlock();
+        return CALL_E_PENDDING;
+    }
+
+    m_writing = true;
+    m_lock.unlock();
+
+    (new asyncFlush(this))->apost(0);
+    return CALL_E_PENDDING;
+}
+
+result_t WebSocketStream::send(int32_t type, bool masked, std::string &payload,
+                               AsyncEvent *ac)
+{
+    bool bCompress = m_deflate && !payload.empty() &&
+                     (type == websocket_base::_TEXT || type == websocket_base::_BINARY);
+    std::string strFrame;
+    result_t hr;
+
+    m_sendLock.lock();
+
+    if (bCompress)
+    {
+        hr = compress(m_zdef, payload);
+        if (hr < 0)
+        {
+            m_sendLock.unlock();
+            return hr;
+        }
+
+        if (m_reset)
+            deflateReset(&m_zdef);
+    }
+
+    WebSocketMessage::frame(strFrame, type, bCompress, masked, payload);
+
+    obj_ptr<Buffer_base> buf = new Buffer(strFrame);
+
+    m_lock.lock();
+    hr = push(buf, ac);
+    m_sendLock.unlock();
+
+    return hr;
+}
+
+result_t WebSocketStream::send(Buffer_base *frame)
+{
+    m_lock.lock();
+    result_t hr = push(frame, NULL);
+    return hr == CALL_E_PENDDING ? 0 : hr;
+}
+
+int64_t WebSocketStream::pending()
+{
+    int64_t sz;
+
+    m_lock.lock();
+    sz = m_pending;
+    m_lock.unlock();
+
+    return sz;
+}
+
+bool WebSocketStream::_deflate_param::parse(const char *ext)
+{
+    _parser p(ext);
+
+    while (!p.end())
+    {
+        std::string name;
+        bool bOk = true;
+
+        server_no_context_takeover = false;
+        client_no_context_takeover = false;
+        server_max_window_bits = 0;
+        client_max_window_bits = 0;
+
+        p.skipSpace();
+        p.getWord(name, ';', ',');
+        p.skipSpace();
+
+        if (qstricmp(name.c_str(), "permessage-deflate"))
+            bOk = false;
+
+        while (p.get() == ';')
+        {
+            std::string key, value;
+
+            p.skip();
+            p.skipSpace();
+            p.getWord(key, '=', ';', ',');
+            p.skipSpace();
+
+            if (p.get() == '=')
+            {
+                p.skip();
+                p.skipSpace();
+
+                if (p.get() == '\"')
+                {
+                    p.skip();
+                    p.getString(value, '\"');
+                    p.skip();
+                }
+                else
+                    p.getWord(value, ';', ',');
+
+                p.skipSpace();
+            }
+
+            if (!qstricmp(key.c_str(), "server_no_context_takeover"))
+                server_no_context_takeover = true;
+            else if (!qstricmp(key.c_str(), "client_no_context_takeover"))
+                client_no_context_takeover = true;
+            else if (!qstricmp(key.c_str(), "server_max_window_bits"))
+            {
+                server_max_window_bits = atoi(value.c_str());
+                if (server_max_window_bits < 9 || server_max_window_bits > 15)
+                    bOk = false;
+            }
+            else if (!qstricmp(key.c_str(), "client_max_window_bits"))
+            {
+                if (!value.empty())
+                {
+                    client_max_window_bits = atoi(value.c_str());
+                    if (client_max_window_bits < 9 || client_max_window_bits > 15)
+                        bOk = false;
+                }
+            }
+            else
+                bOk = false;
+        }
+
+        if (bOk)
+            return true;
+
+        p.skipUntil(',');
+        p.skip();
+    }
+
+    return false;
+}
+
+std::string WebSocketStream::_deflate_param::str()
+{
+    std::string strExt("permessage-deflate");
+
+    if (server_no_context_takeover)
+        strExt.append("; server_no_context_takeover");
+
+    if (client_no_context_takeover)
+        strExt.append("; client_no_context_takeover");
+
+    if (server_max_window_bits)
+    {
+        char buf[32];
+
+        sprintf(buf, "; server_max_window_bits=%d", server_max_window_bits);
+        strExt.append(buf);
+    }
+
+    return strExt;
+}
+
+result_t WebSocketStream::setDeflate(bool bServer, _deflate_param &param)
+{
+    int32_t bits;
+    int32_t err;
+
+    if (m_deflate)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (bServer)
+    {
+        m_reset = param.server_no_context_takeover;
+        bits = param.server_max_window_bits;
+    }
+    else
+    {
+        m_reset = param.client_no_context_takeover;
+        bits = param.client_max_window_bits;
+    }
+
+    if (bits == 0)
+        bits = 15;
+
+    memset(&m_zdef, 0, sizeof(m_zdef));
+    err = deflateInit2(&m_zdef, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -bits, 8,
+                       Z_DEFAULT_STRATEGY);
+    if (err != Z_OK)
+        return CHECK_ERROR(Runtime::setError(zError(err)));
+
+    memset(&m_zinf, 0, sizeof(m_zinf));
+    err = inflateInit2(&m_zinf, -15);
+    if (err != Z_OK)
+    {
+        deflateEnd(&m_zdef);
+        return CHECK_ERROR(Runtime::setError(zError(err)));
+    }
+
+    m_shared = m_reset && bits == 15;
+    m_deflate = true;
+    return 0;
+}
+
+result_t WebSocketStream::deflate_frame(std::string &data)
+{
+    z_stream zs;
+    int32_t err;
+
+    memset(&zs, 0, sizeof(zs));
+    err = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8,
+                       Z_DEFAULT_STRATEGY);
+    if (err != Z_OK)
+        return CHECK_ERROR(Runtime::setError(zError(err)));
+
+    result_t hr = compress(zs, data);
+    deflateEnd(&zs);
+
+    return hr;
+}
+
+result_t WebSocketStream::compress(z_stream &zs, std::string &data)
+{
+    unsigned char out[CHUNK];
+    std::string strBuf;
+    int32_t err;
+
+    zs.next_in = (unsigned char *) data.c_str();
+    zs.avail_in = (uInt) data.length();
+
+    do
+    {
+        zs.next_out = out;
+        zs.avail_out = CHUNK;
+
+        err = ::deflate(&zs, Z_SYNC_FLUSH);
+        if (err != Z_OK && err != Z_BUF_ERROR)
+            return CHECK_ERROR(Runtime::setError(zError(err)));
+
+        strBuf.append((const char *) out, CHUNK - zs.avail_out);
+    }
+    while (zs.avail_out == 0);
+
+    if (strBuf.length() >= 4 && !memcmp(strBuf.c_str() + strBuf.length() - 4,
+                                        "\x00\x00\xff\xff", 4))
+        strBuf.resize(strBuf.length() - 4);
+
+    data.swap(strBuf);
+    return 0;
+}
+
+result_t WebSocketStream::decompress(std::string &data, int32_t maxSize)
+{
+    unsigned char out[CHUNK];
+    std::string strBuf;
+    int32_t err;
+
+    if (!m_deflate)
+        return CHECK_ERROR(Runtime::setError("WebSocketMessage: non-zero RSV values."));
+
+    data.append("\x00\x00\xff\xff", 4);
+
+    m_zinf.next_in = (unsigned char *) data.c_str();
+    m_zinf.avail_in = (uInt) data.length();
+
+    do
+    {
+        m_zinf.next_out = out;
+        m_zinf.avail_out = CHUNK;
+
+        err = ::inflate(&m_zinf, Z_SYNC_FLUSH);
+        if (err == Z_BUF_ERROR)
+            break;
+
+        if (err != Z_OK && err != Z_STREAM_END)
+            return CHECK_ERROR(Runtime::setError(zError(err)));
+
+        strBuf.append((const char *) out, CHUNK - m_zinf.avail_out);
+        if ((int64_t)strBuf.length() > maxSize)
+            return CHECK_ERROR(Runtime::setError("WebSocketMessage: Message Too Big."));
+
+        if (err == Z_STREAM_END)
+        {
+            inflateReset(&m_zinf);
+            break;
+        }
+    }
+    while (m_zinf.avail_in > 0 || m_zinf.avail_out == 0);
+
+    data.swap(strBuf);
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -8,6 +8,7 @@
 #include "ifs/websocket.h"
 #include "ifs/http.h"
 #include "Map.h"
+#include "WebSocketStream.h"
 #include <mbedtls/mbedtls/sha1.h>
 #include "encoding.h"
 #include <stdlib.h>
@@ -15,14 +16,15 @@
 namespace fibjs
 {
 
-result_t websocket_base::connect(const char* url, obj_ptr<Stream_base>& retVal,
-                                 AsyncEvent* ac)
+result_t websocket_base::connect(const char* url, bool compress,
+                                 obj_ptr<Stream_base>& retVal, AsyncEvent* ac)
 {
 	class asyncConnect: public AsyncState
 	{
 	public:
-		asyncConnect(const char* url, obj_ptr<Stream_base>& retVal, AsyncEvent *ac) :
-			AsyncState(ac), m_url(url), m_retVal(retVal)
+		asyncConnect(const char* url, bool compress, obj_ptr<Stream_base>& retVal,
+		             AsyncEvent *ac) :
+			AsyncState(ac), m_url(url), m_compress(compress), m_retVal(retVal)
 		{
 			set(handshake);
 		}
@@ -44,6 +46,10 @@ result_t websocket_base::connect(const char* url, obj_ptr<Stream_base>& retVal,
 			pThis->m_headers->put("Connection", "Upgrade");
 			pThis->m_headers->put("Sec-WebSocket-Version", "13");
 
+			if (pThis->m_compress)
+				pThis->m_headers->put("Sec-WebSocket-Extensions",
+				                      "permessage-deflate; client_max_window_bits");
+
 			char keys[16];
 			int32_t i;
 
@@ -108,13 +114,39 @@ result_t websocket_base::connect(const char* url, obj_ptr<Stream_base>& retVal,
 			if (qstrcmp(v.string().c_str(), pThis->m_accept.c_str()))
 				return CHECK_ERROR(Runtime::setError("websocket: invalid Sec-WebSocket-Accept header."));
 
-			pThis->m_httprep->get_stream(pThis->m_retVal);
+			WebSocketStream::_deflate_param param;
+			bool bDeflate = false;
+
+			hr = pThis->m_httprep->firstHeader("Sec-WebSocket-Extensions", v);
+			if (hr < 0)
+				return hr;
+
+			if (hr != CALL_RETURN_NULL)
+			{
+				if (!pThis->m_compress || !param.parse(v.string().c_str()))
+					return CHECK_ERROR(Runtime::setError("websocket: invalid Sec-WebSocket-Extensions header."));
+				bDeflate = true;
+			}
+
+			obj_ptr<Stream_base> stm;
+			pThis->m_httprep->get_stream(stm);
+
+			obj_ptr<WebSocketStream> ws = new WebSocketStream(stm, false);
+			if (bDeflate)
+			{
+				hr = ws->setDeflate(false, param);
+				if (hr < 0)
+					return hr;
+			}
+
+			pThis->m_retVal = ws;
 
 			return pThis->done(0);
 		}
 
 	private:
 		std::string m_url;
+		bool m_compress;
 		obj_ptr<Stream_base>& m_retVal;
 		obj_ptr<HttpResponse_base> m_httprep;
 		obj_ptr<Map> m_headers;
@@ -124,7 +156,7 @@ result_t websocket_base::connect(const char* url, obj_ptr<Stream_base>& retVal,
 	if (!ac)
 		return CHECK_ERROR(CALL_E_NOSYNC);
 
-	return (new asyncConnect(url, retVal, ac))->post(0);
+	return (new asyncConnect(url, compress, retVal, ac))->post(0);
 }
 
 }
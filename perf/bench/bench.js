@@ -0,0 +1,170 @@
+#!/usr/local/bin/fibjs
+
+/*
+ usage:
+   fibjs bench.js                    run all benchmarks
+   fibjs bench.js save base.json     run and save the results as baseline
+   fibjs bench.js check base.json    run and fail on regressions beyond 10%
+ */
+
+var test = require("test");
+var process = require("process");
+var encoding = require("encoding");
+var http = require("http");
+var io = require("io");
+var fs = require("fs");
+var crypto = require("crypto");
+
+var argv = process.argv;
+var cmd = argv[2];
+var fname = argv[3];
+var baseline;
+
+if (cmd == "check")
+	baseline = encoding.jsonDecode(fs.readFile(fname));
+
+var results = {};
+
+function bench(name, fn) {
+	var r = test.bench(name, fn, baseline ? {
+		baseline: baseline
+	} : {});
+	results[name] = r;
+}
+
+var buf = new Buffer(1024);
+buf.fill(0x55);
+
+var str = buf.toString();
+var hex = buf.hex();
+var b64 = buf.base64();
+var obj = {
+	a: 100,
+	b: "hello, world",
+	c: [1, 2, 3, 4, 5],
+	d: {
+		e: true,
+		f: null
+	}
+};
+var json = encoding.jsonEncode(obj);
+
+bench("Buffer.new", function() {
+	new Buffer(64);
+});
+
+bench("Buffer.write", function() {
+	buf.write("hello, world", 0);
+});
+
+bench("Buffer.readInt32LE", function() {
+	buf.readInt32LE(16);
+});
+
+bench("Buffer.slice", function() {
+	buf.slice(16, 512);
+});
+
+bench("Buffer.toString", function() {
+	buf.toString();
+});
+
+var lines = [];
+for (var i = 0; i < 100; i++)
+	lines.push("line " + i + ": " + str.substr(0, 64));
+var text = lines.join("\r\n") + "\r\n";
+
+var ms_lines = new io.MemoryStream();
+ms_lines.write(new Buffer(text));
+
+bench("BufferedStream.readLine", function() {
+	ms_lines.rewind();
+	var bs = new io.BufferedStream(ms_lines);
+	bs.EOL = "\r\n";
+
+	while (bs.readLine() !== null);
+});
+
+var req_text = "GET /path/to/resource?a=100&b=200 HTTP/1.1\r\n" +
+	"Host: www.example.com\r\n" +
+	"User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n" +
+	"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n" +
+	"Accept-Language: en-US,en;q=0.5\r\n" +
+	"Accept-Encoding: gzip, deflate\r\n" +
+	"Cookie: a=100; b=200\r\n" +
+	"Connection: keep-alive\r\n\r\n";
+
+var ms_req = new io.MemoryStream();
+ms_req.write(new Buffer(req_text));
+
+bench("HttpRequest.readFrom", function() {
+	ms_req.rewind();
+	var bs = new io.BufferedStream(ms_req);
+	bs.EOL = "\r\n";
+
+	var req = new http.Request();
+	req.readFrom(bs);
+});
+
+bench("encoding.hexEncode", function() {
+	encoding.hexEncode(buf);
+});
+
+bench("encoding.hexDecode", function() {
+	encoding.hexDecode(hex);
+});
+
+bench("encoding.base64Encode", function() {
+	encoding.base64Encode(buf);
+});
+
+bench("encoding.base64Decode", function() {
+	encoding.base64Decode(b64);
+});
+
+bench("encoding.jsonEncode", function() {
+	encoding.jsonEncode(obj);
+});
+
+bench("encoding.jsonDecode", function() {
+	encoding.jsonDecode(json);
+});
+
+var coroutine = require("coroutine");
+var ch = new coroutine.Channel(1024);
+var ch_buf = new Buffer(64);
+
+bench("Channel.put/take", function() {
+	ch.put(100);
+	ch.take();
+});
+
+bench("Channel.put/take Buffer", function() {
+	ch.put(ch_buf);
+	ch_buf = ch.take();
+});
+
+var aead = crypto.aead("aes-256-gcm", new Buffer(32));
+var aead_iv = new Buffer(12);
+var big = new Buffer(1024 * 1024);
+var big_enc = aead.encrypt(aead_iv, big);
+var enc = aead.encrypt(aead_iv, buf);
+
+bench("Aead.encrypt 1K", function() {
+	aead.encrypt(aead_iv, buf);
+});
+
+bench("Aead.decrypt 1K", function() {
+	aead.decrypt(aead_iv, enc);
+});
+
+bench("Aead.encrypt 1M", function() {
+	aead.encrypt(aead_iv, big);
+});
+
+bench("Aead.decrypt 1M", function() {
+	aead.decrypt(aead_iv, big_enc);
+});
+
+if (cmd == "save")
+	fs.writeFile(fname, encoding.jsonEncode(results));
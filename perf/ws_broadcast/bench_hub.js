@@ -0,0 +1,117 @@
+/* websocket broadcast benchmark
+ *
+ * fibjs bench_hub.js [subscribers] [messages] [size]
+ *
+ * starts a websocket server and the given number of local subscribers, then
+ * broadcasts the same message to every subscriber, first with one
+ * WebSocketMessage per subscriber and then with websocket.Hub.
+ * raise the open file limit first, e.g. ulimit -n 30000 for 10k subscribers.
+ */
+
+var websocket = require('websocket'),
+	http = require('http'),
+	coroutine = require('coroutine');
+
+var argv = require('process').argv;
+
+var subscribers = Number(argv[2]) || 10000;
+var messages = Number(argv[3]) || 100;
+var size = Number(argv[4]) || 256;
+
+var port = 8820;
+
+var payload = "";
+while (payload.length < size)
+	payload += "0123456789";
+payload = payload.substr(0, size);
+
+var members = [];
+var hub = new websocket.Hub(64 * 1024 * 1024);
+
+var svr = new http.Server(port, new websocket.Handler(function(v) {
+	members.push(v.stream);
+	hub.add(v.stream);
+}));
+svr.asyncRun();
+
+var received = 0;
+
+function subscriber() {
+	var s = websocket.connect("ws://127.0.0.1:" + port + "/");
+
+	var msg = new websocket.Message();
+	msg.type = websocket.TEXT;
+	msg.body.write("join");
+	msg.sendTo(s);
+
+	msg = new websocket.Message();
+	msg.readFrom(s);
+
+	return function() {
+		while (true) {
+			var msg = new websocket.Message();
+			try {
+				msg.readFrom(s);
+			} catch (e) {
+				break;
+			}
+			received++;
+		}
+	};
+}
+
+var t = new Date();
+var ids = [];
+for (var i = 0; i < subscribers; i++)
+	ids.push(i);
+
+var readers = coroutine.parallel(ids, function() {
+	return subscriber();
+}, 1000);
+readers.forEach(function(r) {
+	coroutine.start(r);
+});
+console.log("connected:", subscribers, "in", new Date() - t, "ms");
+
+function wait(n) {
+	while (received < n)
+		coroutine.sleep(10);
+}
+
+function per_member() {
+	for (var i = 0; i < messages; i++)
+		members.forEach(function(s) {
+			var msg = new websocket.Message();
+			msg.type = websocket.TEXT;
+			msg.masked = false;
+			msg.body.write(payload);
+			msg.sendTo(s);
+		});
+}
+
+function shared() {
+	for (var i = 0; i < messages; i++)
+		hub.send(payload);
+}
+
+function run(name, fn) {
+	var n = received + subscribers * messages;
+	var t = new Date();
+
+	fn();
+	var t1 = new Date();
+	wait(n);
+	var t2 = new Date();
+
+	console.log(name + ":", "send", t1 - t, "ms,", "deliver", t2 - t, "ms,",
+		Math.round(subscribers * messages * 1000 / (t2 - t)), "msg/s");
+}
+
+run("WebSocketMessage", per_member);
+run("websocket.Hub", shared);
+
+console.log(hub.stats.toJSON());
+
+hub.close();
+svr.socket.close();
+process.exit(0);
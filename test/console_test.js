@@ -2,6 +2,8 @@ var test = require("test");
 test.setup();
 
 var os = require('os');
+var fs = require('fs');
+var coroutine = require('coroutine');
 
 describe("console", function() {
 	it("add", function() {
@@ -182,6 +184,82 @@ describe("console", function() {
 		console.reset();
 	});
 
+	it("buffer and overflow", function() {
+		assert.throws(function() {
+			console.add({
+				type: "console",
+				buffer: 8
+			});
+		});
+
+		assert.throws(function() {
+			console.add({
+				type: "console",
+				buffer: 2000000
+			});
+		});
+
+		assert.throws(function() {
+			console.add({
+				type: "console",
+				overflow: "wait"
+			});
+		});
+
+		console.add({
+			type: "console",
+			buffer: 100,
+			overflow: "drop"
+		});
+
+		console.reset();
+	});
+
+	it("block on overflow", function() {
+		function logs() {
+			return fs.readdir('.').toArray().filter(function(s) {
+				return s.name.substr(0, 13) == 'test_log_ring';
+			});
+		}
+
+		function clean() {
+			logs().forEach(function(s) {
+				fs.unlink(s.name);
+			});
+		}
+
+		clean();
+
+		console.add({
+			type: "file",
+			path: "test_log_ring",
+			buffer: 16,
+			overflow: "block"
+		});
+
+		for (var i = 0; i < 1000; i++)
+			console.info("ring " + i);
+
+		console.reset();
+
+		var lines;
+		for (var n = 0; n < 100; n++) {
+			coroutine.sleep(10);
+			var fl = logs();
+			if (fl.length == 1) {
+				lines = fs.readFile(fl[0].name).split("\n");
+				if (lines.length > 1000)
+					break;
+			}
+		}
+
+		assert.equal(lines.length, 1001);
+		assert.ok(/ INFO   - ring 0$/.test(lines[0]));
+		assert.ok(/ INFO   - ring 999$/.test(lines[999]));
+
+		clean();
+	});
+
 	it("fix: eval scriptname crash", function() {
 		eval('console.log("Rock Lee")');
 	})
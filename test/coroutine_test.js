@@ -255,6 +255,74 @@ describe('coroutine', function() {
 		coroutine.sleep();
 	});
 
+	it('stats', function() {
+		var s = coroutine.stats;
+
+		assert.property(s, "fibers");
+		assert.property(s, "idle");
+		assert.property(s, "max");
+		assert.greaterThan(s.fibers, 0);
+		assert.ok(s.max >= s.fibers);
+
+		coroutine.parallel([1, 2, 3, 4, 5], function(v) {
+			coroutine.sleep(10);
+		});
+
+		s = coroutine.stats;
+		assert.ok(s.max >= 5);
+		assert.greaterThan(s.reused, 0);
+		assert.ok(s.tasks >= 5);
+
+		var h = s.histogram("task");
+		assert.ok(h.count >= 5);
+		assert.ok(h.max >= 9000);
+	});
+
+	it('handlerStackSize', function() {
+		var e = new coroutine.Trigger();
+		var depth = 0;
+		var err;
+
+		assert.equal(coroutine.handlerStackSize, 0);
+
+		assert.throws(function() {
+			coroutine.handlerStackSize = 32;
+		});
+
+		assert.throws(function() {
+			coroutine.handlerStackSize = 1024 * 1024;
+		});
+
+		function t(n) {
+			depth = n;
+			t(n + 1);
+		}
+
+		e.on('test', function() {
+			try {
+				t(0);
+			} catch (e) {
+				err = e;
+			}
+		});
+
+		e.trigger('test');
+		coroutine.sleep(10);
+		assert.ok(err);
+		var d1 = depth;
+
+		coroutine.handlerStackSize = 64;
+		assert.equal(coroutine.handlerStackSize, 64);
+
+		err = undefined;
+		e.trigger('test');
+		coroutine.sleep(10);
+		assert.ok(err);
+		assert.lessThan(depth, d1);
+
+		coroutine.handlerStackSize = 0;
+	});
+
 	describe('BlockQueue', function() {
 		it("add", function() {
 			var q = new coroutine.BlockQueue(3);
@@ -392,6 +460,102 @@ describe('coroutine', function() {
 			assert.deepEqual(q.toArray(), [200]);
 		});
 	});
+
+	describe('Channel', function() {
+		it("put/take", function() {
+			var ch = new coroutine.Channel(3);
+
+			ch.put(100);
+			ch.put("abc");
+			ch.put({
+				a: 1,
+				b: [1, 2, 3]
+			});
+			assert.equal(ch.length, 3);
+
+			assert.equal(ch.take(), 100);
+			assert.equal(ch.take(), "abc");
+			assert.deepEqual(ch.take(), {
+				a: 1,
+				b: [1, 2, 3]
+			});
+			assert.equal(ch.length, 0);
+		});
+
+		it("transfer Buffer", function() {
+			var ch = new coroutine.Channel(3);
+			var buf = new Buffer("hello");
+
+			ch.put(buf);
+			assert.equal(buf.length, 0);
+
+			var buf1 = ch.take();
+			assert.equal(buf1.toString(), "hello");
+		});
+
+		it("tryPut", function() {
+			var ch = new coroutine.Channel(2);
+
+			assert.equal(ch.tryPut(1), true);
+			assert.equal(ch.tryPut(2), true);
+			assert.equal(ch.tryPut(3), false);
+			assert.equal(ch.length, 2);
+		});
+
+		it("block", function() {
+			var ch = new coroutine.Channel(1);
+			var e;
+
+			coroutine.start(function() {
+				e = ch.take();
+			});
+			coroutine.sleep(10);
+
+			ch.put(100);
+			ch.put(200);
+
+			coroutine.start(function() {
+				ch.put(300);
+			});
+			coroutine.sleep(10);
+			assert.equal(e, 100);
+			assert.equal(ch.length, 1);
+
+			assert.equal(ch.take(), 200);
+			coroutine.sleep(10);
+			assert.equal(ch.take(), 300);
+		});
+
+		it("close", function() {
+			var ch = new coroutine.Channel(2);
+			var r = [];
+
+			ch.put(100);
+			ch.close();
+			assert.equal(ch.closed, true);
+
+			assert.throws(function() {
+				ch.put(200);
+			});
+			assert.equal(ch.tryPut(200), false);
+
+			assert.equal(ch.take(), 100);
+			assert.isNull(ch.take());
+
+			var ch1 = new coroutine.Channel(2);
+			coroutine.start(function() {
+				r.push(ch1.take());
+			});
+			coroutine.start(function() {
+				r.push(ch1.take());
+			});
+			coroutine.sleep(10);
+
+			ch1.close();
+			coroutine.sleep(10);
+			assert.deepEqual(r, [null, null]);
+		});
+	});
 });
 
 //test.run(console.DEBUG);
\ No newline at end of file
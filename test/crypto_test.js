@@ -201,6 +201,102 @@ describe('crypto', function() {
 		});
 	});
 
+	describe('Aead', function() {
+		var key = encoding.hexDecode('feffe9928665731c6d6a8f9467308308');
+		var iv = encoding.hexDecode('cafebabefacedbaddecaf888');
+		var text = encoding.hexDecode('d9313225f88406e5a55909c5aff5269a' +
+			'86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525' +
+			'b16aedf5aa0de657ba637b391aafd255');
+		var data = '42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e' +
+			'21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985' +
+			'4d5c2af327cd64a62cf35abd2ba6fab4';
+
+		it("encrypt/decrypt", function() {
+			var c = crypto.aead("aes-128-gcm", key);
+
+			assert.equal(c.name, "aes-128-gcm");
+			assert.equal(c.keySize, 128);
+			assert.equal(c.ivSize, 12);
+			assert.equal(c.tagSize, 16);
+
+			assert.equal(crypto.aead("aes-128-gcm", new Buffer(16)).encrypt(new Buffer(12),
+				new Buffer()).hex(), '58e2fccefa7e3061367f1d57a4e7455a');
+
+			assert.equal(c.encrypt(iv, text).hex(), data);
+			assert.equal(c.decrypt(iv, encoding.hexDecode(data)).hex(), text.hex());
+
+			var aad = new Buffer("header");
+			var d = c.encrypt(iv, text, aad);
+			assert.equal(c.decrypt(iv, d, aad).hex(), text.hex());
+			assert.throws(function() {
+				c.decrypt(iv, d);
+			});
+
+			d[0] = d[0] ^ 1;
+			assert.throws(function() {
+				c.decrypt(iv, d, aad);
+			});
+		});
+
+		it("large data", function() {
+			var c = crypto.aead("aes-256-gcm", crypto.randomBytes(32));
+			var b = crypto.randomBytes(1024 * 1024);
+
+			var d = c.encrypt(iv, b);
+			assert.equal(d.length, b.length + 16);
+			assert.equal(c.decrypt(iv, d).hex(), b.hex());
+		});
+
+		it("stream", function() {
+			var io = require('io');
+			var c = crypto.aead("aes-128-gcm", key);
+
+			var src = new io.MemoryStream();
+			var stm = new io.MemoryStream();
+			src.write(text);
+			src.rewind();
+			c.encryptTo(iv, src, stm);
+			stm.rewind();
+			assert.equal(stm.readAll().hex(), data);
+
+			var b = crypto.randomBytes(100001);
+			src = new io.MemoryStream();
+			stm = new io.MemoryStream();
+			src.write(b);
+			src.rewind();
+			c.encryptTo(iv, src, stm);
+			stm.rewind();
+
+			var d = stm.readAll();
+			assert.equal(d.hex(), c.encrypt(iv, b).hex());
+
+			src = new io.MemoryStream();
+			stm = new io.MemoryStream();
+			src.write(d);
+			src.rewind();
+			c.decryptTo(iv, src, stm);
+			stm.rewind();
+			assert.equal(stm.readAll().hex(), b.hex());
+
+			d[10] = d[10] ^ 1;
+			src = new io.MemoryStream();
+			src.write(d);
+			src.rewind();
+			assert.throws(function() {
+				c.decryptTo(iv, src, new io.MemoryStream());
+			});
+		});
+
+		it("invalid args", function() {
+			assert.throws(function() {
+				crypto.aead("aes-128-gcm", new Buffer(10));
+			});
+			assert.throws(function() {
+				crypto.aead("chacha20-poly1305", new Buffer(32));
+			});
+		});
+	});
+
 	describe("PKey", function() {
 		describe("RSA", function() {
 			it("PEM import/export", function() {
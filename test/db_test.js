@@ -120,6 +120,128 @@ describe("db", function() {
 		_test('sqlite:test.db');
 	});
 
+	it("stats", function() {
+		var conn = db.open('sqlite:test_stats.db');
+		var n = db.stats.sql;
+		var e = db.stats.error;
+
+		conn.execute('select 1');
+		assert.throws(function() {
+			conn.execute('select from');
+		});
+		conn.close();
+		fs.unlink("test_stats.db");
+
+		assert.equal(db.stats.sql, n + 2);
+		assert.equal(db.stats.error, e + 1);
+		assert.greaterThan(db.stats.histogram('sql').count, 0);
+	});
+
+	describe("pool", function() {
+		after(function() {
+			fs.unlink("test_pool.db");
+		});
+
+		it("acquire/release", function() {
+			var pool = db.openPool("sqlite:test_pool.db", {
+				max: 2
+			});
+
+			var c1 = pool.acquire();
+			var c2 = pool.acquire();
+			assert.equal(pool.size, 2);
+			assert.equal(pool.stats.inuse, 2);
+
+			pool.release(c1);
+			assert.equal(pool.idle, 1);
+			assert.equal(pool.stats.inuse, 1);
+
+			assert.strictEqual(pool.acquire(), c1);
+			assert.equal(pool.idle, 0);
+
+			pool.release(c1);
+			pool.release(c2);
+			assert.throws(function() {
+				pool.release(c2);
+			});
+
+			pool.release(pool.acquire(), false);
+			assert.equal(pool.size, 1);
+
+			pool.close();
+			assert.equal(pool.size, 0);
+			assert.throws(function() {
+				pool.acquire();
+			});
+		});
+
+		it("wait", function() {
+			var pool = db.openPool("sqlite:test_pool.db", {
+				max: 1
+			});
+
+			var c = pool.acquire();
+			coroutine.start(function() {
+				coroutine.sleep(10);
+				pool.release(c);
+			});
+
+			assert.strictEqual(pool.acquire(), c);
+			assert.equal(pool.stats.wait, 1);
+
+			pool.release(c);
+			pool.close();
+		});
+
+		it("maxWait", function() {
+			var pool = db.openPool("sqlite:test_pool.db", {
+				max: 1,
+				maxWait: 10
+			});
+
+			var c = pool.acquire();
+			assert.throws(function() {
+				pool.acquire();
+			});
+			assert.equal(pool.stats.timeout, 1);
+
+			pool.release(c);
+			pool.close();
+		});
+
+		it("execute", function() {
+			var pool = db.openPool("sqlite:test_pool.db");
+
+			assert.equal(pool.execute(function(conn) {
+				return conn.execute("select 100 as n;")[0].n;
+			}), 100);
+			assert.equal(pool.idle, 1);
+
+			assert.throws(function() {
+				pool.execute(function(conn) {
+					throw new Error("error");
+				});
+			});
+			assert.equal(pool.size, 0);
+			assert.equal(pool.stats.error, 1);
+
+			pool.close();
+		});
+
+		it("options", function() {
+			assert.throws(function() {
+				db.openPool("leveldb:testdb");
+			});
+
+			assert.throws(function() {
+				db.openPool("sqlite:test_pool.db", {
+					min: 10,
+					max: 5
+				});
+			});
+		});
+	});
+
 	xdescribe("mysql", function() {
 		_test('mysql://root@localhost/test');
 	});
@@ -2,6 +2,7 @@ var test = require("test");
 test.setup();
 
 var encoding = require('encoding');
+var io = require('io');
 
 describe('encoding', function() {
 	it('base64', function() {
@@ -97,6 +98,52 @@ describe('encoding', function() {
 		for (var i = 0; i < 256; i++) {
 			assert.equal(hexb2[i], hexb[i]);
 		}
+		assert.equal(hexb2.length, 256);
+		assert.equal(encoding.hexDecode('0102zz').length, 2);
+	});
+
+	it('large data', function() {
+		var b = new Buffer();
+		b.resize(65537);
+		for (var i = 0; i < 65537; i++)
+			b[i] = (i * 7) & 255;
+
+		var s = encoding.hexEncode(b);
+		assert.equal(s.length, 65537 * 2);
+		assert.equal(s.substr(0, 8), '00070e15');
+		assert.equal(encoding.hexDecode(s).hex(), s);
+
+		s = encoding.base64Encode(b);
+		assert.equal(s.length, 87384);
+		assert.equal(encoding.base64Decode(s).hex(), b.hex());
+	});
+
+	it('base64 stream', function() {
+		var b = new Buffer();
+		b.resize(100000);
+		for (var i = 0; i < 100000; i++)
+			b[i] = (i * 13) & 255;
+
+		var src = new io.MemoryStream();
+		var stm = new io.MemoryStream();
+
+		src.write(b);
+		src.rewind();
+		encoding.base64EncodeTo(src, stm);
+		stm.rewind();
+
+		var s = stm.readAll().toString();
+		assert.equal(s, encoding.base64Encode(b));
+
+		src = new io.MemoryStream();
+		stm = new io.MemoryStream();
+
+		src.write(new Buffer(s));
+		src.rewind();
+		encoding.base64DecodeTo(src, stm);
+		stm.rewind();
+
+		assert.equal(stm.readAll().hex(), b.hex());
 	});
 
 	it('uri', function() {
@@ -187,6 +187,44 @@ describe("hash", function() {
 		digest_case.forEach(hash_test);
 	});
 
+	it("digestMany", function() {
+		var datas = [];
+		var r, i;
+
+		for (i = 0; i < 1000; i++)
+			datas.push(new Buffer('data ' + i));
+
+		var b = new Buffer();
+		b.resize(1024 * 1024);
+		b.fill(7);
+		datas.push(b);
+
+		r = hash.digestMany(hash.SHA256, datas);
+		assert.equal(r.length, datas.length);
+		for (i = 0; i < datas.length; i++)
+			assert.equal(r[i].hex(), hash.sha256(datas[i]).digest().hex());
+
+		assert.deepEqual(hash.digestMany(hash.MD5, []), []);
+		assert.throws(function() {
+			hash.digestMany(100, datas);
+		});
+	});
+
+	it("copyTo digest", function() {
+		var io = require('io');
+		var b = new Buffer();
+		b.resize(100000);
+		b.fill(3);
+
+		var ms = new io.MemoryStream();
+		ms.write(b);
+		ms.rewind();
+
+		var d = hash.digest(hash.SHA1);
+		assert.equal(ms.copyTo(d), 100000);
+		assert.equal(d.digest().hex(), hash.sha1(b).digest().hex());
+	});
+
 	it("md5_hmac", function() {
 		var hmac_case = [{
 			name: 'MD5',
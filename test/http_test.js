@@ -8,6 +8,7 @@ var net = require('net');
 var encoding = require('encoding');
 var zlib = require('zlib');
 var coroutine = require("coroutine");
+var util = require("util");
 
 var ssl = require("ssl");
 var crypto = require("crypto");
@@ -553,6 +554,47 @@ describe("http", function() {
 			assert.equal(c['b'].contentTransferEncoding, 'base64');
 			assert.equal(c['b'].body.read().toString(), '200');
 		});
+
+		it("upload", function() {
+			var data = new Array(100001).join('0123456789');
+			var body = '--7d33a816d302b6\r\nContent-Disposition: form-data;name="a"\r\n\r\n100\r\n--7d33a816d302b6\r\nContent-Disposition: form-data;name="b";filename="test.txt"\r\nContent-Type: text/plain\r\n\r\n' + data + '\r\n--7d33a816d302b6--\r\n';
+			var txt = 'POST /test HTTP/1.0\r\nContent-type:multipart/form-data;boundary=7d33a816d302b6\r\nContent-length:' + body.length + '\r\n\r\n' + body;
+
+			function read_upload(r) {
+				var ms = new io.MemoryStream();
+				var bs = new io.BufferedStream(ms);
+				bs.EOL = "\r\n";
+
+				bs.writeText(txt);
+				ms.seek(0, fs.SEEK_SET);
+
+				r.readFrom(bs);
+				return r;
+			}
+
+			var r = get_request(txt);
+			assert.equal(r.length, body.length);
+			assert.equal(r.form['b'].body.readAll().toString(), data);
+
+			r = new http.Request();
+			assert.isFalse(r.streamUpload);
+			r.streamUpload = true;
+			read_upload(r);
+			assert.equal(r.length, 0);
+
+			var c = r.form;
+			assert.equal(c['a'], '100');
+			assert.equal(c['b'].fileName, 'test.txt');
+			assert.equal(c['b'].contentType, 'text/plain');
+			assert.equal(c['b'].body.readAll().toString(), data);
+
+			r = new http.Request();
+			r.streamUpload = true;
+			r.maxPartSize = 1000;
+			assert.throws(function() {
+				read_upload(r);
+			});
+		});
 		it("chunk", function() {
 			function chunk(data) {
 				return data.length.toString(16) + '\r\n' + data + '\r\n';
@@ -919,6 +961,328 @@ describe("http", function() {
 		});
 	});
 
+	describe("metrics handler", function() {
+		var mHandler = http.metricsHandler();
+
+		function mh_test(headers) {
+			var req = new http.Request();
+			req.value = '/metrics';
+			if (headers)
+				req.addHeader(headers);
+			mHandler.invoke(req);
+
+			var rep = req.response;
+			rep.body.rewind();
+			return rep;
+		}
+
+		it("prometheus text", function() {
+			var st = new util.Stats(["a", "b"]);
+			st.name = "metrics_test";
+			st.inc("a");
+
+			var rep = mh_test();
+			assert.equal(200, rep.status);
+			assert.equal('text/plain; version=0.0.4; charset=utf-8', rep.firstHeader('Content-Type'));
+
+			var txt = rep.body.readAll().toString();
+			assert.ok(/^fibjs_fibers \d+$/m.test(txt));
+			assert.ok(/^fibjs_async_threads \d+$/m.test(txt));
+			assert.ok(/^fibjs_v8_heap_used_bytes [1-9]\d*$/m.test(txt));
+			assert.ok(/^# TYPE fibjs_reactor_events_total counter$/m.test(txt));
+			assert.ok(/^fibjs_stats\{name="metrics_test",id="\d+",key="a"\} 1$/m.test(txt));
+			assert.ok(/^fibjs_stats\{name="metrics_test",id="\d+",key="b"\} 0$/m.test(txt));
+			assert.equal(txt.indexOf('# EOF'), -1);
+			rep.clear();
+		});
+
+		it("openmetrics", function() {
+			var rep = mh_test({
+				'Accept': 'application/openmetrics-text; version=1.0.0,text/plain;q=0.5'
+			});
+			assert.equal('application/openmetrics-text; version=1.0.0; charset=utf-8',
+				rep.firstHeader('Content-Type'));
+
+			var txt = rep.body.readAll().toString();
+			assert.ok(/^# TYPE fibjs_reactor_events counter$/m.test(txt));
+			assert.ok(/^fibjs_reactor_events_total \d+$/m.test(txt));
+			assert.equal(txt.substr(-6), '# EOF\n');
+			rep.clear();
+		});
+
+		it("histogram", function() {
+			var st = new util.Stats([], [], ["lat"]);
+			st.name = "metrics_hist";
+			st.record("lat", 10);
+			st.record("lat", 100);
+
+			var rep = mh_test();
+			var txt = rep.body.readAll().toString();
+			var prefix = 'fibjs_stats_histogram_bucket\\{name="metrics_hist",id="\\d+",key="lat",';
+
+			assert.ok(new RegExp('^' + prefix + 'le="31"\\} 1$', 'm').test(txt));
+			assert.ok(new RegExp('^' + prefix + 'le="127"\\} 2$', 'm').test(txt));
+			assert.ok(new RegExp('^' + prefix + 'le="\\+Inf"\\} 2$', 'm').test(txt));
+			assert.equal(new RegExp('^' + prefix + 'le="255"', 'm').test(txt), false);
+			assert.ok(/^fibjs_stats_histogram_count\{name="metrics_hist",id="\d+",key="lat"\} 2$/m.test(txt));
+			rep.clear();
+		});
+
+		it("gc", function() {
+			GC();
+
+			var rep = mh_test();
+			var txt = rep.body.readAll().toString();
+			assert.ok(/^fibjs_stats\{name="v8_gc",id="\d+",key="mark_sweep"\} [1-9]\d*$/m.test(txt));
+			assert.ok(/^fibjs_stats_histogram_count\{name="v8_gc",id="\d+",key="pause"\} [1-9]\d*$/m.test(txt));
+			rep.clear();
+		});
+	});
+
+	describe("cache handler", function() {
+		var calls = 0;
+		var cHandler = http.cacheHandler(function(r) {
+			calls++;
+			var s = r.address.substr(1);
+			if (s == "slow")
+				coroutine.sleep(100);
+			else if (s == "nostore")
+				r.response.setHeader("Cache-Control", "no-store");
+			else if (s == "maxage")
+				r.response.setHeader("Cache-Control", "max-age=0");
+			else if (s == "longage")
+				r.response.setHeader("Cache-Control", "max-age=99999999999");
+			else if (s == "cookie")
+				r.response.addCookie(new http.Cookie("a", "100"));
+			else if (s == "pub")
+				r.response.setHeader("Cache-Control", "public, max-age=100");
+			else if (s == "smaxage")
+				r.response.setHeader("Cache-Control", "s-maxage=100");
+			else if (s == "varylang")
+				r.response.setHeader("Vary", "Accept-Language");
+			else if (s == "varyfoo")
+				r.response.setHeader("Vary", "Accept-Language, X-Foo");
+			else if (s == "varyall")
+				r.response.setHeader("Vary", "*");
+			else if (s == "big")
+				s = new Array(1000).join("big text ");
+
+			r.response.setHeader("Content-Type", "text/html");
+			r.response.write(new Buffer(s + ":" + (r.firstHeader("Accept-Language") || "")));
+		}, {
+			maxSize: 65536,
+			vary: ["Accept-Language"]
+		});
+
+		function ch_test(url, headers, method) {
+			var req = new http.Request();
+			req.address = url;
+			req.value = url;
+			if (method)
+				req.method = method;
+			if (headers)
+				req.addHeader(headers);
+			cHandler.invoke(req);
+
+			var rep = req.response;
+			if (rep.body)
+				rep.body.rewind();
+			return rep;
+		}
+
+		beforeEach(function() {
+			cHandler.clear();
+			calls = 0;
+		});
+
+		it("hit", function() {
+			var rep = ch_test("/a");
+			assert.equal(rep.status, 200);
+			assert.equal(rep.body.readAll().toString(), "a:");
+			var etag = rep.firstHeader("ETag");
+			assert.notEqual(etag, null);
+
+			rep = ch_test("/a");
+			assert.equal(rep.status, 200);
+			assert.equal(rep.body.readAll().toString(), "a:");
+			assert.equal(rep.firstHeader("Content-Type"), "text/html");
+			assert.equal(rep.firstHeader("ETag"), etag);
+			assert.equal(calls, 1);
+
+			ch_test("/a?b=1");
+			assert.equal(calls, 2);
+
+			ch_test("/a", {}, "POST");
+			assert.equal(calls, 3);
+
+			assert.equal(cHandler.stats.hit, 1);
+			assert.equal(cHandler.stats.miss, 2);
+			assert.equal(cHandler.stats.entries, 2);
+		});
+
+		it("vary", function() {
+			var rep = ch_test("/v", {
+				"Accept-Language": "en"
+			});
+			assert.equal(rep.body.readAll().toString(), "v:en");
+
+			rep = ch_test("/v", {
+				"Accept-Language": "zh"
+			});
+			assert.equal(rep.body.readAll().toString(), "v:zh");
+
+			rep = ch_test("/v", {
+				"Accept-Language": "en"
+			});
+			assert.equal(rep.body.readAll().toString(), "v:en");
+			assert.equal(calls, 2);
+		});
+
+		it("not modified", function() {
+			var etag = ch_test("/e").firstHeader("ETag");
+
+			var rep = ch_test("/e", {
+				"If-None-Match": etag
+			});
+			assert.equal(rep.status, 304);
+			assert.equal(rep.length, 0);
+			assert.equal(cHandler.stats.not_modified, 1);
+			assert.equal(calls, 1);
+		});
+
+		it("cache-control", function() {
+			ch_test("/nostore");
+			ch_test("/nostore");
+			assert.equal(calls, 2);
+
+			ch_test("/maxage");
+			ch_test("/maxage");
+			assert.equal(calls, 4);
+
+			ch_test("/cookie");
+			ch_test("/cookie");
+			assert.equal(calls, 6);
+
+			ch_test("/n");
+			ch_test("/n", {
+				"Cache-Control": "no-cache"
+			});
+			assert.equal(calls, 8);
+
+			ch_test("/longage");
+			ch_test("/longage");
+			assert.equal(calls, 9);
+		});
+
+		it("authorization", function() {
+			var auth = {
+				"Authorization": "Basic dXNlcjpwYXNz"
+			};
+
+			ch_test("/auth", auth);
+			ch_test("/auth", auth);
+			assert.equal(calls, 2);
+			assert.equal(cHandler.stats.entries, 0);
+
+			ch_test("/pub", auth);
+			ch_test("/pub", auth);
+			assert.equal(calls, 3);
+
+			ch_test("/smaxage", auth);
+			ch_test("/smaxage", auth);
+			assert.equal(calls, 4);
+		});
+
+		it("response vary", function() {
+			ch_test("/varylang");
+			ch_test("/varylang");
+			assert.equal(calls, 1);
+
+			ch_test("/varyfoo", {
+				"X-Foo": "1"
+			});
+			ch_test("/varyfoo", {
+				"X-Foo": "2"
+			});
+			assert.equal(calls, 3);
+
+			ch_test("/varyall");
+			ch_test("/varyall");
+			assert.equal(calls, 5);
+			assert.equal(cHandler.stats.entries, 1);
+		});
+
+		it("host", function() {
+			var rep = ch_test("/h", {
+				"Host": "a.com"
+			});
+			assert.equal(rep.body.readAll().toString(), "h:");
+
+			ch_test("/h", {
+				"Host": "b.com"
+			});
+			assert.equal(calls, 2);
+
+			ch_test("/h", {
+				"Host": "A.com"
+			});
+			assert.equal(calls, 2);
+		});
+
+		it("head", function() {
+			ch_test("/hd", {}, "HEAD");
+			ch_test("/hd", {}, "HEAD");
+			assert.equal(calls, 2);
+			assert.equal(cHandler.stats.entries, 0);
+
+			ch_test("/hd");
+			var rep = ch_test("/hd", {}, "HEAD");
+			assert.equal(rep.status, 200);
+			assert.equal(calls, 3);
+		});
+
+		it("gzip", function() {
+			var rep = ch_test("/big");
+			var txt = rep.body.readAll().toString();
+
+			rep = ch_test("/big", {
+				"Accept-Encoding": "gzip"
+			});
+			assert.equal(rep.firstHeader("Content-Encoding"), "gzip");
+			assert.equal(rep.firstHeader("Vary"), "Accept-Encoding");
+			assert.equal(zlib.gunzip(rep.body.readAll()).toString(), txt);
+
+			rep = ch_test("/big");
+			assert.equal(rep.firstHeader("Content-Encoding"), null);
+			assert.equal(rep.firstHeader("Vary"), "Accept-Encoding");
+			assert.equal(rep.body.readAll().toString(), txt);
+			assert.equal(calls, 1);
+		});
+
+		it("coalesce", function() {
+			var reps = [];
+
+			coroutine.parallel([0, 1, 2, 3], function(i) {
+				reps[i] = ch_test("/slow");
+			});
+
+			assert.equal(calls, 1);
+			reps.forEach(function(rep) {
+				assert.equal(rep.body.readAll().toString(), "slow:");
+			});
+			assert.equal(cHandler.stats.coalesced, 3);
+		});
+
+		it("max size", function() {
+			for (var i = 0; i < 500; i++)
+				ch_test("/s" + i);
+
+			assert.ok(cHandler.stats.bytes <= 65536);
+			assert.ok(cHandler.stats.evicted > 0);
+			assert.equal(cHandler.stats.entries + cHandler.stats.evicted, 500);
+		});
+	});
+
 	describe("server/request", function() {
 		var svr;
 
@@ -1005,6 +1369,179 @@ describe("http", function() {
 				}).body.read().toString(), "/request:header");
 			});
 		});
+
+		describe("agent", function() {
+			it("properties", function() {
+				assert.equal(http.maxSockets, 32);
+				assert.equal(http.keepAliveTimeout, 4000);
+				assert.equal(http.maxRequestsPerSocket, 1000);
+
+				assert.throws(function() {
+					http.maxSockets = -1;
+				});
+				assert.throws(function() {
+					http.keepAliveTimeout = -1;
+				});
+				assert.throws(function() {
+					http.maxRequestsPerSocket = -1;
+				});
+			});
+
+			it("reuse", function() {
+				var st = http.agentStats;
+
+				http.get("http://127.0.0.1:8882/request");
+				var n = st.reuses;
+
+				assert.equal(http.get("http://127.0.0.1:8882/request").body.read().toString(),
+					"/request");
+				assert.equal(st.reuses, n + 1);
+				assert.greaterThan(st.idle, 0);
+			});
+
+			it("maxSockets", function() {
+				var st = http.agentStats;
+				var max = 0;
+
+				http.maxSockets = 1;
+				try {
+					var rs = coroutine.parallel([1, 2, 3, 4, 5], function(v) {
+						var r = http.get("http://127.0.0.1:8882/request" + v).body.read().toString();
+						if (st.active > max)
+							max = st.active;
+						return r;
+					});
+				} finally {
+					http.maxSockets = 32;
+				}
+
+				assert.deepEqual(rs, ["/request1", "/request2", "/request3", "/request4", "/request5"]);
+				assert.ok(max <= 1);
+				assert.equal(st.pending, 0);
+			});
+
+			it("keepAliveTimeout", function() {
+				var st = http.agentStats;
+
+				http.keepAliveTimeout = 0;
+				try {
+					var n = st.connects;
+					http.get("http://127.0.0.1:8882/request");
+					http.get("http://127.0.0.1:8882/request");
+					assert.equal(st.connects, n + 2);
+				} finally {
+					http.keepAliveTimeout = 4000;
+				}
+			});
+
+			it("expire idle", function() {
+				var st = http.agentStats;
+
+				http.get("http://127.0.0.1:8882/request");
+				assert.greaterThan(st.idle, 0);
+
+				http.keepAliveTimeout = 100;
+				try {
+					coroutine.sleep(300);
+					assert.equal(st.idle, 0);
+				} finally {
+					http.keepAliveTimeout = 4000;
+				}
+			});
+		});
+	});
+
+	describe("server timeout", function() {
+		var svr;
+
+		before(function() {
+			svr = new http.Server(8884, function(r) {
+				r.response.body.write(r.address);
+			});
+			svr.timeout = 300;
+			svr.idleTimeout = 50;
+			svr.asyncRun();
+		});
+
+		after(function() {
+			svr.socket.close();
+		});
+
+		it("properties", function() {
+			assert.equal(svr.timeout, 300);
+			assert.equal(svr.idleTimeout, 50);
+
+			assert.throws(function() {
+				svr.timeout = -1;
+			});
+		});
+
+		it("idle", function() {
+			var c = net.connect('127.0.0.1', 8884);
+			var bs = new io.BufferedStream(c);
+			bs.EOL = "\r\n";
+
+			c.write(new Buffer("GET /test HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n"));
+			assert.equal(bs.readLine(), "HTTP/1.1 200 OK");
+			while (bs.readLine() != "");
+			assert.equal(bs.read(5).toString(), "/test");
+
+			var t1 = new Date();
+			assert.isNull(bs.read(1));
+			assert.lessThan(new Date() - t1, 250);
+			c.close();
+		});
+
+		it("first request", function() {
+			var c = net.connect('127.0.0.1', 8884);
+
+			var t1 = new Date();
+			assert.isNull(c.recv());
+			assert.greaterThan(new Date() - t1, 250);
+			c.close();
+		});
+
+		it("slow request", function() {
+			var c = net.connect('127.0.0.1', 8884);
+			var closed = false;
+
+			c.write(new Buffer("GET /test HTTP/1.1\r\n"));
+			coroutine.start(function() {
+				try {
+					while (!closed) {
+						coroutine.sleep(100);
+						c.write(new Buffer("X-Slow: 1\r\n"));
+					}
+				} catch (e) {}
+			});
+
+			var t1 = new Date();
+			assert.isNull(c.recv());
+			closed = true;
+			assert.lessThan(new Date() - t1, 1000);
+			c.close();
+		});
+
+		it("slow body", function() {
+			var c = net.connect('127.0.0.1', 8884);
+			var closed = false;
+
+			c.write(new Buffer("POST /test HTTP/1.1\r\nContent-Length: 100\r\n\r\n"));
+			coroutine.start(function() {
+				try {
+					while (!closed) {
+						coroutine.sleep(100);
+						c.write(new Buffer("a"));
+					}
+				} catch (e) {}
+			});
+
+			var t1 = new Date();
+			assert.isNull(c.recv());
+			closed = true;
+			assert.lessThan(new Date() - t1, 1000);
+			c.close();
+		});
 	});
 
 	describe("https server/https request", function() {
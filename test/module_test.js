@@ -140,6 +140,115 @@ describe("module", function() {
 		});
 	});
 
+	describe("module cache", function() {
+		var vm = require('vm');
+
+		function load(id) {
+			return new vm.SandBox({}).require(__dirname + '/module/mod_test').require(id);
+		}
+
+		it("resolution", function() {
+			var st = vm.moduleCacheStats;
+
+			assert.equal(vm.moduleCache, true);
+			assert.deepEqual(load("mod4"), {
+				"a": 400
+			});
+
+			var p = st.probes;
+			var h = st.hits;
+
+			assert.deepEqual(load("mod4"), {
+				"a": 400
+			});
+			assert.greaterThan(st.hits, h);
+			assert.ok(st.probes - p <= 2);
+		});
+
+		it("missing", function() {
+			var st = vm.moduleCacheStats;
+
+			assert.throws(function() {
+				load("not_exists");
+			});
+
+			var p = st.probes;
+			assert.throws(function() {
+				load("not_exists");
+			});
+			assert.ok(st.probes - p <= 1);
+		});
+
+		it("clear", function() {
+			var fname = __dirname + '/.modules/mod_cache.js';
+
+			try {
+				fs.unlink(fname);
+			} catch (e) {}
+
+			assert.throws(function() {
+				load("mod_cache");
+			});
+
+			fs.writeFile(fname, 'exports.a = 600;');
+			try {
+				vm.clearModuleCache();
+				assert.equal(vm.moduleCacheStats.entries, 0);
+
+				assert.deepEqual(load("mod_cache"), {
+					"a": 600
+				});
+			} finally {
+				fs.unlink(fname);
+				vm.clearModuleCache();
+			}
+		});
+
+		it("missing expires", function() {
+			var fname = __dirname + '/.modules/mod_cache1.js';
+
+			try {
+				fs.unlink(fname);
+			} catch (e) {}
+
+			assert.throws(function() {
+				load("mod_cache1");
+			});
+
+			fs.writeFile(fname, 'exports.a = 700;');
+			try {
+				coroutine.sleep(1100);
+				assert.deepEqual(load("mod_cache1"), {
+					"a": 700
+				});
+			} finally {
+				fs.unlink(fname);
+				vm.clearModuleCache();
+			}
+		});
+
+		it("disable", function() {
+			var st = vm.moduleCacheStats;
+
+			vm.moduleCache = false;
+			try {
+				assert.equal(st.entries, 0);
+
+				var p = st.probes;
+				assert.throws(function() {
+					load("not_exists");
+				});
+				assert.throws(function() {
+					load("not_exists");
+				});
+				assert.equal(st.entries, 0);
+				assert.greaterThan(st.probes, p + 2);
+			} finally {
+				vm.moduleCache = true;
+			}
+		});
+	});
+
 	it("strack", function() {
 		assert.ok(require("module/stack").func().match(/module_test/));
 	});
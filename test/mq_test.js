@@ -4,6 +4,7 @@ test.setup();
 var mq = require('mq');
 var net = require('net');
 var io = require('io');
+var http = require('http');
 var coroutine = require('coroutine');
 
 var m = new mq.Message();
@@ -327,6 +328,122 @@ describe("mq", function() {
 		});
 	});
 
+	describe("limit handler", function() {
+		function lm_test(hdlr, key) {
+			var req = new http.Request();
+			if (key)
+				req.addHeader("X-Key", key);
+			hdlr.invoke(req);
+			return req.response;
+		}
+
+		it("rate", function() {
+			var calls = 0;
+			var hdlr = new mq.LimitHandler(function(r) {
+				calls++;
+			}, {
+				rate: 1,
+				burst: 2,
+				keyHeader: "X-Key"
+			});
+
+			assert.equal(lm_test(hdlr, "a").status, 200);
+			assert.equal(lm_test(hdlr, "a").status, 200);
+
+			var rep = lm_test(hdlr, "a");
+			assert.equal(rep.status, 429);
+			assert.equal(rep.firstHeader("Retry-After"), "1");
+
+			assert.equal(lm_test(hdlr, "b").status, 200);
+			assert.equal(calls, 3);
+
+			coroutine.sleep(1100);
+			assert.equal(lm_test(hdlr, "a").status, 200);
+
+			assert.equal(hdlr.stats.accepted, 4);
+			assert.equal(hdlr.stats.rate_limited, 1);
+		});
+
+		it("concurrency", function() {
+			var hdlr = new mq.LimitHandler(function(r) {
+				coroutine.sleep(100);
+			}, {
+				concurrency: 1,
+				queueSize: 1,
+				queueTimeout: 1000
+			});
+
+			var st = [];
+
+			function fn(i) {
+				st[i] = lm_test(hdlr).status;
+			}
+
+			coroutine.start(fn, 0);
+			coroutine.start(fn, 1);
+			coroutine.sleep(10);
+			assert.equal(hdlr.stats.active, 1);
+			assert.equal(hdlr.stats.queued, 1);
+
+			fn(2);
+			assert.equal(st[2], 503);
+
+			coroutine.sleep(300);
+			assert.deepEqual(st, [200, 200, 503]);
+			assert.equal(hdlr.stats.active, 0);
+			assert.equal(hdlr.stats.queued, 0);
+			assert.equal(hdlr.stats.accepted, 2);
+			assert.equal(hdlr.stats.rejected, 1);
+		});
+
+		it("queue timeout", function() {
+			var hdlr = new mq.LimitHandler(function(r) {
+				coroutine.sleep(200);
+			}, {
+				concurrency: 1,
+				queueSize: 10,
+				queueTimeout: 50
+			});
+
+			var st;
+
+			coroutine.start(function() {
+				st = lm_test(hdlr).status;
+			});
+			coroutine.sleep(10);
+
+			assert.equal(lm_test(hdlr).status, 503);
+			assert.equal(hdlr.stats.timeout, 1);
+			assert.equal(hdlr.stats.queued, 0);
+
+			coroutine.sleep(300);
+			assert.equal(st, 200);
+			assert.equal(hdlr.stats.active, 0);
+		});
+
+		it("server limit", function() {
+			var svr = new net.TcpServer(8891, function(c) {});
+			ss.push(svr.socket);
+
+			var h = svr.handler;
+			var l = svr.limit({
+				concurrency: 100
+			});
+			assert.equal(svr.handler, l);
+			assert.equal(l.handler, h);
+
+			var svr1 = new http.Server(8892, function(r) {});
+			ss.push(svr1.socket);
+
+			h = svr1.handler;
+			l = svr1.limit({
+				rate: 100
+			});
+			assert.equal(svr1.handler, l);
+			assert.equal(l.handler, h);
+		});
+	});
+
 	it("await", function() {
 		var n = 100;
 
@@ -196,6 +196,47 @@ describe("net", function() {
 		assert.equal('d', c1.read(3));
 	});
 
+	it("timeout", function() {
+		function accept3(s) {
+			while (true) {
+				var c = s.accept();
+
+				coroutine.sleep(200);
+				c.write('a');
+				coroutine.sleep(100);
+				c.close();
+			}
+		}
+
+		var s3 = new net.Socket(net_config.family, net.SOCK_STREAM);
+		ss.push(s3);
+
+		s3.bind(8085);
+		s3.listen();
+		coroutine.start(accept3, s3);
+
+		var c1 = new net.Socket();
+		c1.connect('127.0.0.1', 8085);
+		assert.equal(c1.timeout, 0);
+
+		c1.timeout = 50;
+		assert.equal(c1.timeout, 50);
+
+		var t1 = new Date();
+		assert.throws(function() {
+			c1.recv();
+		});
+		assert.greaterThan(new Date() - t1, 40);
+		assert.lessThan(new Date() - t1, 190);
+
+		c1.timeout = 0;
+		assert.equal('a', c1.recv());
+
+		assert.throws(function() {
+			c1.timeout = -1;
+		});
+	});
+
 	it("re-entrant", function() {
 		function accept2(s) {
 			while (true) {
@@ -327,6 +368,112 @@ describe("net", function() {
 		}, svr.stats.toJSON());
 	});
 
+	describe("dns cache", function() {
+		afterEach(function() {
+			net.dnsCacheTTL = 60000;
+			net.dnsNegativeTTL = 5000;
+			net.clearDnsCache();
+		});
+
+		it("properties", function() {
+			assert.equal(net.dnsCacheTTL, 60000);
+			assert.equal(net.dnsNegativeTTL, 5000);
+
+			assert.throws(function() {
+				net.dnsCacheTTL = -1;
+			});
+			assert.throws(function() {
+				net.dnsNegativeTTL = -1;
+			});
+		});
+
+		it("hit", function() {
+			var st = net.dnsStats;
+
+			net.clearDnsCache();
+			var n = st.misses;
+			var h = st.hits;
+
+			var ip = net.resolve("localhost");
+			assert.equal(st.misses, n + 1);
+
+			assert.equal(net.resolve("localhost"), ip);
+			assert.equal(net.ip("localhost"), ip);
+			assert.equal(st.misses, n + 1);
+			assert.equal(st.hits, h + 2);
+			assert.greaterThan(st.entries, 0);
+
+			net.clearDnsCache();
+			assert.equal(st.entries, 0);
+
+			net.resolve("localhost");
+			assert.equal(st.misses, n + 2);
+		});
+
+		it("negative", function() {
+			var st = net.dnsStats;
+			var n = st.misses;
+			var f = st.failures;
+
+			assert.throws(function() {
+				net.resolve("not-exists.invalid");
+			});
+			assert.throws(function() {
+				net.resolve("not-exists.invalid");
+			});
+
+			assert.equal(st.misses, n + 1);
+			assert.equal(st.failures, f + 1);
+		});
+
+		it("disabled", function() {
+			var st = net.dnsStats;
+			var n = st.misses;
+
+			net.dnsCacheTTL = 0;
+			net.resolve("localhost");
+			net.resolve("localhost");
+
+			assert.equal(st.misses, n + 2);
+			assert.equal(st.entries, 0);
+		});
+
+		it("coalesce", function() {
+			var st = net.dnsStats;
+			var n = st.misses;
+
+			var rs = coroutine.parallel([1, 2, 3, 4, 5], function(v) {
+				return net.resolve("localhost");
+			});
+
+			assert.deepEqual(rs, [rs[0], rs[0], rs[0], rs[0], rs[0]]);
+			assert.equal(st.misses, n + 1);
+			assert.equal(st.inflight, 0);
+		});
+
+		it("connect", function() {
+			var svr = new net.TcpServer(8813, function(c) {
+				c.write(c.read(5));
+			});
+
+			ss.push(svr.socket);
+			svr.asyncRun();
+
+			var st = net.dnsStats;
+			var h = st.hits;
+
+			net.resolve("localhost");
+
+			var c1 = new net.Socket();
+			c1.connect("localhost", 8813);
+			c1.write("hello");
+			assert.equal(c1.read(5).toString(), "hello");
+			c1.close();
+
+			assert.equal(st.hits, h + 1);
+		});
+	});
+
 	describe("abort Pending I/O", function() {
 		function close_it(s) {
 			coroutine.sleep(50);
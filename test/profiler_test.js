@@ -15,6 +15,7 @@ describe("profiler", function() {
 	after(function() {
 		unlink("test.heapsnapshot");
 		unlink("test1.heapsnapshot");
+		unlink("test.cpuprofile");
 	});
 
 	it("take snapshot & dispose", function() {
@@ -61,6 +62,22 @@ describe("profiler", function() {
 		ss.dispose();
 	});
 
+	it("getNodeById", function() {
+		var ss = profiler.loadSnapshot("test.heapsnapshot");
+		var nodes = ss.nodes;
+		var n = nodes[nodes.length >> 1];
+
+		assert.equal(ss.getNodeById(n.id).id, n.id);
+		assert.equal(ss.root.id, nodes[0].id);
+		assert.isNull(ss.getNodeById(-1));
+
+		var ss1 = profiler.takeSnapshot();
+		n = ss1.nodes[ss1.nodes.length >> 1];
+		assert.equal(ss1.getNodeById(n.id).id, n.id);
+		assert.isNull(ss1.getNodeById(-1));
+		ss1.dispose();
+	});
+
 	it("diff", function() {
 		var ss = profiler.loadSnapshot("test.heapsnapshot");
 		var ss1 = profiler.loadSnapshot("test.heapsnapshot");
@@ -73,6 +90,53 @@ describe("profiler", function() {
 			"details": []
 		});
 	});
+
+	it("cpu profile", function() {
+		var coroutine = require("coroutine");
+		var io = require("io");
+
+		function busy() {
+			var t = new Date();
+			var n = 0;
+			while (new Date() - t < 50)
+				n += Math.sqrt(n + 1);
+			return n;
+		}
+
+		assert.throws(function() {
+			profiler.stopCPUProfile("test.cpuprofile");
+		});
+
+		profiler.startCPUProfile(100);
+		assert.throws(function() {
+			profiler.startCPUProfile();
+		});
+
+		coroutine.parallel([busy, busy]);
+
+		assert.throws(function() {
+			profiler.stopCPUProfile("test.cpuprofile", "unknown");
+		});
+
+		profiler.stopCPUProfile("test.cpuprofile");
+
+		var prof = JSON.parse(fs.readFile("test.cpuprofile"));
+		assert.equal(prof.nodes[0].callFrame.functionName, "(root)");
+		assert.equal(prof.samples.length, prof.timeDeltas.length);
+		assert.greaterThan(prof.samples.length, 0);
+
+		profiler.startCPUProfile(100);
+		busy();
+
+		var ms = new io.MemoryStream();
+		profiler.stopCPUProfile(ms, "collapsed");
+		ms.rewind();
+
+		var lines = ms.readAll().toString().split("\n");
+		assert.ok(lines.some(function(l) {
+			return /^Fiber [0-9]+.*;.*busy.* [0-9]+$/.test(l);
+		}));
+	});
 });
 
 //test.run(console.DEBUG);
\ No newline at end of file
@@ -37,6 +37,7 @@ function del(f) {
 
 describe('ssl', function() {
 	var sss;
+	var svr_resumed = 0;
 
 	var ss = [];
 
@@ -61,6 +62,9 @@ describe('ssl', function() {
 				return;
 			}
 
+			if (ss.resumed)
+				svr_resumed++;
+
 			try {
 				while (buf = ss.read())
 					ss.write(buf);
@@ -151,6 +155,36 @@ describe('ssl', function() {
 		ss.close();
 	});
 
+	it("session resume", function() {
+		svr_resumed = 0;
+
+		for (var i = 0; i < 10; i++) {
+			var ss = ssl.connect('ssl://localhost:9080');
+
+			ss.write("GET / HTTP/1.0");
+			assert.equal("GET / HTTP/1.0", ss.read());
+
+			if (i > 0)
+				assert.isTrue(ss.resumed);
+
+			ss.close();
+		}
+
+		assert.equal(svr_resumed, 9);
+	});
+
+	it("ticket_lifetime", function() {
+		assert.equal(ssl.ticket_lifetime, 86400);
+
+		assert.throws(function() {
+			ssl.ticket_lifetime = -1;
+		});
+
+		ssl.ticket_lifetime = 0;
+		assert.equal(ssl.ticket_lifetime, 0);
+		ssl.ticket_lifetime = 86400;
+	});
+
 	it("copyTo", function() {
 		var str = "012345678901234567890123456789";
 
@@ -159,10 +193,19 @@ describe('ssl', function() {
 
 		var sss = new ssl.Socket(crt, pk);
 		sss.verification = ssl.VERIFY_NONE;
+		var acc_err = 0;
 
 		var svr = new net.TcpServer(9082, function(s) {
 			var ss = sss.accept(s);
 
+			// the accepted socket shares the listener's config
+			try {
+				ss.verification = ssl.VERIFY_OPTIONAL;
+			} catch (e) {
+				acc_err++;
+			}
+			ss.ca;
+
 			fs.writeFile('net_temp_000001', str);
 			var f = fs.open('net_temp_000001');
 			assert.equal(f.copyTo(ss), str.length);
@@ -195,6 +238,7 @@ describe('ssl', function() {
 			str = str + str;
 			t_conn();
 		}
+		assert.equal(acc_err, 10);
 
 		del('net_temp_000001');
 		del('net_temp_000002');
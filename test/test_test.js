@@ -1,4 +1,5 @@
 var test = require("test");
+var coroutine = require("coroutine");
 test.setup();
 
 describe("test", function() {
@@ -31,6 +32,67 @@ describe("test", function() {
 			afterEach(function() {});
 		});
 	});
+
+	it("bench", function() {
+		var n = 0;
+		var r = test.bench("inc", function() {
+			n++;
+		}, {
+			warmup: 10,
+			time: 50
+		});
+
+		assert.equal(r.name, "inc");
+		assert.greaterThan(r.ops, 0);
+		assert.greaterThan(r.samples, 0);
+		assert.ok(n >= r.count);
+		assert.ok(r.samples <= r.count);
+		assert.closeTo(r.ops * r.mean, 1000000000, 1000);
+		assert.ok(r.min <= r.p50);
+		assert.ok(r.p50 <= r.p99);
+		assert.ok(r.p99 <= r.max);
+
+		var k = 0;
+		var r2 = test.bench("mixed", function() {
+			if (++k % 10 == 0)
+				coroutine.sleep(2);
+		}, {
+			warmup: 0,
+			time: 100
+		});
+		assert.lessThan(r2.p50, 100000);
+		assert.greaterThan(r2.p99, 1000000);
+		assert.ok(r2.samples <= r2.count);
+		assert.closeTo(r2.count / r2.ops, 0.1, 0.05);
+
+		var r1 = test.bench("inc", function() {
+			n++;
+		}, {
+			warmup: 10,
+			time: 50,
+			baseline: {
+				inc: r
+			},
+			threshold: 100
+		});
+		assert.property(r1, "change");
+
+		assert.throws(function() {
+			test.bench("slow", function() {
+				coroutine.sleep(1);
+			}, {
+				warmup: 0,
+				time: 20,
+				baseline: r
+			});
+		});
+
+		assert.throws(function() {
+			test.bench("error", function() {
+				throw new Error("error");
+			});
+		});
+	});
 });
 
 //test.run(console.DEBUG);
\ No newline at end of file
@@ -793,6 +793,45 @@ describe('util', function() {
 			coroutine.sleep(100);
 			assert.closeTo(100, s.uptime(), 40);
 		});
+
+		it("histogram", function() {
+			var h = new util.Stats([], ['a'], ['latency']);
+
+			assert.throws(function() {
+				h.record('a', 1);
+			});
+
+			assert.deepEqual(h.histogram('latency'), {
+				"count": 0,
+				"min": 0,
+				"max": 0,
+				"mean": 0,
+				"p50": 0,
+				"p90": 0,
+				"p99": 0,
+				"p999": 0
+			});
+
+			for (var i = 1; i <= 1000; i++)
+				h.record('latency', i);
+
+			var r = h.histogram('latency');
+			assert.equal(r.count, 1000);
+			assert.equal(r.min, 1);
+			assert.closeTo(r.max, 1000, 1000 * 0.04);
+			assert.closeTo(r.mean, 500, 500 * 0.04);
+			assert.closeTo(r.p50, 500, 500 * 0.04);
+			assert.closeTo(r.p90, 900, 900 * 0.04);
+			assert.closeTo(r.p99, 990, 990 * 0.04);
+			assert.closeTo(h.percentile('latency', 99.9), 999, 999 * 0.04);
+
+			assert.throws(function() {
+				h.percentile('latency', 101);
+			});
+
+			h.reset();
+			assert.equal(h.histogram('latency').count, 0);
+		});
 	});
 
 	describe('LruCache', function() {
@@ -151,6 +151,62 @@ describe("vm", function() {
 		t1.func();
 	});
 
+	it("code cache", function() {
+		var fs = require('fs');
+		var coroutine = require('coroutine');
+		var dir = __dirname + '/vm_test/code_cache';
+		var fname = __dirname + '/vm_test/cache_test.js';
+		var st = vm.codeCacheStats;
+
+		function clean() {
+			try {
+				fs.readdir(dir).forEach(function(f) {
+					if (f.name != '.' && f.name != '..')
+						fs.unlink(dir + '/' + f.name);
+				});
+				fs.rmdir(dir);
+			} catch (e) {}
+			try {
+				fs.unlink(fname);
+			} catch (e) {}
+		}
+
+		function load() {
+			return new vm.SandBox({}).require(fname).v;
+		}
+
+		clean();
+		fs.writeFile(fname, "exports.v = 100;");
+
+		var m = st.misses;
+		var h = st.hits;
+		var w = st.writes;
+
+		assert.equal(vm.codeCacheDir, "");
+		assert.equal(load(), 100);
+		assert.equal(st.misses, m);
+
+		vm.codeCacheDir = dir;
+		try {
+			assert.equal(load(), 100);
+			assert.equal(st.misses, m + 1);
+			assert.equal(st.writes, w + 1);
+
+			assert.equal(load(), 100);
+			assert.equal(st.hits, h + 1);
+
+			coroutine.sleep(1000);
+			fs.writeFile(fname, "exports.v = 200;");
+
+			assert.equal(load(), 200);
+			assert.equal(st.misses, m + 2);
+			assert.equal(st.writes, w + 2);
+		} finally {
+			vm.codeCacheDir = "";
+			clean();
+		}
+	});
+
 	it("Garbage Collection", function() {
 		sbox = undefined;
 		GC();
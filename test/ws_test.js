@@ -306,6 +306,190 @@ describe('websocket', function() {
 		});
 	});
 
+	it("compress", function() {
+		var hdlr = new websocket.Handler(function(v) {
+			v.response.body = v.body;
+		});
+		assert.equal(hdlr.compress, false);
+		hdlr.compress = true;
+
+		var httpd = new http.Server(8812, hdlr);
+		ss.push(httpd.socket);
+		httpd.asyncRun();
+
+		var rep = http.get("http://127.0.0.1:8812/", {
+			"Upgrade": "websocket",
+			"Connection": "Upgrade",
+			"Sec-WebSocket-Key": "dGhlIHNhbXBsZSBub25jZQ==",
+			"Sec-WebSocket-Version": "13",
+			"Sec-WebSocket-Extensions": "x-webkit-deflate-frame, permessage-deflate; client_max_window_bits"
+		});
+
+		assert.equal(rep.status, 101);
+		assert.equal(rep.firstHeader("Sec-WebSocket-Extensions"), "permessage-deflate");
+
+		function test_msg(s, n) {
+			var msg = new websocket.Message();
+			msg.type = websocket.TEXT;
+			msg.masked = true;
+
+			var buf = new Buffer(n);
+			for (var i = 0; i < n; i++) {
+				buf[i] = (i % 10) + 0x30;
+			}
+
+			msg.body.write(buf);
+			msg.sendTo(s);
+
+			var msg = new websocket.Message();
+			msg.readFrom(s);
+
+			assert.equal(msg.body.readAll().toString(), buf.toString());
+		}
+
+		var s = websocket.connect("ws://127.0.0.1:8812/", true);
+
+		for (var i = 0; i < 3; i++) {
+			test_msg(s, 10);
+			test_msg(s, 125);
+			test_msg(s, 65536);
+			test_msg(s, 1024 * 1024);
+		}
+
+		var s = websocket.connect("ws://127.0.0.1:8810/", true);
+		test_msg(s, 100);
+
+		assert.throws(function() {
+			load_msg([0xc1, 0x07, 0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00]);
+		});
+
+		var rep = http.get("http://127.0.0.1:8812/", {
+			"Upgrade": "websocket",
+			"Connection": "Upgrade",
+			"Sec-WebSocket-Key": "dGhlIHNhbXBsZSBub25jZQ==",
+			"Sec-WebSocket-Version": "13",
+			"Sec-WebSocket-Extensions": "permessage-deflate"
+		});
+		assert.equal(rep.status, 101);
+
+		// a ping with RSV1 set is refused even on a compressed connection
+		rep.stream.write(new Buffer([0xc9, 0x80, 0x00, 0x00, 0x00, 0x00]));
+		assert.isNull(rep.stream.read(1));
+	});
+
+	it("hub", function() {
+		var hub = new websocket.Hub();
+		assert.equal(hub.maxPending, 4194304);
+		assert.throws(function() {
+			hub.maxPending = -1;
+		});
+
+		assert.throws(function() {
+			hub.add(new io.MemoryStream());
+		});
+
+		var svs = [];
+		var hdlr = new websocket.Handler(function(v) {
+			svs.push(v.stream);
+			hub.add(v.stream);
+		});
+		hdlr.compress = true;
+
+		var httpd = new http.Server(8813, hdlr);
+		ss.push(httpd.socket);
+		httpd.asyncRun();
+
+		function join(compress) {
+			var s = websocket.connect("ws://127.0.0.1:8813/", compress);
+
+			var msg = new websocket.Message();
+			msg.type = websocket.TEXT;
+			msg.body.write("join");
+			msg.sendTo(s);
+
+			var msg = new websocket.Message();
+			msg.readFrom(s);
+
+			return s;
+		}
+
+		function recv(s) {
+			var msg = new websocket.Message();
+			msg.readFrom(s);
+			return {
+				type: msg.type,
+				data: msg.body.readAll().toString()
+			};
+		}
+
+		var cs = [];
+		for (var i = 0; i < 10; i++)
+			cs.push(join(i % 2 == 0));
+
+		assert.equal(hub.size, 10);
+		assert.equal(hub.stats.members, 10);
+
+		assert.throws(function() {
+			hub.add(cs[0]);
+		});
+		assert.equal(hub.size, 10);
+
+		assert.equal(hub.send("hello"), 10);
+		assert.equal(hub.send(new Buffer("world")), 10);
+
+		hub.compress = true;
+		assert.equal(hub.send("hello, compressed"), 10);
+
+		cs.forEach(function(s) {
+			assert.deepEqual(recv(s), {
+				type: websocket.TEXT,
+				data: "hello"
+			});
+			assert.deepEqual(recv(s), {
+				type: websocket.BINARY,
+				data: "world"
+			});
+			assert.deepEqual(recv(s), {
+				type: websocket.TEXT,
+				data: "hello, compressed"
+			});
+		});
+
+		var rep = http.get("http://127.0.0.1:8813/", {
+			"Upgrade": "websocket",
+			"Connection": "Upgrade",
+			"Sec-WebSocket-Key": "dGhlIHNhbXBsZSBub25jZQ==",
+			"Sec-WebSocket-Version": "13",
+			"Sec-WebSocket-Extensions": "permessage-deflate; server_no_context_takeover"
+		});
+		assert.equal(rep.firstHeader("Sec-WebSocket-Extensions"),
+			"permessage-deflate; server_no_context_takeover");
+
+		var msg = new websocket.Message();
+		msg.type = websocket.TEXT;
+		msg.masked = true;
+		msg.sendTo(rep.stream);
+		msg.readFrom(rep.stream);
+
+		assert.equal(hub.size, 11);
+		hub.send("hello, shared");
+		assert.equal(rep.stream.read(1)[0], 0xc1);
+
+		hub.remove(cs[0]);
+		assert.equal(hub.size, 11);
+
+		hub.remove(svs[0]);
+		assert.equal(hub.size, 10);
+
+		hub.close();
+		assert.equal(hub.size, 0);
+		assert.equal(hub.stats.evict, 10);
+
+		assert.throws(function() {
+			recv(cs[1]);
+		});
+	});
+
 	it("remote close", function() {
 		var httpd = new http.Server(8811, new websocket.Handler(function(v) {
 			v.stream.close();